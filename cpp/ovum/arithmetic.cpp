@@ -1,18 +1,23 @@
 #include "ovum/ovum.h"
 
+#include <charconv>
+
 namespace {
-  struct FloatParts {
-    constexpr static size_t MANTISSA_CHARS = 32;
+  using namespace egg::ovum;
+
+  struct FloatDigits {
+    constexpr static size_t MAXIMUM_SIGFIGS = 31;
 
     const char* special;
     bool negative;
     int exponent; // radix 10
-    char mantissa[MANTISSA_CHARS]; // may not be NUL-terminated
+    size_t count;
+    char digits[MAXIMUM_SIGFIGS]; // not NUL-terminated
 
-    FloatParts(double value, size_t sigfigs)
-    : special(nullptr), negative(std::signbit(value)), exponent(0), mantissa() {
-      assert(sigfigs > 0);
-      assert(sigfigs <= MANTISSA_CHARS);
+    FloatDigits(double value, size_t sigfigs)
+    : special(nullptr), negative(std::signbit(value)), exponent(0), count(0), digits() {
+      // Such that the absolute value is "0.DDDD" * 10^exponent to 'sigfigs' significant figures
+      assert(sigfigs <= MAXIMUM_SIGFIGS);
       switch (std::fpclassify(value)) {
       case FP_INFINITE:
         // Positive or negative infinity
@@ -25,155 +30,131 @@ namespace {
         this->special = "0.0";
         return;
       }
-      this->special = nullptr;
-      auto m = FloatParts::getMantissaExponent10(std::abs(value), this->exponent);
-      for (size_t i = 0; i < sigfigs; ++i) {
-        assert((m >= 0.0) && (m < 1.0));
-        double n;
-        m = std::modf(m * 10.0, &n);
-        this->mantissa[i] = char(n) + '0';
-      }
+      this->generate(std::abs(value), sigfigs);
+      assert((this->digits[0] >= '1') && (this->digits[0] <= '9'));
     }
-    size_t round(size_t sigfigs) {
-      // Returns the number of non-zero fraction digits
-      assert(sigfigs > 1);
-      assert(sigfigs < MANTISSA_CHARS);
-      bool prune = false;
-      switch (this->mantissa[sigfigs]) {
-      case '0':
-        // Round down (truncate) and scan backwards for last non-zero
-        while ((sigfigs > 0) && (this->mantissa[sigfigs - 1] == '0')) {
-          sigfigs--;
+    void generate(double magnitude, size_t sigfigs) {
+      // Let the standard library round correctly to 'sigfigs' digits in the form "D.DDDDe+XX"
+      assert((sigfigs > 0) && (sigfigs <= MAXIMUM_SIGFIGS));
+      char buffer[Arithmetic::FORMAT_CHARS];
+      auto result = std::to_chars(std::begin(buffer), std::end(buffer), magnitude, std::chars_format::scientific, int(sigfigs - 1));
+      assert(result.ec == std::errc());
+      auto* p = std::begin(buffer);
+      this->digits[this->count++] = *p++;
+      if (*p == '.') {
+        while (*++p != 'e') {
+          assert(this->count < MAXIMUM_SIGFIGS);
+          this->digits[this->count++] = *p;
         }
-        return sigfigs;
-      case '1':
-      case '2':
-      case '3':
-      case '4':
-        // Round down (truncate) but leave trailing zeroes
-        return sigfigs;
-      case '9':
-        // Round up and remove trailing zeroes
-        prune = true;
-        break;
       }
-      auto i = sigfigs;
-      for (;;) {
-        // Round up and carry forward
-        if (i == 0) {
-          // We've rounded up "99...99" to "00...00" so renormalize
-          this->mantissa[0] = '1';
-          this->exponent++;
-          return prune ? 1 : sigfigs;
-        }
-        if (this->mantissa[i - 1] != '9') {
-          // No need to carry forward
-          this->mantissa[i - 1]++;
-          return prune ? i : sigfigs;
-        }
-        i--;
-        this->mantissa[i] = '0';
+      assert(*p == 'e');
+      auto sign = *++p;
+      int e = 0;
+      (void)std::from_chars(p + 1, result.ptr, e);
+      this->exponent = ((sign == '-') ? -e : e) + 1;
+      while ((this->count > 1) && (this->digits[this->count - 1] == '0')) {
+        // Remove trailing zeroes
+        this->count--;
       }
     }
-    void writeMantissa(std::ostream& os, size_t begin, size_t end) {
-      assert(begin < end);
-      assert(end <= MANTISSA_CHARS);
-      os.write(this->mantissa + begin, std::streamsize(end - begin));
+  };
+
+  class FloatWriter {
+    FloatWriter(const FloatWriter&) = delete;
+    FloatWriter& operator=(const FloatWriter&) = delete;
+  private:
+    char* buffer;
+    char* p;
+  public:
+    explicit FloatWriter(char* buffer)
+      : buffer(buffer), p(buffer) {
+    }
+    size_t written() const {
+      assert(size_t(this->p - this->buffer) <= Arithmetic::FORMAT_CHARS);
+      return size_t(this->p - this->buffer);
+    }
+    void put(char ch) {
+      *this->p++ = ch;
     }
-    void writeZeroes(std::ostream& os, size_t count) {
-      std::fill_n(std::ostreambuf_iterator<char>(os), count, '0');
+    void write(const char* text, size_t length) {
+      std::memcpy(this->p, text, length);
+      this->p += length;
     }
-    void writeScientific(std::ostream& os, size_t sigfigs) {
+    void writeZeroes(size_t count) {
+      std::memset(this->p, '0', count);
+      this->p += count;
+    }
+    void writeScientific(const FloatDigits& parts) {
       // Write out in the following format "M.MMMe+EEE"
-      assert((sigfigs > 0) && (sigfigs <= MANTISSA_CHARS));
-      os.put(this->mantissa[0]);
-      os.put('.');
-      if (sigfigs < 2) {
-        os.put('0');
+      this->put(parts.digits[0]);
+      this->put('.');
+      if (parts.count < 2) {
+        this->put('0');
       } else {
-        this->writeMantissa(os, 1, sigfigs);
+        this->write(parts.digits + 1, parts.count - 1);
       }
-      int e = this->exponent - 1;
+      int e = parts.exponent - 1;
       if (e < 0) {
-        os.write("e-", 2);
+        this->write("e-", 2);
         e = -e;
       } else {
-        os.write("e+", 2);
+        this->write("e+", 2);
       }
       assert((e >= 0) && (e <= 999));
-      os.put(char(e / 100) + '0');
-      os.put(char((e / 10) % 10) + '0');
-      os.put(char(e % 10) + '0');
+      this->put(char(e / 100) + '0');
+      this->put(char((e / 10) % 10) + '0');
+      this->put(char(e % 10) + '0');
     }
-    static double getMantissaExponent10(double v, int& e) {
-      // Computes a decimal mantissa and exponent such that
-      //  0.1 <= m < 1.0
-      // v == m * 10 ^ e
-      assert(std::isfinite(v));
-      assert(v > 0);
-      e = 0;
-      if (!std::isnormal(v)) {
-        // Handle denormals simplistically by making them normal
-        v *= 1.0e100;
-        e = -100;
+    void writeFloat(double value, size_t sigfigs, size_t max_before, size_t max_after) {
+      FloatDigits parts(value, sigfigs);
+      if (parts.special != nullptr) {
+        this->write(parts.special, std::strlen(parts.special));
+        return;
       }
-      auto d = std::floor(std::log10(v)) + 1.0;
-      e += int(d);
-      auto m = v * std::pow(10.0, -d);
-      if (m < 0.1) {
-        // Handle edge-case rounding errors
-        m = 0.1;
+      if (parts.negative) {
+        this->put('-');
       }
-      assert((m >= 0.1) && (m < 1.0));
-      return m;
-    }
-  };
-
-  void writeFloat(std::ostream& os, double value, size_t sigfigs, size_t max_before, size_t max_after) {
-    assert(sigfigs > 0);
-    FloatParts parts(value, sigfigs + 1);
-    if (parts.special != nullptr) {
-      os << parts.special;
-      return;
-    }
-    if (parts.negative) {
-      os.put('-');
-    }
-    assert((parts.mantissa[0] >= '1') && (parts.mantissa[0] <= '9'));
-    assert((parts.exponent > -333) && (parts.exponent < +333));
-    if (sigfigs > 1) {
-      sigfigs = parts.round(sigfigs);
-    }
-    assert((sigfigs > 0) && (sigfigs <= FloatParts::MANTISSA_CHARS));
-    if (parts.exponent > 0) {
-      // There are digits in front of the decimal point
-      auto before = size_t(parts.exponent);
-      if (before > max_before) {
-        parts.writeScientific(os, sigfigs);
-      } else if (before >= sigfigs) {
-        // We've got something like "mmmmm0.0" or "mmmmm.0"
-        parts.writeMantissa(os, 0, sigfigs);
-        parts.writeZeroes(os, before - sigfigs);
-        os.write(".0", 2);
-      } else {
-        // We've got something like "mmm.mm"
-        parts.writeMantissa(os, 0, before);
-        os.put('.');
-        parts.writeMantissa(os, before, sigfigs);
-      }
-    } else {
-      // There is nothing before the decimal point
-      // We've got something like "0.00mmmmm" or "0.mmmmm"
-      auto zeroes = size_t(-parts.exponent);
-      auto after = zeroes + sigfigs;
-      if (after > max_after) {
-        parts.writeScientific(os, sigfigs);
+      assert((parts.exponent > -333) && (parts.exponent < +333));
+      auto count = parts.count;
+      if (parts.exponent > 0) {
+        // There are digits in front of the decimal point
+        auto before = size_t(parts.exponent);
+        if (before > max_before) {
+          this->writeScientific(parts);
+        } else if (before >= count) {
+          // We've got something like "mmmmm0.0" or "mmmmm.0"
+          this->write(parts.digits, count);
+          this->writeZeroes(before - count);
+          this->write(".0", 2);
+        } else {
+          // We've got something like "mmm.mm"
+          this->write(parts.digits, before);
+          this->put('.');
+          this->write(parts.digits + before, count - before);
+        }
       } else {
-        os.write("0.", 2);
-        parts.writeZeroes(os, zeroes);
-        parts.writeMantissa(os, 0, sigfigs);
+        // There is nothing before the decimal point
+        // We've got something like "0.00mmmmm" or "0.mmmmm"
+        auto zeroes = size_t(-parts.exponent);
+        auto after = zeroes + count;
+        if (after > max_after) {
+          this->writeScientific(parts);
+        } else {
+          this->write("0.", 2);
+          this->writeZeroes(zeroes);
+          this->write(parts.digits, count);
+        }
       }
     }
+  };
+
+  template<typename T>
+  void printInteger(std::ostream& stream, T value) {
+    // Avoid the locale-aware iostreams machinery
+    char buffer[24];
+    auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+    assert(result.ec == std::errc());
+    stream.write(buffer, result.ptr - buffer);
   }
 }
 
@@ -235,6 +216,39 @@ egg::ovum::Float egg::ovum::MantissaExponent::toFloat() const {
 }
 
 void egg::ovum::Arithmetic::print(std::ostream& stream, double value, size_t sigfigs) {
-  assert(sigfigs > 0);
-  writeFloat(stream, value, sigfigs, sigfigs + 3, sigfigs + 3);
+  char buffer[FORMAT_CHARS];
+  stream.write(buffer, std::streamsize(Arithmetic::format(buffer, value, sigfigs)));
+}
+
+void egg::ovum::Arithmetic::print(std::ostream& stream, int64_t value) {
+  printInteger(stream, value);
+}
+
+void egg::ovum::Arithmetic::print(std::ostream& stream, uint64_t value) {
+  printInteger(stream, value);
+}
+
+size_t egg::ovum::Arithmetic::format(char* buffer, double value, size_t sigfigs) {
+  // Switch to scientific notation when there would be more than three padding zeroes
+  auto width = sigfigs + 3;
+  FloatWriter writer{ buffer };
+  writer.writeFloat(value, sigfigs, width, width);
+  return writer.written();
+}
+
+bool egg::ovum::Arithmetic::parse(double& value, const char* begin, const char* end) {
+  // Correctly rounded, unlike some 'strtod()' implementations, and independent of the locale
+  if (begin == end) {
+    return false;
+  }
+  auto result = std::from_chars(begin, end, value, std::chars_format::general);
+  return (result.ec == std::errc()) && (result.ptr == end);
+}
+
+bool egg::ovum::Arithmetic::parse(uint64_t& value, const char* begin, const char* end, int base) {
+  if (begin == end) {
+    return false;
+  }
+  auto result = std::from_chars(begin, end, value, base);
+  return (result.ec == std::errc()) && (result.ptr == end);
 }
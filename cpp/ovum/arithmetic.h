@@ -2,6 +2,7 @@ namespace egg::ovum {
   class Arithmetic {
   public:
     static const size_t DEFAULT_SIGFIGS = 12;
+    static const size_t FORMAT_CHARS = 64; // Buffer size required by 'format()'
 
     enum class Compare {
       LessThan,
@@ -21,6 +22,15 @@ namespace egg::ovum {
     };
 
     static void print(std::ostream& stream, double value, size_t sigfigs = DEFAULT_SIGFIGS);
+    static void print(std::ostream& stream, int64_t value);
+    static void print(std::ostream& stream, uint64_t value);
+
+    // Formatting returns the number of characters written (no NUL terminator)
+    static size_t format(char* buffer, double value, size_t sigfigs = DEFAULT_SIGFIGS);
+
+    // Parsing requires the whole range to be consumed without overflow
+    static bool parse(double& value, const char* begin, const char* end);
+    static bool parse(uint64_t& value, const char* begin, const char* end, int base = 10);
 
     static bool equal(double a, int64_t b) {
       return std::isfinite(a) && (int64_t(a) == b) && (a == double(b));
@@ -1,48 +1,175 @@
 #include "ovum/ovum.h"
 
-#include <set>
-#include <stack>
+#include <chrono>
+#include <optional>
 
 namespace {
   using namespace egg::ovum;
 
+  class BasketList {
+    BasketList(const BasketList&) = delete;
+    BasketList& operator=(const BasketList&) = delete;
+  public:
+    const ICollectable* head = nullptr;
+    const ICollectable* tail = nullptr;
+    size_t count = 0;
+    BasketList() = default;
+    static ICollectable::Link& link(const ICollectable& collectable) {
+      auto* link = collectable.softGetLink();
+      assert(link != nullptr);
+      return *link;
+    }
+    bool contains(const ICollectable& collectable) const {
+      // Only valid for collectables that are known to be in one of our lists
+      auto& entry = BasketList::link(collectable);
+      return (entry.prev != nullptr) || (this->head == &collectable);
+    }
+    void append(const ICollectable& collectable) {
+      auto& entry = BasketList::link(collectable);
+      assert((entry.prev == nullptr) && (entry.next == nullptr));
+      entry.prev = this->tail;
+      entry.next = nullptr;
+      if (this->tail == nullptr) {
+        this->head = &collectable;
+      } else {
+        BasketList::link(*this->tail).next = &collectable;
+      }
+      this->tail = &collectable;
+      this->count++;
+    }
+    void remove(const ICollectable& collectable) {
+      auto& entry = BasketList::link(collectable);
+      if (entry.prev == nullptr) {
+        assert(this->head == &collectable);
+        this->head = entry.next;
+      } else {
+        BasketList::link(*entry.prev).next = entry.next;
+      }
+      if (entry.next == nullptr) {
+        assert(this->tail == &collectable);
+        this->tail = entry.prev;
+      } else {
+        BasketList::link(*entry.next).prev = entry.prev;
+      }
+      entry.prev = nullptr;
+      entry.next = nullptr;
+      assert(this->count > 0);
+      this->count--;
+    }
+    void swap(BasketList& other) {
+      std::swap(this->head, other.head);
+      std::swap(this->tail, other.tail);
+      std::swap(this->count, other.count);
+    }
+    void splice(BasketList& other) {
+      // Move the entirety of the other list onto the end of this one
+      if (other.head != nullptr) {
+        if (this->tail == nullptr) {
+          this->head = other.head;
+        } else {
+          BasketList::link(*this->tail).next = other.head;
+          BasketList::link(*other.head).prev = this->tail;
+        }
+        this->tail = other.tail;
+        this->count += other.count;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.count = 0;
+      }
+    }
+  };
+
   class BasketCollector : public ICollectable::IVisitor {
     BasketCollector(const BasketCollector&) = delete;
     BasketCollector& operator=(const BasketCollector&) = delete;
   public:
-    BasketCollector(IBasket& basket, const std::set<const ICollectable*>& owned)
+    using Clock = std::chrono::steady_clock;
+    BasketCollector(IBasket& basket, bool young)
       : basket(basket),
-        owned(owned) {
+        cursor(nullptr),
+        young(young) {
     }
     IBasket& basket;
-    const std::set<const ICollectable*>& owned;
-    std::stack<const ICollectable*> pending;
-    std::set<const ICollectable*> unreachable;
-    void collect() {
+    BasketList owned; // Whatever is left in here after scanning is complete is unreachable
+    BasketList reachable; // Collectables from 'cursor' onwards have yet to be scanned
+    const ICollectable* cursor;
+    bool young; // Only trace young collectables, treating old ones as reachable
+    void roots() {
       // TODO thread safety
-      for (const auto* collectable : this->owned) {
+      // Move the roots into the reachable list and clear the marks of everything else
+      auto* collectable = this->owned.head;
+      while (collectable != nullptr) {
         assert(collectable->softGetBasket() == &basket);
-        if (collectable->softIsRoot()) {
-          // Construct a list of roots to start the search from
-          this->pending.push(collectable);
-        } else {
-          // Assume all non-roots are unreachable
-          this->unreachable.insert(collectable);
+        auto& entry = BasketList::link(*collectable);
+        auto* next = entry.next;
+        entry.marked = collectable->softIsRoot();
+        if (entry.marked) {
+          this->owned.remove(*collectable);
+          this->append(*collectable);
         }
+        collectable = next;
       }
-      while (!this->pending.empty()) {
-        auto* collectable = pending.top();
-        this->pending.pop();
-        assert(this->unreachable.count(collectable) == 0);
+    }
+    bool scan(Clock::time_point deadline) {
+      // Scan the reachable list, which grows as we visit newly-reached collectables
+      size_t scanned = 0;
+      while (this->cursor != nullptr) {
+        auto* collectable = this->cursor;
+        this->cursor = BasketList::link(*collectable).next;
         collectable->softVisit(*this);
+        if ((++scanned % 64 == 0) && (Clock::now() >= deadline)) {
+          break;
+        }
+      }
+      return this->cursor == nullptr;
+    }
+    void admit(const ICollectable& collectable) {
+      // Collectables taken during incremental marking are deemed reachable
+      BasketList::link(collectable).marked = true;
+      this->append(collectable);
+    }
+    void grey(const ICollectable& collectable) {
+      // Make sure a reachable collectable whose soft references have changed is (re)scanned
+      assert(BasketList::link(collectable).marked);
+      if (&collectable != this->cursor) {
+        this->reachable.remove(collectable);
+        this->append(collectable);
+      }
+    }
+    void forget(const ICollectable& collectable) {
+      // Remove a collectable from whichever of our lists it is on
+      if (BasketList::link(collectable).marked) {
+        if (&collectable == this->cursor) {
+          this->cursor = BasketList::link(collectable).next;
+        }
+        this->reachable.remove(collectable);
+      } else {
+        this->owned.remove(collectable);
       }
     }
     virtual void visit(const ICollectable& target) override {
-      assert(target.softGetBasket() == &this->basket);
-      assert(this->owned.find(&target) != this->owned.end());
-      if (this->unreachable.erase(&target) > 0) {
+      if (target.softGetBasket() != &this->basket) {
+        // Collectables outside any basket (e.g. forged types) are never reclaimed by us
+        assert(target.softGetBasket() == nullptr);
+        return;
+      }
+      auto& entry = BasketList::link(target);
+      if (this->young && entry.old) {
+        // Old collectables are only reclaimed by full collections
+        return;
+      }
+      if (!entry.marked) {
         // It's a node that has just been deemed reachable
-        this->pending.push(&target);
+        entry.marked = true;
+        this->owned.remove(target);
+        this->append(target);
+      }
+    }
+  private:
+    void append(const ICollectable& collectable) {
+      this->reachable.append(collectable);
+      if (this->cursor == nullptr) {
+        this->cursor = &collectable;
       }
     }
   };
@@ -51,14 +178,31 @@ namespace {
     BasketDefault(const BasketDefault&) = delete;
     BasketDefault& operator=(const BasketDefault&) = delete;
   private:
-    std::set<const ICollectable*> owned; // TODO unordered_set?
+    using Clock = BasketCollector::Clock;
+    BasketList young; // Taken since the last collection
+    BasketList old; // Survived at least one collection
+    BasketList remembered; // Old, but written to since the last collection
+    BasketList condemned; // Found to be unreachable by incremental marking but not yet released
+    std::optional<BasketCollector> marking; // Incremental full collection in progress, if any
+    Policy policy;
+    uint64_t thresholdBytes; // Allocator total at which the next collection is due
+    uint64_t thresholdBlocks; // Owned count at which the next collection is due
+    uint64_t youngSinceFull; // Automatic young collections since the last full one
+    uint64_t cycleBlocks; // Reclaimed so far by the incremental collection in progress
+    uint64_t cycleBytes;
+    Statistics collections; // Only the collection fields are maintained
   public:
     explicit BasketDefault(IAllocator& allocator)
-      : HardReferenceCountedAllocator<IBasket>(allocator) {
+      : HardReferenceCountedAllocator<IBasket>(allocator),
+        youngSinceFull(0),
+        cycleBlocks(0),
+        cycleBytes(0),
+        collections{} {
+      this->setPolicy(Policy{});
     }
     virtual ~BasketDefault() {
       // Make sure we no longer own any collectables
-      assert(this->owned.empty());
+      assert(this->owned() == 0);
     }
     virtual ICollectable* take(const ICollectable& collectable) override {
       // Add to our list of owned collectables
@@ -81,51 +225,284 @@ namespace {
       auto* acquired = static_cast<ICollectable*>(collectable.hardAcquire());
       assert(acquired != nullptr);
       assert(acquired->softGetBasket() == this);
-      if (!this->owned.insert(acquired).second) {
+      if (this->generation(*acquired).contains(*acquired)) {
         // We were already known about, but shouldn't have been!
         throw InternalException("Soft pointer basket ownership violation (take)");
       }
+      if (this->marking) {
+        this->marking->admit(*acquired);
+      } else {
+        this->young.append(*acquired);
+      }
       return acquired;
     }
     virtual void drop(const ICollectable& collectable) override {
       // Remove from our list of owned collectables
       assert(collectable.softGetBasket() == this);
-      if (this->owned.erase(&collectable) == 0) {
+      auto& list = this->generation(collectable);
+      if (!list.contains(collectable)) {
         throw InternalException("Soft pointer basket ownership violation (drop)");
       }
-      if (collectable.softSetBasket(nullptr) != ICollectable::SetBasketResult::Altered) {
-        throw InternalException("Soft pointer basket transfer violation (drop)");
+      if (this->marking) {
+        this->marking->forget(collectable);
+      } else {
+        list.remove(collectable);
+      }
+      this->release(collectable);
+    }
+    virtual void remember(const ICollectable& owner) override {
+      // Write barrier: the owner may have just acquired soft references to young or unmarked collectables
+      auto* entry = owner.softGetLink();
+      if ((entry == nullptr) || (owner.softGetBasket() != this)) {
+        return;
+      }
+      if (this->marking) {
+        if (entry->marked) {
+          this->marking->grey(owner);
+        }
+      } else if (entry->old && !entry->remembered) {
+        this->old.remove(owner);
+        entry->remembered = true;
+        this->remembered.append(owner);
       }
-      collectable.hardRelease();
     }
     virtual size_t collect() override {
       // TODO thread safety
-      BasketCollector collector(*this, this->owned);
-      collector.collect();
-      for (auto collectable : collector.unreachable) {
-        this->drop(*collectable);
+      // Full collection of all generations
+      auto reclaimed = this->finish();
+      auto started = Clock::now();
+      BasketCollector collector(*this, false);
+      collector.owned.splice(this->young);
+      collector.owned.splice(this->remembered);
+      collector.owned.splice(this->old);
+      collector.roots();
+      (void)collector.scan(Clock::time_point::max());
+      reclaimed += this->sweep(collector);
+      this->youngSinceFull = 0;
+      this->paused(started);
+      return reclaimed;
+    }
+    virtual size_t collectYoung() override {
+      // TODO thread safety
+      // Only reclaim collectables taken since the last collection
+      auto reclaimed = this->finish();
+      auto started = Clock::now();
+      BasketCollector collector(*this, true);
+      collector.owned.splice(this->young);
+      collector.roots();
+      // Old collectables that have been written to since the last collection may be the only referrers of young ones
+      for (auto* collectable = this->remembered.head; collectable != nullptr; collectable = BasketList::link(*collectable).next) {
+        collectable->softVisit(collector);
+      }
+      (void)collector.scan(Clock::time_point::max());
+      reclaimed += this->sweep(collector);
+      this->collections.totalYoungCollections++;
+      this->paused(started);
+      return reclaimed;
+    }
+    virtual size_t poll() override {
+      if (this->marking || (this->condemned.head != nullptr)) {
+        // Continue the incremental collection already in progress
+        return this->slice();
+      }
+      // Only collect if one of our policy thresholds has been crossed
+      auto due = (this->policy.blocksOwned > 0) && (this->owned() >= this->thresholdBlocks);
+      if (!due && (this->policy.bytesAllocated > 0)) {
+        IAllocator::Statistics stats;
+        due = this->allocator.statistics(stats) && (stats.totalBytesAllocated >= this->thresholdBytes);
+      }
+      if (!due) {
+        return 0;
+      }
+      if (this->youngSinceFull < this->policy.youngCollections) {
+        this->youngSinceFull++;
+        return this->collectYoung();
       }
-      return collector.unreachable.size();
+      if (this->policy.pauseBudget == 0) {
+        return this->collect();
+      }
+      // Start an incremental full collection
+      this->youngSinceFull = 0;
+      this->cycleBlocks = 0;
+      this->cycleBytes = 0;
+      this->marking.emplace(*this, false);
+      this->marking->owned.splice(this->young);
+      this->marking->owned.splice(this->remembered);
+      this->marking->owned.splice(this->old);
+      this->marking->roots();
+      return this->slice();
     }
     virtual size_t purge() override {
+      (void)this->finish();
       size_t purged = 0;
-      for (auto front = this->owned.begin(); front != this->owned.end(); front = this->owned.begin()) {
-        this->drop(**front);
-        purged++;
+      for (auto* list : { &this->young, &this->remembered, &this->old }) {
+        while (list->head != nullptr) {
+          this->drop(*list->head);
+          purged++;
+        }
       }
       return purged;
     }
+    virtual Policy getPolicy() const override {
+      return this->policy;
+    }
+    virtual void setPolicy(const Policy& value) override {
+      this->policy = value;
+      this->rearm();
+    }
     virtual bool statistics(Statistics& out) const override {
+      out = this->collections;
       (void)this->allocator.statistics(out);
-      out.currentBlocksOwned = this->owned.size();
+      out.currentBlocksOwned = this->owned();
+      out.currentBlocksYoung = this->young.count;
       return true;
     }
     virtual void print(Printer& printer) const override {
-      for (const auto* collectable : this->owned) {
-        printer.stream << "    [" << collectable << "] " << typeid(*collectable).name() << " ";
-        collectable->print(printer);
-        printer.stream << std::endl;
+      auto output = [&printer](const BasketList& list) {
+        for (auto* collectable = list.head; collectable != nullptr; collectable = BasketList::link(*collectable).next) {
+          printer.stream << "    [" << collectable << "] " << typeid(*collectable).name() << " ";
+          collectable->print(printer);
+          printer.stream << std::endl;
+        }
+      };
+      if (this->marking) {
+        output(this->marking->reachable);
+        output(this->marking->owned);
+      }
+      output(this->young);
+      output(this->remembered);
+      output(this->old);
+      output(this->condemned);
+    }
+  private:
+    size_t owned() const {
+      auto count = this->young.count + this->remembered.count + this->old.count + this->condemned.count;
+      if (this->marking) {
+        count += this->marking->reachable.count + this->marking->owned.count;
       }
+      return count;
+    }
+    BasketList& generation(const ICollectable& collectable) {
+      auto& entry = BasketList::link(collectable);
+      if (this->marking) {
+        return entry.marked ? this->marking->reachable : this->marking->owned;
+      }
+      if (entry.remembered) {
+        return this->remembered;
+      }
+      return entry.old ? this->old : this->young;
+    }
+    size_t slice() {
+      // Perform one bounded slice of the incremental collection in progress
+      auto started = Clock::now();
+      auto deadline = started + std::chrono::microseconds(this->policy.pauseBudget);
+      auto reclaimed = this->advance(deadline);
+      this->paused(started);
+      return reclaimed;
+    }
+    size_t finish() {
+      // Complete any incremental collection in progress regardless of the pause budget
+      if (this->marking || (this->condemned.head != nullptr)) {
+        auto started = Clock::now();
+        auto reclaimed = this->advance(Clock::time_point::max());
+        this->paused(started);
+        return reclaimed;
+      }
+      return 0;
+    }
+    size_t advance(Clock::time_point deadline) {
+      if (this->marking && this->marking->scan(deadline)) {
+        // Collectables that became roots during marking were not necessarily seen, so look again
+        this->marking->roots();
+        (void)this->marking->scan(Clock::time_point::max());
+        this->condemned.splice(this->marking->owned);
+        this->promote(this->marking->reachable);
+        this->marking.reset();
+      }
+      if (this->marking) {
+        return 0;
+      }
+      auto before = this->bytesDeallocated();
+      auto reclaimed = this->reclaim(this->condemned, deadline);
+      this->cycleBlocks += reclaimed;
+      this->cycleBytes += this->bytesDeallocated() - before;
+      if (this->condemned.head == nullptr) {
+        this->completed(this->cycleBlocks, this->cycleBytes);
+      }
+      return reclaimed;
+    }
+    size_t sweep(BasketCollector& collector) {
+      // Anything left in the collector's owned list is unreachable
+      auto before = this->bytesDeallocated();
+      auto reclaimed = this->reclaim(collector.owned, Clock::time_point::max());
+      // Promote the survivors and forget the remembered set as nothing young remains
+      this->promote(collector.reachable);
+      this->promote(this->remembered);
+      this->completed(reclaimed, this->bytesDeallocated() - before);
+      return reclaimed;
+    }
+    size_t reclaim(BasketList& unreachable, Clock::time_point deadline) {
+      size_t reclaimed = 0;
+      while (unreachable.head != nullptr) {
+        auto* collectable = unreachable.head;
+        unreachable.remove(*collectable);
+        this->release(*collectable);
+        if ((++reclaimed % 64 == 0) && (Clock::now() >= deadline)) {
+          break;
+        }
+      }
+      return reclaimed;
+    }
+    void promote(BasketList& survivors) {
+      for (auto* collectable = survivors.head; collectable != nullptr; collectable = BasketList::link(*collectable).next) {
+        auto& entry = BasketList::link(*collectable);
+        entry.old = true;
+        entry.remembered = false;
+      }
+      this->old.splice(survivors);
+    }
+    void completed(uint64_t blocks, uint64_t bytes) {
+      this->collections.totalCollections++;
+      this->collections.lastBlocksReclaimed = blocks;
+      this->collections.totalBlocksReclaimed += blocks;
+      this->collections.lastBytesReclaimed = bytes;
+      this->collections.totalBytesReclaimed += bytes;
+      this->rearm();
+    }
+    void paused(Clock::time_point started) {
+      auto paused = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started).count());
+      this->collections.totalPauses++;
+      this->collections.lastMicrosecondsPaused = paused;
+      this->collections.totalMicrosecondsPaused += paused;
+      this->collections.maximumMicrosecondsPaused = std::max(this->collections.maximumMicrosecondsPaused, paused);
+    }
+    void release(const ICollectable& collectable) {
+      auto& entry = BasketList::link(collectable);
+      entry.marked = false;
+      entry.old = false;
+      entry.remembered = false;
+      if (collectable.softSetBasket(nullptr) != ICollectable::SetBasketResult::Altered) {
+        throw InternalException("Soft pointer basket transfer violation (drop)");
+      }
+      collectable.hardRelease();
+    }
+    uint64_t bytesDeallocated() const {
+      IAllocator::Statistics stats;
+      if (this->allocator.statistics(stats)) {
+        return stats.totalBytesAllocated - stats.currentBytesAllocated;
+      }
+      return 0;
+    }
+    void rearm() {
+      // Compute the thresholds for the next automatic collection
+      IAllocator::Statistics stats;
+      if (this->allocator.statistics(stats)) {
+        this->thresholdBytes = stats.totalBytesAllocated + this->policy.bytesAllocated;
+      } else {
+        this->thresholdBytes = UINT64_MAX;
+      }
+      uint64_t survivors = this->owned();
+      this->thresholdBlocks = std::max(this->policy.blocksOwned, survivors + survivors * this->policy.blocksGrowth / 100);
     }
   };
 }
@@ -160,3 +537,235 @@ bool egg::ovum::IBasket::verify(std::ostream& os, size_t minimum, size_t maximum
 egg::ovum::HardPtr<IBasket> egg::ovum::BasketFactory::createBasket(egg::ovum::IAllocator& allocator) {
   return allocator.makeHard<BasketDefault>();
 }
+
+egg::ovum::AllocatorPool::AllocatorPool()
+  : reservation(os::memory::reserve(AllocatorPool::ArenaBytes + AllocatorPool::PageBytes)),
+    arena(nullptr),
+    span(0),
+    fresh(nullptr),
+    committed(0),
+    allocatedBlocks(0),
+    allocatedBytes(0),
+    deallocatedBlocks(0),
+    deallocatedBytes(0)
+#if !EGG_SINGLE_THREADED
+  , owner(std::this_thread::get_id()),
+    remote(nullptr),
+    remoteAllocatedBlocks(0),
+    remoteAllocatedBytes(0),
+    remoteDeallocatedBlocks(0),
+    remoteDeallocatedBytes(0)
+#endif
+{
+  if (this->reservation != nullptr) {
+    // Round up so that every page in the arena is aligned to its size
+    auto base = (reinterpret_cast<uintptr_t>(this->reservation) + AllocatorPool::PageBytes - 1) & ~uintptr_t(AllocatorPool::PageBytes - 1);
+    this->arena = reinterpret_cast<uint8_t*>(base);
+    this->span = AllocatorPool::ArenaBytes;
+    this->fresh = this->arena;
+  }
+}
+
+egg::ovum::AllocatorPool::~AllocatorPool() {
+  if (this->reservation != nullptr) {
+    os::memory::release(this->reservation, AllocatorPool::ArenaBytes + AllocatorPool::PageBytes);
+  }
+}
+
+void* egg::ovum::AllocatorPool::allocate(size_t bytes, size_t alignment) {
+  if ((bytes > AllocatorPool::MaximumPooled) || (alignment > AllocatorPool::Granularity) || !this->owned()) {
+    // Large, over-aligned and foreign allocations bypass the pool
+    return this->allocateDefault(bytes, alignment);
+  }
+  auto index = (std::max(bytes, size_t(1)) - 1) / AllocatorPool::Granularity;
+  auto size = (index + 1) * AllocatorPool::Granularity;
+  auto& sizeclass = this->classes[index];
+  auto* page = sizeclass.current;
+  if ((page == nullptr) || ((page->free == nullptr) && (page->bump + size > reinterpret_cast<uint8_t*>(page) + AllocatorPool::PageBytes))) {
+    page = this->refill(sizeclass, size);
+    if (page == nullptr) {
+      // The arena is exhausted
+      return this->allocateDefault(bytes, alignment);
+    }
+  }
+  this->allocatedBlocks++;
+  this->allocatedBytes += size;
+  page->live++;
+  auto* block = page->free;
+  if (block != nullptr) {
+    page->free = block->next;
+    return block;
+  }
+  auto* allocated = page->bump;
+  page->bump += size;
+  return allocated;
+}
+
+void egg::ovum::AllocatorPool::deallocate(void* allocated, size_t alignment) {
+  assert(allocated != nullptr);
+  if (!this->contains(allocated)) {
+    this->deallocateDefault(allocated, alignment);
+    return;
+  }
+  // Pooled blocks lie within a page aligned to its size, so masking finds the header
+  auto* page = reinterpret_cast<Page*>(reinterpret_cast<uintptr_t>(allocated) & ~uintptr_t(AllocatorPool::PageBytes - 1));
+  auto* block = static_cast<Block*>(allocated);
+#if !EGG_SINGLE_THREADED
+  if (!this->owned()) {
+    // Only the owner may touch the page, so queue the block for it to reclaim
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    block->next = this->remote;
+    this->remote = block;
+    this->remoteDeallocatedBlocks++;
+    this->remoteDeallocatedBytes += page->size;
+    return;
+  }
+#endif
+  this->deallocatedBlocks++;
+  this->deallocatedBytes += page->size;
+  this->reclaim(*page, *block);
+}
+
+bool egg::ovum::AllocatorPool::statistics(Statistics& out) const {
+  out.totalBlocksAllocated = this->allocatedBlocks;
+  out.totalBytesAllocated = this->allocatedBytes;
+  auto blocks = this->deallocatedBlocks;
+  auto bytes = this->deallocatedBytes;
+#if !EGG_SINGLE_THREADED
+  std::lock_guard<std::mutex> lock{ this->mutex };
+  out.totalBlocksAllocated += this->remoteAllocatedBlocks;
+  out.totalBytesAllocated += this->remoteAllocatedBytes;
+  blocks += this->remoteDeallocatedBlocks;
+  bytes += this->remoteDeallocatedBytes;
+#endif
+  out.currentBlocksAllocated = out.totalBlocksAllocated - blocks;
+  out.currentBytesAllocated = out.totalBytesAllocated - bytes;
+  return true;
+}
+
+void* egg::ovum::AllocatorPool::allocateDefault(size_t bytes, size_t alignment) {
+  auto* allocated = AllocatorDefaultPolicy::memalloc(bytes, alignment);
+  assert(allocated != nullptr);
+  auto size = AllocatorDefaultPolicy::memsize(allocated, alignment);
+#if !EGG_SINGLE_THREADED
+  if (!this->owned()) {
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    this->remoteAllocatedBlocks++;
+    this->remoteAllocatedBytes += size;
+    return allocated;
+  }
+#endif
+  this->allocatedBlocks++;
+  this->allocatedBytes += size;
+  return allocated;
+}
+
+void egg::ovum::AllocatorPool::deallocateDefault(void* allocated, size_t alignment) {
+  auto size = AllocatorDefaultPolicy::memsize(allocated, alignment);
+  AllocatorDefaultPolicy::memfree(allocated, alignment);
+#if !EGG_SINGLE_THREADED
+  if (!this->owned()) {
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    this->remoteDeallocatedBlocks++;
+    this->remoteDeallocatedBytes += size;
+    return;
+  }
+#endif
+  this->deallocatedBlocks++;
+  this->deallocatedBytes += size;
+}
+
+void egg::ovum::AllocatorPool::reclaim(Page& page, Block& block) {
+  block.next = page.free;
+  page.free = &block;
+  assert(page.live > 0);
+  page.live--;
+  auto& sizeclass = this->classes[page.size / AllocatorPool::Granularity - 1];
+  if (&page == sizeclass.current) {
+    // Keep the page we're allocating from even if it is empty, to avoid thrashing
+    return;
+  }
+  if (page.live == 0) {
+    // Return empty pages to the system, but keep their address space for later
+    if (page.partial) {
+      this->unlink(sizeclass, page);
+    }
+    os::memory::decommit(&page, AllocatorPool::PageBytes);
+    this->vacant.push_back(&page);
+    assert(this->committed > 0);
+    this->committed--;
+  } else if (!page.partial) {
+    // The page was full but now has a free block
+    page.prev = nullptr;
+    page.next = sizeclass.partial;
+    if (page.next != nullptr) {
+      page.next->prev = &page;
+    }
+    page.partial = true;
+    sizeclass.partial = &page;
+  }
+}
+
+void egg::ovum::AllocatorPool::reclaimRemote() {
+#if !EGG_SINGLE_THREADED
+  Block* block;
+  {
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    block = std::exchange(this->remote, nullptr);
+  }
+  while (block != nullptr) {
+    auto* next = block->next;
+    auto* page = reinterpret_cast<Page*>(reinterpret_cast<uintptr_t>(block) & ~uintptr_t(AllocatorPool::PageBytes - 1));
+    this->reclaim(*page, *block);
+    block = next;
+  }
+#endif
+}
+
+egg::ovum::AllocatorPool::Page* egg::ovum::AllocatorPool::refill(SizeClass& sizeclass, size_t size) {
+  // The current page is full: blocks freed by other threads may have made room
+  this->reclaimRemote();
+  auto* page = sizeclass.current;
+  if ((page != nullptr) && (page->free != nullptr)) {
+    return page;
+  }
+  // Otherwise resume a partially-used page or start a new one
+  page = sizeclass.partial;
+  if (page != nullptr) {
+    this->unlink(sizeclass, *page);
+  } else {
+    page = this->vacant.empty() ? reinterpret_cast<Page*>(this->fresh) : this->vacant.back();
+    if ((reinterpret_cast<uint8_t*>(page) == this->arena + this->span) || !os::memory::commit(page, AllocatorPool::PageBytes)) {
+      return nullptr;
+    }
+    if (this->vacant.empty()) {
+      this->fresh += AllocatorPool::PageBytes;
+    } else {
+      this->vacant.pop_back();
+    }
+    this->committed++;
+    page->prev = nullptr;
+    page->next = nullptr;
+    page->free = nullptr;
+    page->bump = reinterpret_cast<uint8_t*>(page) + (sizeof(Page) + AllocatorPool::Granularity - 1) / AllocatorPool::Granularity * AllocatorPool::Granularity;
+    page->size = size;
+    page->live = 0;
+    page->partial = false;
+  }
+  sizeclass.current = page;
+  return page;
+}
+
+void egg::ovum::AllocatorPool::unlink(SizeClass& sizeclass, Page& page) {
+  assert(page.partial);
+  if (page.prev != nullptr) {
+    page.prev->next = page.next;
+  } else {
+    assert(sizeclass.partial == &page);
+    sizeclass.partial = page.next;
+  }
+  if (page.next != nullptr) {
+    page.next->prev = page.prev;
+  }
+  page.partial = false;
+}
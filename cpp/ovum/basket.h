@@ -57,4 +57,81 @@ namespace egg::ovum {
     }
   };
   using AllocatorDefault = AllocatorWithPolicy<AllocatorDefaultPolicy>;
+
+  // Small blocks are carved from slab pages with one free list per page; larger blocks use the default policy
+  // Pages come from one reserved address range, so a block is recognised by a range check and its page found by masking
+  // The creating thread uses the pool without locking; other threads bypass it, queuing pooled blocks they free for the owner
+  class AllocatorPool : public IAllocator {
+    AllocatorPool(const AllocatorPool&) = delete;
+    AllocatorPool& operator=(const AllocatorPool&) = delete;
+  public:
+    static constexpr size_t Granularity = 16; // Also the strictest alignment of pooled blocks
+    static constexpr size_t MaximumPooled = 256;
+    static constexpr size_t PageBytes = 16384; // Pages are aligned to this so a block's page is found by masking
+    static constexpr size_t ArenaBytes = size_t(1) << ((sizeof(void*) > 4) ? 30 : 26); // Address space reserved for pages
+  private:
+    struct Block {
+      Block* next;
+    };
+    struct Page {
+      // Header at the start of each page
+      Page* prev; // Neighbours in the size class's list of partially-used pages
+      Page* next;
+      Block* free;
+      uint8_t* bump; // Next never-allocated block
+      size_t size; // Size class of every block in this page
+      size_t live; // Number of blocks currently allocated
+      bool partial; // True if linked into the size class's list of partially-used pages
+    };
+    struct SizeClass {
+      Page* current = nullptr; // Page being allocated from
+      Page* partial = nullptr; // Other pages with free blocks
+    };
+    SizeClass classes[MaximumPooled / Granularity];
+    void* reservation; // As returned by the operating system
+    uint8_t* arena; // First page of the reservation
+    size_t span; // Bytes of the arena available for pages (zero if the reservation failed)
+    uint8_t* fresh; // Next never-committed page
+    std::vector<Page*> vacant; // Pages returned to the system whose address space can be reused
+    size_t committed; // Number of pages currently backed by memory
+    uint64_t allocatedBlocks;
+    uint64_t allocatedBytes;
+    uint64_t deallocatedBlocks;
+    uint64_t deallocatedBytes;
+#if !EGG_SINGLE_THREADED
+    std::thread::id owner;
+    mutable std::mutex mutex; // Guards the fields below, which other threads update
+    Block* remote; // Pooled blocks freed by other threads, awaiting reclamation by the owner
+    uint64_t remoteAllocatedBlocks;
+    uint64_t remoteAllocatedBytes;
+    uint64_t remoteDeallocatedBlocks;
+    uint64_t remoteDeallocatedBytes;
+#endif
+  public:
+    AllocatorPool();
+    virtual ~AllocatorPool() override;
+    virtual void* allocate(size_t bytes, size_t alignment) override;
+    virtual void deallocate(void* allocated, size_t alignment) override;
+    virtual bool statistics(Statistics& out) const override;
+    size_t getPageCount() const {
+      return this->committed;
+    }
+  private:
+    bool owned() const {
+#if EGG_SINGLE_THREADED
+      return true;
+#else
+      return std::this_thread::get_id() == this->owner;
+#endif
+    }
+    bool contains(const void* allocated) const {
+      return (reinterpret_cast<uintptr_t>(allocated) - reinterpret_cast<uintptr_t>(this->arena)) < this->span;
+    }
+    void* allocateDefault(size_t bytes, size_t alignment);
+    void deallocateDefault(void* allocated, size_t alignment);
+    void reclaim(Page& page, Block& block);
+    void reclaimRemote();
+    Page* refill(SizeClass& sizeclass, size_t size);
+    void unlink(SizeClass& sizeclass, Page& page);
+  };
 }
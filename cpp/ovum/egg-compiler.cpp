@@ -33,6 +33,41 @@ namespace {
     return bits;
   }
 
+  bool isVariableNamed(const ParserNode& pnode, const String& symbol) {
+    String name;
+    return (pnode.kind == ParserNode::Kind::Variable) && pnode.value->getString(name) && name.equals(symbol);
+  }
+
+  bool isPairPropertyGet(const ParserNode& pnode, const String& symbol) {
+    // e.g. 'kv.key' or 'kv.value'
+    String property;
+    return (pnode.kind == ParserNode::Kind::ExprProperty) && (pnode.children.size() == 2) && isVariableNamed(*pnode.children.front(), symbol) &&
+      (pnode.children.back()->kind == ParserNode::Kind::Literal) && pnode.children.back()->value->getString(property) &&
+      (property.equals("key") || property.equals("value"));
+  }
+
+  bool isPairwiseOnly(const ParserNode& pnode, const String& symbol, bool captured) {
+    // True if 'symbol' is only read via '.key' and '.value' and never captured, referenced or otherwise observed
+    if (isPairPropertyGet(pnode, symbol)) {
+      return !captured;
+    }
+    if (isVariableNamed(pnode, symbol)) {
+      return false;
+    }
+    if ((pnode.kind == ParserNode::Kind::ExprReference) && !pnode.children.empty() && isPairPropertyGet(*pnode.children.front(), symbol)) {
+      return false;
+    }
+    if ((pnode.kind == ParserNode::Kind::StmtDefineFunction) || (pnode.kind == ParserNode::Kind::TypeSpecification) || (pnode.kind == ParserNode::Kind::ObjectSpecification)) {
+      captured = true;
+    }
+    for (const auto& child : pnode.children) {
+      if ((child != nullptr) && !isPairwiseOnly(*child, symbol, captured)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   class ModuleCompiler final : public IVMModuleBuilder::Reporter {
     ModuleCompiler(const ModuleCompiler&) = delete;
     ModuleCompiler& operator=(const ModuleCompiler&) = delete;
@@ -187,6 +222,7 @@ namespace {
     ModuleNode* compileValueExprTernary(ParserNode& op, ParserNode& lhs, ParserNode& mid, ParserNode& rhs, const ExprContext& context);
     ModuleNode* compileValueExprPredicate(ParserNode& pnode, const ExprContext& context);
     ModuleNode* compileValueExprCall(ParserNodes& pnodes, const ExprContext& context);
+    ModuleNode* compileValueExprCallMethod(ParserNode& dot, ParserNode& lhs, ParserNode& rhs, const ExprContext& context);
     ModuleNode* compileValueExprCallAssert(ParserNode& function, ParserNode& predicate, const ExprContext& context);
     ModuleNode* compileValueExprIndex(ParserNode& bracket, ParserNode& lhs, ParserNode& rhs, const ExprContext& context);
     ModuleNode* compileValueExprProperty(ParserNode& dot, ParserNode& lhs, ParserNode& rhs, const ExprContext& context);
@@ -853,7 +889,9 @@ ModuleNode* ModuleCompiler::compileStmtForEach(ParserNode& pnode, StmtContext& c
   if (bloc == nullptr) {
     return nullptr;
   }
-  return &this->mbuilder.stmtForEach(symbol, *mtype, *iter, *bloc, pnode.range);
+  // Key-value pairs that cannot escape the loop need not be allocated afresh for each iteration
+  auto pairwise = isPairwiseOnly(*pnode.children[2], symbol, false);
+  return &this->mbuilder.stmtForEach(symbol, *mtype, *iter, *bloc, pairwise, pnode.range);
 }
 
 ModuleNode* ModuleCompiler::compileStmtForLoop(ParserNode& pnode, StmtContext& context) {
@@ -1642,14 +1680,23 @@ ModuleNode* ModuleCompiler::compileValueExprCall(ParserNodes& pnodes, const Expr
     }
   }
   ModuleNode* call = nullptr;
-  auto type = this->literalType(**pnode);
-  if (type != nullptr) {
-    call = this->compileValueExprManifestation(**pnode, type, context);
+  if ((*pnode)->kind == ParserNode::Kind::ExprProperty) {
+    // e.g. 's.indexOf(x)'
+    EXPECT(**pnode, (*pnode)->children.size() == 2);
+    EXPECT(**pnode, (*pnode)->children[0] != nullptr);
+    EXPECT(**pnode, (*pnode)->children[1] != nullptr);
+    call = this->compileValueExprCallMethod(**pnode, *(*pnode)->children[0], *(*pnode)->children[1], context);
   } else {
-    call = this->compileValueExpr(**pnode, context);
-  }
-  if (call != nullptr) {
-    call = &this->mbuilder.exprFunctionCall(*call, (*pnode)->range);
+    ModuleNode* function = nullptr;
+    auto type = this->literalType(**pnode);
+    if (type != nullptr) {
+      function = this->compileValueExprManifestation(**pnode, type, context);
+    } else {
+      function = this->compileValueExpr(**pnode, context);
+    }
+    if (function != nullptr) {
+      call = &this->mbuilder.exprFunctionCall(*function, (*pnode)->range);
+    }
   }
   while (++pnode != pnodes.end()) {
     auto* expr = this->compileValueExpr(**pnode, context);
@@ -1662,6 +1709,35 @@ ModuleNode* ModuleCompiler::compileValueExprCall(ParserNodes& pnodes, const Expr
   return call;
 }
 
+ModuleNode* ModuleCompiler::compileValueExprCallMethod(ParserNode& dot, ParserNode& lhs, ParserNode& rhs, const ExprContext& context) {
+  // Specialization for 'instance.method(...)' that avoids materializing 'instance.method' as a value
+  Ambiguous ambiguous;
+  auto* lexpr = this->compileAmbiguousExpr(lhs, context, ambiguous);
+  if (lexpr == nullptr) {
+    return nullptr;
+  }
+  auto* rexpr = this->compileValueExpr(rhs, context);
+  if (rexpr == nullptr) {
+    return nullptr;
+  }
+  if (ambiguous == Ambiguous::Type) {
+    // e.g. 'string.from(...)'
+    lexpr = &this->mbuilder.typeManifestation(*lexpr, lhs.range);
+    auto* mnode = &this->mbuilder.exprPropertyGet(*lexpr, *rexpr, dot.range);
+    auto type = this->deduceTypeExpr(*mnode, context);
+    if (type == nullptr) {
+      return nullptr;
+    }
+    return &this->mbuilder.exprFunctionCall(*mnode, dot.range);
+  }
+  if (rhs.kind != ParserNode::Kind::Literal) {
+    // Computed method names are fetched like any other property
+    auto* mnode = &this->mbuilder.exprPropertyGet(*lexpr, *rexpr, dot.range);
+    return &this->mbuilder.exprFunctionCall(*mnode, dot.range);
+  }
+  return &this->mbuilder.exprMethodCall(*lexpr, *rexpr, dot.range);
+}
+
 ModuleNode* ModuleCompiler::compileValueExprCallAssert(ParserNode& function, ParserNode& predicate, const ExprContext& context) {
   // Specialization for 'assert(predicate)'
   auto* expr = this->compileValueExpr(function, context);
@@ -1774,7 +1850,7 @@ ModuleNode* ModuleCompiler::compileValueExprArray(ParserNode& pnode, const ExprC
 
 ModuleNode* ModuleCompiler::compileValueExprArrayHinted(ParserNode& pnode, const ExprContext& context, const Type& elementType) {
   assert(elementType != nullptr);
-  auto* marray = &this->mbuilder.exprArrayConstruct(elementType, pnode.range);
+  auto* marray = &this->mbuilder.exprArrayConstruct(elementType, true, pnode.range);
   for (auto& pchild : pnode.children) {
     auto* mchild = this->compileValueExprArrayHintedElement(*pchild, context, elementType);
     if (mchild == nullptr) {
@@ -1786,10 +1862,18 @@ ModuleNode* ModuleCompiler::compileValueExprArrayHinted(ParserNode& pnode, const
   return marray;
 }
 
-ModuleNode* ModuleCompiler::compileValueExprArrayHintedElement(ParserNode& pnode, const ExprContext& context, const Type&) {
+ModuleNode* ModuleCompiler::compileValueExprArrayHintedElement(ParserNode& pnode, const ExprContext& context, const Type& elementType) {
   // TODO: handle ellipsis '...'
-  // TODO: check assignability with elementType
-  return this->compileValueExpr(pnode, context);
+  auto* mnode = this->compileValueExpr(pnode, context);
+  if (mnode == nullptr) {
+    return nullptr;
+  }
+  auto type = this->deduceExprType(*mnode, context);
+  assert(type != nullptr);
+  if (this->isAssignable(elementType, type) == Assignability::Never) {
+    return this->error(pnode, "Expected array element of type '", *elementType, "', but instead got a value of type '", *type, "'");
+  }
+  return mnode;
 }
 
 ModuleNode* ModuleCompiler::compileValueExprArrayUnhinted(ParserNode& pnode, const ExprContext& context) {
@@ -1815,7 +1899,7 @@ ModuleNode* ModuleCompiler::compileValueExprArrayUnhinted(ParserNode& pnode, con
   if (unionType == Type::None) {
     unionType = Type::AnyQ;
   }
-  auto* marray = &this->mbuilder.exprArrayConstruct(unionType, pnode.range);
+  auto* marray = &this->mbuilder.exprArrayConstruct(unionType, false, pnode.range);
   for (auto& mchild : mchildren) {
     this->mbuilder.appendChild(*marray, *mchild);
   }
@@ -2363,7 +2447,17 @@ ModuleNode* ModuleCompiler::compileTypeInfer(ParserNode& pnode, ParserNode& ptyp
   if (type == nullptr) {
     return this->error(pnode, "Unable to infer type at compile time"); // TODO
   }
-  mexpr = this->compileValueExpr(pexpr, context);
+  if ((pexpr.kind == ParserNode::Kind::ExprArray) && (pnode.kind != ParserNode::Kind::StmtForEach)) {
+    // Array literals adopt the declared element type so that they get the matching storage
+    ExprContext inner{ &context };
+    auto* shape = type.getOnlyShape();
+    if ((shape != nullptr) && (shape->indexable != nullptr)) {
+      inner.arrayElementType = shape->indexable->getResultType();
+    }
+    mexpr = this->compileValueExpr(pexpr, inner);
+  } else {
+    mexpr = this->compileValueExpr(pexpr, context);
+  }
   if (mexpr == nullptr) {
     return nullptr;
   }
@@ -3050,7 +3144,7 @@ std::string ModuleCompiler::toString(const ParserNode& pnode) {
 
 HardPtr<IVMProgram> egg::ovum::EggCompilerFactory::compileFromStream(IVM& vm, TextStream& stream) {
   auto lexer = LexerFactory::createFromTextStream(stream);
-  auto tokenizer = EggTokenizerFactory::createFromLexer(vm.getAllocator(), lexer);
+  auto tokenizer = EggTokenizerFactory::createFromLexer(vm.getAllocator(), lexer, &vm.getStringPool());
   auto parser = EggParserFactory::createFromTokenizer(vm.getAllocator(), tokenizer);
   auto pbuilder = vm.createProgramBuilder();
   pbuilder->addBuiltin(vm.createString("assert"), Type::Object); // TODO
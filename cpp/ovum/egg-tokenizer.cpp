@@ -93,11 +93,13 @@ namespace {
   private:
     IAllocator& allocator;
     std::shared_ptr<ILexer> lexer;
+    IStringPool* pool;
     LexerItem upcoming;
   public:
-    EggTokenizer(IAllocator& allocator, const std::shared_ptr<ILexer>& lexer)
+    EggTokenizer(IAllocator& allocator, const std::shared_ptr<ILexer>& lexer, IStringPool* pool)
       : allocator(allocator),
-        lexer(lexer) {
+        lexer(lexer),
+        pool(pool) {
       this->upcoming.line = 0;
     }
     virtual EggTokenizerKind next(EggTokenizerItem& item) override {
@@ -146,6 +148,9 @@ namespace {
           return this->nextOperator(item);
         case LexerKind::Identifier:
           item.value.s = String::fromUTF8(this->allocator, this->upcoming.verbatim.data(), this->upcoming.verbatim.size());
+          if (this->pool != nullptr) {
+            item.value.s = this->pool->intern(item.value.s);
+          }
           if (EggTokenizerValue::tryParseKeyword(this->upcoming.verbatim, item.value.k)) {
             item.kind = EggTokenizerKind::Keyword;
           } else {
@@ -189,7 +194,7 @@ namespace {
           this->unexpected("Expected attribute name to follow '@'", UTF32::toReadable(ch));
         }
       }
-      StringBuilder sb;
+      StringBuilder sb{ this->allocator };
       sb.add(this->upcoming.verbatim);
       if (this->lexer->next(this->upcoming) != LexerKind::Identifier) {
         this->unexpected("Expected attribute name to follow '@'");
@@ -226,6 +231,6 @@ namespace {
   };
 }
 
-std::shared_ptr<egg::ovum::IEggTokenizer> egg::ovum::EggTokenizerFactory::createFromLexer(IAllocator& allocator, const std::shared_ptr<ILexer>& lexer) {
-  return std::make_shared<EggTokenizer>(allocator, lexer);
+std::shared_ptr<egg::ovum::IEggTokenizer> egg::ovum::EggTokenizerFactory::createFromLexer(IAllocator& allocator, const std::shared_ptr<ILexer>& lexer, IStringPool* pool) {
+  return std::make_shared<EggTokenizer>(allocator, lexer, pool);
 }
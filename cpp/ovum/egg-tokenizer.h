@@ -157,6 +157,7 @@ namespace egg::ovum {
 
   class EggTokenizerFactory {
   public:
-    static std::shared_ptr<IEggTokenizer> createFromLexer(IAllocator& allocator, const std::shared_ptr<ILexer>& lexer);
+    // Identifiers are interned in 'pool' (if supplied) as they are tokenized
+    static std::shared_ptr<IEggTokenizer> createFromLexer(IAllocator& allocator, const std::shared_ptr<ILexer>& lexer, IStringPool* pool = nullptr);
   };
 }
@@ -4,7 +4,7 @@ namespace egg::ovum {
     HardReferenceCounted(const HardReferenceCounted&) = delete;
     HardReferenceCounted& operator=(const HardReferenceCounted&) = delete;
   protected:
-    mutable Atomic<int64_t> atomic; // signed so we can detect underflows
+    mutable HardAtomic<int64_t> atomic; // signed so we can detect underflows
   public:
     template<typename... ARGS>
     explicit HardReferenceCounted(ARGS&&... args)
@@ -71,7 +71,7 @@ namespace egg::ovum {
   template<typename T>
   class HardPtr {
   private:
-    Atomic<T*> ptr;
+    HardAtomic<T*> ptr;
   public:
     HardPtr(std::nullptr_t = nullptr) : ptr(nullptr) {
     }
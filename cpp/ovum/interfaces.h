@@ -228,12 +228,35 @@ namespace egg::ovum {
   public:
     struct Statistics : public IAllocator::Statistics {
       uint64_t currentBlocksOwned;
+      uint64_t currentBlocksYoung;
+      uint64_t totalCollections;
+      uint64_t totalYoungCollections;
+      uint64_t totalBlocksReclaimed;
+      uint64_t totalBytesReclaimed;
+      uint64_t totalPauses;
+      uint64_t totalMicrosecondsPaused;
+      uint64_t maximumMicrosecondsPaused;
+      uint64_t lastBlocksReclaimed;
+      uint64_t lastBytesReclaimed;
+      uint64_t lastMicrosecondsPaused;
+    };
+    struct Policy {
+      uint64_t bytesAllocated = 32 * 1024 * 1024; // Collect after this many bytes have been allocated since the last collection (zero to disable)
+      uint64_t blocksOwned = 8192; // Collect once at least this many blocks are owned (zero to disable)
+      uint64_t blocksGrowth = 100; // Percentage growth in owned blocks after a collection before the next one
+      uint64_t youngCollections = 7; // Automatic young-generation collections between full ones (zero for full collections only)
+      uint64_t pauseBudget = 0; // Microseconds per slice of an incremental automatic full collection (zero to stop the world instead)
     };
     // Interface
     virtual ICollectable* take(const ICollectable& collectable) = 0;
     virtual void drop(const ICollectable& collectable) = 0;
+    virtual void remember(const ICollectable& owner) = 0;
     virtual size_t collect() = 0;
+    virtual size_t collectYoung() = 0;
+    virtual size_t poll() = 0;
     virtual size_t purge() = 0;
+    virtual Policy getPolicy() const = 0;
+    virtual void setPolicy(const Policy& policy) = 0;
     virtual bool statistics(Statistics& out) const = 0;
     virtual void print(Printer& printer) const = 0;
     // Helpers
@@ -248,11 +271,20 @@ namespace egg::ovum {
       virtual void visit(const ICollectable& target) = 0;
     };
     enum class SetBasketResult { Exempt, Unaltered, Altered, Failed };
+    struct Link {
+      // Intrusive basket membership, only ever manipulated by the owning basket
+      const ICollectable* prev = nullptr;
+      const ICollectable* next = nullptr;
+      bool marked = false;
+      bool old = false; // Survived at least one collection
+      bool remembered = false; // Old but may now refer to young collectables
+    };
     // Interface
     virtual bool validate() const = 0;
     virtual bool softIsRoot() const = 0;
     virtual IBasket* softGetBasket() const = 0;
     virtual SetBasketResult softSetBasket(IBasket* desired) const = 0;
+    virtual Link* softGetLink() const = 0;
     virtual void softVisit(IVisitor& visitor) const = 0;
     virtual int print(Printer& printer) const = 0;
   };
@@ -269,13 +301,27 @@ namespace egg::ovum {
 
   class IObject : public ICollectable {
   public:
+    struct PropertyCache {
+      // Monomorphic inline cache owned by a single property access site whose property key never changes
+      std::atomic<uintptr_t> entry = 0; // Opaque to everything but the object implementation that filled it
+    };
+    struct IterationCursor {
+      // Position of an iteration driven by the caller rather than by an iterator object
+      size_t index = 0;
+      uint64_t modifications = 0;
+    };
     // Interface
     virtual Type vmRuntimeType() = 0;
     virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) = 0;
     virtual HardValue vmIterate(IVMExecution& execution) = 0;
+    virtual HardValue vmIteratePairs(IVMExecution& execution, HardValue& pair) = 0; // Rebinds 'pair' in place; 'Break' if unsupported
+    virtual HardValue vmIterateNext(IVMExecution& execution, IterationCursor& cursor) = 0; // 'Break' if unsupported
     virtual HardValue vmPropertyGet(IVMExecution& execution, const HardValue& property) = 0;
     virtual HardValue vmPropertySet(IVMExecution& execution, const HardValue& property, const HardValue& value) = 0;
     virtual HardValue vmPropertyMut(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value) = 0;
+    virtual HardValue vmPropertyGetCached(IVMExecution& execution, const HardValue& property, PropertyCache& cache) = 0;
+    virtual HardValue vmPropertySetCached(IVMExecution& execution, const HardValue& property, const HardValue& value, PropertyCache& cache) = 0;
+    virtual HardValue vmPropertyMutCached(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value, PropertyCache& cache) = 0;
     virtual HardValue vmPropertyRef(IVMExecution& execution, const HardValue& property) = 0;
     virtual HardValue vmPropertyDel(IVMExecution& execution, const HardValue& property) = 0;
     virtual HardValue vmIndexGet(IVMExecution& execution, const HardValue& index) = 0;
@@ -7,32 +7,13 @@
 namespace {
   using namespace egg::ovum;
 
-  bool tryParseUnsigned(uint64_t& dst, const std::string& src, int base = 10) {
-    if (!src.empty()) {
-      errno = 0;
-      auto* str = src.c_str();
-      char* end = nullptr;
-      auto value = std::strtoull(str, &end, base);
-      if ((errno == 0) && (end == (str + src.size()))) {
-        dst = value;
-        return true;
-      }
-    }
-    return false;
+  bool tryParseUnsigned(uint64_t& dst, const std::string& src, size_t prefix = 0, int base = 10) {
+    assert(prefix <= src.size());
+    return Arithmetic::parse(dst, src.data() + prefix, src.data() + src.size(), base);
   }
-  
+
   bool tryParseFloat(double& dst, const std::string& src) {
-    if (!src.empty()) {
-      errno = 0;
-      auto* str = src.c_str();
-      char* end = nullptr;
-      auto value = std::strtod(str, &end);
-      if ((errno == 0) && (end == (str + src.size()))) {
-        dst = value;
-        return true;
-      }
-    }
-    return false;
+    return Arithmetic::parse(dst, src.data(), src.data() + src.size());
   }
 
   class Lexer : public ILexer {
@@ -208,7 +189,7 @@ namespace {
         this->unexpected(item, "Hexadecimal constant too long");
       }
       item.kind = LexerKind::Integer;
-      if (!tryParseUnsigned(item.value.i, item.verbatim, 16)) {
+      if (!tryParseUnsigned(item.value.i, item.verbatim, 2, 16)) {
         this->unexpected(item, "Invalid hexadecimal integer constant"); // NOCOVERAGE
       }
     }
@@ -108,12 +108,20 @@ namespace {
     }
     template<typename... ARGS>
     HardValue raisePrefixError(IVMExecution& execution, ARGS&&... args) {
-      StringBuilder sb;
+      StringBuilder sb{ this->vm.getAllocator() };
       this->printPrefix(sb);
       sb.add(std::forward<ARGS>(args)...);
       return execution.raiseRuntimeError(sb.build(this->vm.getAllocator()), nullptr);
     }
     virtual void printPrefix(Printer& printer) const = 0;
+    void adopt() {
+      // Objects holding soft references must be owned by the basket so that those references are traced
+      (void)this->vm.getBasket().take(*this);
+    }
+    void remember() {
+      // Write barrier for objects that have just acquired new soft references
+      this->vm.getBasket().remember(*this);
+    }
   public:
     explicit VMObjectBase(IVM& vm)
       : SoftReferenceCounted<IObject>(),
@@ -130,6 +138,14 @@ namespace {
     virtual HardValue vmIterate(IVMExecution& execution) override {
       return this->raisePrefixError(execution, " does not support iteration");
     }
+    virtual HardValue vmIteratePairs(IVMExecution&, HardValue&) override {
+      // Callers fall back to 'vmIterate()'
+      return HardValue::Break;
+    }
+    virtual HardValue vmIterateNext(IVMExecution&, IterationCursor&) override {
+      // Callers fall back to 'vmIterate()'
+      return HardValue::Break;
+    }
     virtual HardValue vmPropertyGet(IVMExecution& execution, const HardValue&) override {
       return this->raisePrefixError(execution, " does not support properties (get)");
     }
@@ -145,6 +161,15 @@ namespace {
     virtual HardValue vmPropertyDel(IVMExecution& execution, const HardValue&) override {
       return this->raisePrefixError(execution, " does not support properties (del)");
     }
+    virtual HardValue vmPropertyGetCached(IVMExecution& execution, const HardValue& property, PropertyCache&) override {
+      return this->vmPropertyGet(execution, property);
+    }
+    virtual HardValue vmPropertySetCached(IVMExecution& execution, const HardValue& property, const HardValue& value, PropertyCache&) override {
+      return this->vmPropertySet(execution, property, value);
+    }
+    virtual HardValue vmPropertyMutCached(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value, PropertyCache&) override {
+      return this->vmPropertyMut(execution, property, mutation, value);
+    }
     virtual HardValue vmIndexGet(IVMExecution& execution, const HardValue&) override {
       return this->raisePrefixError(execution, " does not support indexing (get)");
     }
@@ -213,6 +238,8 @@ namespace {
   };
 
   class VMObjectVanillaMutex {
+    // Containers are owned by the thread that created them and are accessed without locking
+    // The first access from any other thread revokes that ownership for good, after which the reader/writer lock is always taken
     VMObjectVanillaMutex(const VMObjectVanillaMutex&) = delete;
     VMObjectVanillaMutex& operator=(const VMObjectVanillaMutex&) = delete;
   public:
@@ -220,18 +247,21 @@ namespace {
       ReadLock(const ReadLock&) = delete;
       ReadLock& operator=(const ReadLock&) = delete;
     private:
-      egg::ovum::ReadLock lock;
+      VMObjectVanillaMutex& mutex;
+      egg::ovum::ReadLock lock; // Only engaged once the container is shared
     public:
       const uint64_t modifications;
       explicit ReadLock(VMObjectVanillaMutex& mutex);
+      ~ReadLock();
     };
     class WriteLock final {
       WriteLock(const WriteLock&) = delete;
       WriteLock& operator=(const WriteLock&) = delete;
     private:
       VMObjectVanillaMutex& mutex;
-      egg::ovum::WriteLock lock;
+      egg::ovum::WriteLock lock; // Only engaged once the container is shared
     public:
+      const uint64_t modifications;
       bool modified;
       explicit WriteLock(VMObjectVanillaMutex& mutex);
       ~WriteLock();
@@ -241,9 +271,82 @@ namespace {
   private:
     ReadWriteMutex mutex;
     uint64_t modifications;
+#if !EGG_SINGLE_THREADED
+    enum class Sharing { Owned, Revoking, Shared };
+    std::thread::id owner; // The creating thread
+    std::atomic<Sharing> sharing;
+    std::atomic<size_t> depth; // Nesting of unlocked accesses by the owner (only ever written by the owner)
+#endif
   public:
     VMObjectVanillaMutex()
-      : modifications(0) {
+      : modifications(0)
+#if !EGG_SINGLE_THREADED
+      , owner(std::this_thread::get_id()),
+        sharing(Sharing::Owned),
+        depth(0)
+#endif
+    {
+    }
+  private:
+    bool enter() {
+      // Returns true if the calling thread may proceed without locking
+#if EGG_SINGLE_THREADED
+      return true;
+#else
+      auto self = std::this_thread::get_id();
+      if ((self == this->owner) && (this->sharing.load(std::memory_order_relaxed) == Sharing::Owned)) {
+        // Publish our intent before re-checking ownership; only a compiler barrier is needed because 'revoke()' issues a process-wide one
+        auto nesting = this->depth.load(std::memory_order_relaxed);
+        this->depth.store(nesting + 1, std::memory_order_relaxed);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        if (this->sharing.load(std::memory_order_relaxed) == Sharing::Owned) {
+          return true;
+        }
+        this->depth.store(nesting, std::memory_order_release);
+      }
+      this->revoke(self);
+      return false;
+#endif
+    }
+    void leave() {
+#if !EGG_SINGLE_THREADED
+      auto nesting = this->depth.load(std::memory_order_relaxed);
+      assert(nesting > 0);
+      this->depth.store(nesting - 1, std::memory_order_release);
+#endif
+    }
+#if !EGG_SINGLE_THREADED
+    void revoke(std::thread::id self) {
+      auto expected = Sharing::Owned;
+      if (this->sharing.compare_exchange_strong(expected, Sharing::Revoking, std::memory_order_acq_rel)) {
+        // Make the owner's in-flight depth visible to us, or our revocation visible to the owner
+        os::memory::barrier();
+        this->sharing.store(Sharing::Shared, std::memory_order_release);
+      } else {
+        while (this->sharing.load(std::memory_order_acquire) != Sharing::Shared) {
+          std::this_thread::yield();
+        }
+      }
+      if (self != this->owner) {
+        // Wait for any unlocked access by the owner to finish before relying on the lock
+        // The owner itself must not wait: any such access is further up its own stack
+        while (this->depth.load(std::memory_order_acquire) != 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+#endif
+    uint64_t acquire(egg::ovum::ReadLock& lock) {
+      if (!this->enter()) {
+        lock.lock();
+      }
+      return this->modifications;
+    }
+    uint64_t acquire(egg::ovum::WriteLock& lock) {
+      if (!this->enter()) {
+        lock.lock();
+      }
+      return this->modifications;
     }
   };
 
@@ -284,10 +387,11 @@ namespace {
     VMObjectVanillaIterator(IVM& vm, Container& container, VMObjectVanillaMutex::ReadLock& lock)
       : VMObjectBase(vm),
         container(container),
-        soft(vm, HardObject(&container)),
+        soft(vm, *this, HardObject(&container)),
         state() {
       assert(this->soft != nullptr);
       state.modifications = lock.modifications;
+      this->adopt();
     }
   public:
     virtual void softVisit(ICollectable::IVisitor& visitor) const override {
@@ -301,22 +405,430 @@ namespace {
     }
   };
 
-  class VMObjectVanillaArray : public VMObjectVanillaContainer {
+  class VMObjectVanillaArraySoftStorage {
+    // Elements of arbitrary type are stored inline; objects are held as soft pointers traced by the owning array
+    // Hard values are only created as elements are read, so storing primitives costs neither allocations nor basket entries
+    VMObjectVanillaArraySoftStorage(const VMObjectVanillaArraySoftStorage&) = delete;
+    VMObjectVanillaArraySoftStorage& operator=(const VMObjectVanillaArraySoftStorage&) = delete;
+  private:
+    struct Element {
+      ValueFlags flags = ValueFlags::Null;
+      union {
+        Int ivalue = 0; // 0/1 for Bool
+        Float fvalue;
+        IObject* ovalue; // Owned by the basket
+      };
+      String svalue;
+    };
+    std::vector<Element> elements;
+  public:
+    static constexpr bool Traceable = true;
+    VMObjectVanillaArraySoftStorage() = default;
+    size_t size() const {
+      return this->elements.size();
+    }
+    HardValue get(IVMExecution& execution, size_t index) const {
+      return VMObjectVanillaArraySoftStorage::box(execution, this->elements[index]);
+    }
+    bool set(IVM& vm, IVMExecution&, size_t index, const HardValue& value) {
+      // The owning array applies the write barrier
+      return VMObjectVanillaArraySoftStorage::unbox(vm, value.get(), this->elements[index]);
+    }
+    bool mut(IVM& vm, IVMExecution& execution, size_t index, ValueMutationOp mutation, const HardValue& value, HardValue& before) {
+      auto& element = this->elements[index];
+      if (mutation == ValueMutationOp::Assign) {
+        before = VMObjectVanillaArraySoftStorage::box(execution, element);
+        return VMObjectVanillaArraySoftStorage::unbox(vm, value.get(), element);
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN
+      switch (element.flags) {
+      case ValueFlags::Int:
+        before = HardValue::mutateInt(vm.getAllocator(), element.ivalue, mutation, value.get());
+        return true;
+      case ValueFlags::Float:
+        before = HardValue::mutateFloat(vm.getAllocator(), element.fvalue, mutation, value.get());
+        return true;
+      case ValueFlags::Bool:
+      {
+        auto bvalue = element.ivalue != 0;
+        before = HardValue::mutateBool(vm.getAllocator(), bvalue, mutation, value.get());
+        element.ivalue = bvalue ? 1 : 0;
+        return true;
+      }
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END
+      // Other elements only support the conditional assignments
+      before = VMObjectVanillaArraySoftStorage::box(execution, element);
+      switch (mutation) {
+      case ValueMutationOp::IfVoid:
+        return (element.flags != ValueFlags::Void) || VMObjectVanillaArraySoftStorage::unbox(vm, value.get(), element);
+      case ValueMutationOp::IfNull:
+        return (element.flags != ValueFlags::Null) || VMObjectVanillaArraySoftStorage::unbox(vm, value.get(), element);
+      case ValueMutationOp::Noop:
+        return true;
+      default:
+        return false;
+      }
+    }
+    bool push(IVM& vm, const HardValue& value) {
+      Element element;
+      if (!VMObjectVanillaArraySoftStorage::unbox(vm, value.get(), element)) {
+        return false;
+      }
+      this->elements.push_back(std::move(element));
+      return true;
+    }
+    void resize(IVM&, size_t length) {
+      // New elements are null
+      this->elements.resize(length);
+    }
+    void append(IVM&, IVMExecution&, const VMObjectVanillaArraySoftStorage& source, size_t begin, size_t end) {
+      // Both arrays share the basket, so the soft pointers can simply be copied
+      assert((begin <= end) && (end <= source.elements.size()));
+      this->elements.insert(this->elements.end(), source.elements.begin() + std::ptrdiff_t(begin), source.elements.begin() + std::ptrdiff_t(end));
+    }
+    bool fill(IVM& vm, IVMExecution&, size_t begin, size_t end, const HardValue& value) {
+      Element element;
+      if (!VMObjectVanillaArraySoftStorage::unbox(vm, value.get(), element)) {
+        return false;
+      }
+      std::fill(this->elements.begin() + std::ptrdiff_t(begin), this->elements.begin() + std::ptrdiff_t(end), element);
+      return true;
+    }
+    size_t find(const HardValue& value) const {
+      Element unboxed;
+      if (VMObjectVanillaArraySoftStorage::peek(value.get(), unboxed)) {
+        for (size_t index = 0; index < this->elements.size(); ++index) {
+          if (VMObjectVanillaArraySoftStorage::order(this->elements[index], unboxed) == 0) {
+            return index;
+          }
+        }
+      }
+      return SIZE_MAX;
+    }
+    void reverse() {
+      std::reverse(this->elements.begin(), this->elements.end());
+    }
+    void sort() {
+      // Stable so that elements that compare equal (e.g. '1' and '1.0') keep their relative order
+      std::stable_sort(this->elements.begin(), this->elements.end(), [](const Element& lhs, const Element& rhs) {
+        return VMObjectVanillaArraySoftStorage::order(lhs, rhs) < 0;
+      });
+    }
+    void visit(ICollectable::IVisitor& visitor) const {
+      for (const auto& element : this->elements) {
+        if (element.flags == ValueFlags::Object) {
+          assert(element.ovalue != nullptr);
+          visitor.visit(*element.ovalue);
+        }
+      }
+    }
+    void print(Printer& printer, size_t index) const {
+      const auto& element = this->elements[index];
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN
+      switch (element.flags) {
+      case ValueFlags::Bool:
+        printer << (element.ivalue != 0);
+        break;
+      case ValueFlags::Int:
+        printer << element.ivalue;
+        break;
+      case ValueFlags::Float:
+        printer << element.fvalue;
+        break;
+      case ValueFlags::String:
+        printer << element.svalue;
+        break;
+      case ValueFlags::Object:
+        assert(element.ovalue != nullptr);
+        element.ovalue->print(printer);
+        break;
+      default:
+        printer << element.flags;
+        break;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END
+    }
+  private:
+    static HardValue box(IVMCommon& vm, const Element& element) {
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN
+      switch (element.flags) {
+      case ValueFlags::Void:
+        return HardValue::Void;
+      case ValueFlags::Null:
+        return HardValue::Null;
+      case ValueFlags::Bool:
+        return vm.createHardValueBool(element.ivalue != 0);
+      case ValueFlags::Int:
+        return vm.createHardValueInt(element.ivalue);
+      case ValueFlags::Float:
+        return vm.createHardValueFloat(element.fvalue);
+      case ValueFlags::String:
+        return vm.createHardValueString(element.svalue);
+      case ValueFlags::Object:
+        assert(element.ovalue != nullptr);
+        return vm.createHardValueObject(HardObject(element.ovalue));
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END
+      assert(false);
+      return HardValue::Void;
+    }
+    static bool peek(const IValue& value, Element& element) {
+      // Extracts the value without taking ownership of any object
+      element.flags = value.getPrimitiveFlag();
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN
+      switch (element.flags) {
+      case ValueFlags::Void:
+      case ValueFlags::Null:
+        return true;
+      case ValueFlags::Bool:
+      {
+        Bool bvalue;
+        if (value.getBool(bvalue)) {
+          element.ivalue = bvalue ? 1 : 0;
+          return true;
+        }
+        break;
+      }
+      case ValueFlags::Int:
+        return value.getInt(element.ivalue);
+      case ValueFlags::Float:
+        return value.getFloat(element.fvalue);
+      case ValueFlags::String:
+        return value.getString(element.svalue);
+      case ValueFlags::Object:
+      {
+        HardObject ovalue;
+        if (value.getHardObject(ovalue)) {
+          element.ovalue = ovalue.get();
+          return element.ovalue != nullptr;
+        }
+        break;
+      }
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END
+      return false;
+    }
+    static bool unbox(IVM& vm, const IValue& value, Element& element) {
+      // Objects are handed to the basket and thereafter only reachable by tracing the owning array
+      Element unboxed;
+      if (!VMObjectVanillaArraySoftStorage::peek(value, unboxed)) {
+        return false;
+      }
+      if (unboxed.flags == ValueFlags::Object) {
+        auto* taken = vm.getBasket().take(*unboxed.ovalue);
+        assert(taken == unboxed.ovalue);
+        (void)taken;
+      }
+      element = std::move(unboxed);
+      return true;
+    }
+    static int order(const Element& lhs, const Element& rhs) {
+      // Numbers are ordered by value (with promotion) and everything else by the total order of keys
+      if (lhs.flags == ValueFlags::Int) {
+        if (rhs.flags == ValueFlags::Int) {
+          return Arithmetic::order(lhs.ivalue, rhs.ivalue);
+        }
+        if (rhs.flags == ValueFlags::Float) {
+          return Arithmetic::order(Float(lhs.ivalue), rhs.fvalue);
+        }
+      } else if (lhs.flags == ValueFlags::Float) {
+        if (rhs.flags == ValueFlags::Int) {
+          return Arithmetic::order(lhs.fvalue, Float(rhs.ivalue));
+        }
+        if (rhs.flags == ValueFlags::Float) {
+          return Arithmetic::order(lhs.fvalue, rhs.fvalue);
+        }
+      }
+      if (lhs.flags != rhs.flags) {
+        return (lhs.flags < rhs.flags) ? -1 : +1;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_BEGIN
+      switch (lhs.flags) {
+      case ValueFlags::Bool:
+        return Arithmetic::order(lhs.ivalue, rhs.ivalue);
+      case ValueFlags::String:
+        return int(lhs.svalue.compareTo(rhs.svalue));
+      case ValueFlags::Object:
+        return (lhs.ovalue == rhs.ovalue) ? 0 : (lhs.ovalue < rhs.ovalue) ? -1 : +1;
+      }
+      EGG_WARNING_SUPPRESS_SWITCH_END
+      return 0;
+    }
+  };
+
+  template<typename T>
+  class VMObjectVanillaArrayUnboxedStorage {
+    // Primitive elements are packed without boxing, so they cost neither allocations nor basket entries
+    VMObjectVanillaArrayUnboxedStorage(const VMObjectVanillaArrayUnboxedStorage&) = delete;
+    VMObjectVanillaArrayUnboxedStorage& operator=(const VMObjectVanillaArrayUnboxedStorage&) = delete;
+  private:
+    std::vector<T> elements;
+  public:
+    static constexpr bool Traceable = false;
+    VMObjectVanillaArrayUnboxedStorage() = default;
+    size_t size() const {
+      return this->elements.size();
+    }
+    HardValue get(IVMExecution& execution, size_t index) const {
+      return VMObjectVanillaArrayUnboxedStorage::box(execution, this->elements[index]);
+    }
+    bool set(IVM&, IVMExecution&, size_t index, const HardValue& value) {
+      T unboxed;
+      if (!VMObjectVanillaArrayUnboxedStorage::unbox(value, unboxed)) {
+        return false;
+      }
+      this->elements[index] = unboxed;
+      return true;
+    }
+    bool mut(IVM& vm, IVMExecution&, size_t index, ValueMutationOp mutation, const HardValue& value, HardValue& before) {
+      // Mutate a copy in place so that failed mutations leave the element untouched
+      T unboxed = this->elements[index];
+      before = VMObjectVanillaArrayUnboxedStorage::mutate(vm.getAllocator(), unboxed, mutation, value.get());
+      if (!before.hasFlowControl()) {
+        this->elements[index] = unboxed;
+      }
+      return true;
+    }
+    bool push(IVM&, const HardValue& value) {
+      T unboxed;
+      if (!VMObjectVanillaArrayUnboxedStorage::unbox(value, unboxed)) {
+        return false;
+      }
+      this->elements.push_back(unboxed);
+      return true;
+    }
+    void resize(IVM&, size_t length) {
+      // There is no unboxed 'null', so new elements are zero, 0.0 or false
+      this->elements.resize(length);
+    }
+    void append(IVM&, IVMExecution&, const VMObjectVanillaArrayUnboxedStorage& source, size_t begin, size_t end) {
+      assert((begin <= end) && (end <= source.elements.size()));
+      this->elements.insert(this->elements.end(), source.elements.begin() + std::ptrdiff_t(begin), source.elements.begin() + std::ptrdiff_t(end));
+    }
+    bool fill(IVM&, IVMExecution&, size_t begin, size_t end, const HardValue& value) {
+      T unboxed;
+      if (!VMObjectVanillaArrayUnboxedStorage::unbox(value, unboxed)) {
+        return false;
+      }
+      std::fill(this->elements.begin() + std::ptrdiff_t(begin), this->elements.begin() + std::ptrdiff_t(end), unboxed);
+      return true;
+    }
+    size_t find(const HardValue& value) const {
+      T unboxed;
+      if (VMObjectVanillaArrayUnboxedStorage::unbox(value, unboxed)) {
+        auto found = std::find_if(this->elements.begin(), this->elements.end(), [unboxed](T element) {
+          return Arithmetic::order(element, unboxed) == 0;
+        });
+        if (found != this->elements.end()) {
+          return size_t(found - this->elements.begin());
+        }
+      }
+      return SIZE_MAX;
+    }
+    void reverse() {
+      std::reverse(this->elements.begin(), this->elements.end());
+    }
+    void sort() {
+      // Equal elements are indistinguishable, so stability is irrelevant
+      std::sort(this->elements.begin(), this->elements.end(), [](T lhs, T rhs) {
+        return Arithmetic::order(lhs, rhs) < 0;
+      });
+    }
+    void visit(ICollectable::IVisitor&) const {
+      // Nothing to trace
+    }
+    void print(Printer& printer, size_t index) const {
+      printer << T(this->elements[index]);
+    }
+  private:
+    static HardValue box(IVMCommon& vm, T value);
+    static HardValue mutate(IAllocator& allocator, T& value, ValueMutationOp mutation, const IValue& rhs);
+    static bool unbox(const HardValue& value, T& unboxed);
+  };
+
+  template<>
+  HardValue VMObjectVanillaArrayUnboxedStorage<Int>::box(IVMCommon& vm, Int value) {
+    return vm.createHardValueInt(value);
+  }
+
+  template<>
+  HardValue VMObjectVanillaArrayUnboxedStorage<Int>::mutate(IAllocator& allocator, Int& value, ValueMutationOp mutation, const IValue& rhs) {
+    return HardValue::mutateInt(allocator, value, mutation, rhs);
+  }
+
+  template<>
+  bool VMObjectVanillaArrayUnboxedStorage<Int>::unbox(const HardValue& value, Int& unboxed) {
+    return value->getInt(unboxed);
+  }
+
+  template<>
+  HardValue VMObjectVanillaArrayUnboxedStorage<Float>::box(IVMCommon& vm, Float value) {
+    return vm.createHardValueFloat(value);
+  }
+
+  template<>
+  HardValue VMObjectVanillaArrayUnboxedStorage<Float>::mutate(IAllocator& allocator, Float& value, ValueMutationOp mutation, const IValue& rhs) {
+    return HardValue::mutateFloat(allocator, value, mutation, rhs);
+  }
+
+  template<>
+  bool VMObjectVanillaArrayUnboxedStorage<Float>::unbox(const HardValue& value, Float& unboxed) {
+    // Promote integers to floats
+    Int ivalue;
+    if (value->getInt(ivalue)) {
+      unboxed = Float(ivalue);
+      return true;
+    }
+    return value->getFloat(unboxed);
+  }
+
+  template<>
+  HardValue VMObjectVanillaArrayUnboxedStorage<Bool>::box(IVMCommon& vm, Bool value) {
+    return vm.createHardValueBool(value);
+  }
+
+  template<>
+  HardValue VMObjectVanillaArrayUnboxedStorage<Bool>::mutate(IAllocator& allocator, Bool& value, ValueMutationOp mutation, const IValue& rhs) {
+    return HardValue::mutateBool(allocator, value, mutation, rhs);
+  }
+
+  template<>
+  bool VMObjectVanillaArrayUnboxedStorage<Bool>::unbox(const HardValue& value, Bool& unboxed) {
+    return value->getBool(unboxed);
+  }
+
+  class VMObjectVanillaArrayBase : public VMObjectVanillaContainer {
+    // Lets array operations read elements from arrays with a different storage policy
+    VMObjectVanillaArrayBase(const VMObjectVanillaArrayBase&) = delete;
+    VMObjectVanillaArrayBase& operator=(const VMObjectVanillaArrayBase&) = delete;
+  protected:
+    VMObjectVanillaArrayBase(IVM& vm, const Type& containerType, Accessability accessability)
+      : VMObjectVanillaContainer(vm, containerType, accessability) {
+    }
+  public:
+    virtual void snapshot(IVMExecution& execution, std::vector<HardValue>& values) const = 0;
+  };
+
+  template<typename STORAGE>
+  class VMObjectVanillaArray : public VMObjectVanillaArrayBase {
     VMObjectVanillaArray(const VMObjectVanillaArray&) = delete;
     VMObjectVanillaArray& operator=(const VMObjectVanillaArray&) = delete;
+    template<typename> friend class VMObjectVanillaArray;
   public:
     struct IteratorState {
       size_t index;
       uint64_t modifications;
     };
   private:
-    std::deque<SoftValue> elements;
+    STORAGE elements;
     Type elementType;
   public:
     VMObjectVanillaArray(IVM& vm, const Type& containerType, const Type& elementType, Accessability accessability)
-      : VMObjectVanillaContainer(vm, containerType, accessability),
+      : VMObjectVanillaArrayBase(vm, containerType, accessability),
         elements(),
         elementType(elementType) {
+      this->adopt();
     }
     HardValue iteratorNext(IVMExecution& execution, IteratorState& state) {
       VMObjectVanillaMutex::ReadLock lock{ this->mutex };
@@ -326,12 +838,19 @@ namespace {
       if (state.index >= this->elements.size()) {
         return HardValue::Void;
       }
-      return execution.getSoftValue(this->elements[state.index++]);
+      return this->elements.get(execution, state.index++);
     }
-    virtual void softVisit(ICollectable::IVisitor& visitor) const override {
+    virtual void snapshot(IVMExecution& execution, std::vector<HardValue>& values) const override {
       VMObjectVanillaMutex::ReadLock lock{ this->mutex };
-      for (const auto& element : this->elements) {
-        element.visit(visitor);
+      values.reserve(values.size() + this->elements.size());
+      for (size_t index = 0; index < this->elements.size(); ++index) {
+        values.push_back(this->elements.get(execution, index));
+      }
+    }
+    virtual void softVisit(ICollectable::IVisitor& visitor) const override {
+      if constexpr (STORAGE::Traceable) {
+        VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+        this->elements.visit(visitor);
       }
     }
     virtual int print(Printer& printer) const override {
@@ -340,8 +859,9 @@ namespace {
       options.quote = '"';
       Printer inner{ printer.stream, options };
       char separator = '[';
-      for (const auto& element : this->elements) {
-        inner << separator << element.get();
+      for (size_t index = 0; index < this->elements.size(); ++index) {
+        inner << separator;
+        this->elements.print(inner, index);
         separator = ',';
       }
       if (separator == '[') {
@@ -351,6 +871,19 @@ namespace {
       return 0;
     }
     virtual HardValue vmIterate(IVMExecution& execution) override;
+    virtual HardValue vmIterateNext(IVMExecution& execution, IterationCursor& cursor) override {
+      // Same as 'iteratorNext()' but without an iterator object
+      VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+      if (cursor.index == 0) {
+        cursor.modifications = lock.modifications;
+      } else if (lock.modifications != cursor.modifications) {
+        return this->raisePrefixError(execution, " has been modified during iteration");
+      }
+      if (cursor.index >= this->elements.size()) {
+        return HardValue::Void;
+      }
+      return this->elements.get(execution, cursor.index++);
+    }
     virtual HardValue vmIndexGet(IVMExecution& execution, const HardValue& index) override {
       if (!this->hasAccessability(Accessability::Get)) {
         return this->raisePrefixError(execution, " does not permit reading indexed values");
@@ -364,7 +897,7 @@ namespace {
       if (uvalue >= this->elements.size()) {
         return this->raiseRuntimeError(execution, "Array index ", ivalue, " is out of range for an array of length ", this->elements.size());
       }
-      return execution.getSoftValue(this->elements[uvalue]);
+      return this->elements.get(execution, uvalue);
     }
     virtual HardValue vmIndexSet(IVMExecution& execution, const HardValue& index, const HardValue& value) override {
       if (!this->hasAccessability(Accessability::Set)) {
@@ -376,11 +909,14 @@ namespace {
         return this->raiseRuntimeError(execution, "Expected array index value to be an 'int', but instead got ", describe(index.get()));
       }
       auto uvalue = size_t(ivalue);
-      if (uvalue > this->elements.size()) {
+      if (uvalue >= this->elements.size()) {
         return this->raiseRuntimeError(execution, "Array index ", ivalue, " is out of range for an array of length ", this->elements.size());
       }
-      if (!execution.setSoftValue(this->elements[uvalue], value)) {
-        return this->raiseRuntimeError(execution, "Unable to set value at array index ", ivalue);
+      if (!this->elements.set(this->vm, execution, uvalue, value)) {
+        return this->raiseRuntimeError(execution, "Unable to set value at array index ", ivalue, " of '", describe(*this->containerType), "' to ", describe(value.get()));
+      }
+      if constexpr (STORAGE::Traceable) {
+        this->remember();
       }
       return HardValue::Void;
     }
@@ -394,16 +930,23 @@ namespace {
         return this->raiseRuntimeError(execution, "Expected array index value to be an 'int', but instead got ", describe(index.get()));
       }
       auto uvalue = size_t(ivalue);
-      if (uvalue > this->elements.size()) {
+      if (uvalue >= this->elements.size()) {
         return this->raiseRuntimeError(execution, "Array index ", ivalue, " is out of range for an array of length ", this->elements.size());
       }
-      return execution.mutSoftValue(this->elements[uvalue], mutation, value);
+      HardValue before;
+      if (!this->elements.mut(this->vm, execution, uvalue, mutation, value, before)) {
+        return this->raiseRuntimeError(execution, "Unable to modify value at array index ", ivalue, " of '", describe(*this->containerType), "'");
+      }
+      if constexpr (STORAGE::Traceable) {
+        this->remember();
+      }
+      return before;
     }
     virtual HardValue vmIndexRef(IVMExecution& execution, const HardValue& index) override {
       if (!this->hasAccessability(Accessability::Ref)) {
         return this->raisePrefixError(execution, " does not permit referencing indexed values");
       }
-      // TODO do we need to read or write lock here?
+      // Pointers go back through 'vmIndexGet()' etc, so elements never need their own boxes
       return execution.refIndex(HardObject{ this }, index, Modifiability::All, this->elementType);
     }
     virtual HardValue vmIndexDel(IVMExecution& execution, const HardValue&) override {
@@ -419,6 +962,33 @@ namespace {
         if (pname.equals("push")) {
           return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallPush);
         }
+        if (pname.equals("sort")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallSort);
+        }
+        if (pname.equals("slice")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallSlice);
+        }
+        if (pname.equals("concat")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallConcat);
+        }
+        if (pname.equals("indexOf")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallIndexOf);
+        }
+        if (pname.equals("reverse")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallReverse);
+        }
+        if (pname.equals("fill")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallFill);
+        }
+        if (pname.equals("map")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallMap);
+        }
+        if (pname.equals("filter")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallFilter);
+        }
+        if (pname.equals("reduce")) {
+          return this->createSoftMemberHandler(&VMObjectVanillaArray::vmCallReduce);
+        }
         return this->raiseRuntimeError(execution, "Unknown array property name: '", pname, "'");
       }
       return this->raiseRuntimeError(execution, "Expected array property name to be a 'string', but instead got ", describe(property.get()));
@@ -445,7 +1015,7 @@ namespace {
     }
     HardValue lengthMut(IVMExecution& execution, VMObjectVanillaMutex::WriteLock& lock, ValueMutationOp mutation, const HardValue& rhs) {
       auto value = ValueFactory::createInt(this->vm.getAllocator(), Int(this->elements.size()));
-      auto before = value->mutate(mutation, rhs.get());
+      auto before = value.mutate(this->vm.getAllocator(), mutation, rhs.get());
       if (before.hasFlowControl()) {
         return before;
       }
@@ -462,34 +1032,340 @@ namespace {
       if (ivalue > 0xFFFFFFFF) {
         return this->raiseRuntimeError(execution, "Array 'length' property too large: ", ivalue);
       }
+      this->elements.resize(this->vm, size_t(ivalue));
       lock.modified = true;
-      // OPTIMIZE
-      auto diff = ivalue - Int(this->elements.size());
-      while (diff > 0) {
-        this->elements.emplace_back(this->vm, HardValue::Null);
-        diff--;
-      }
-      while (diff < 0) {
-        this->elements.pop_back();
-        diff++;
-      }
       return success;
     }
     bool hasAccessability(Accessability bits) const {
       return Bits::hasAllSet(this->accessability, bits);
     }
-    HardValue vmCallPush(IVMExecution&, const ICallArguments& arguments) {
+    HardValue vmCallPush(IVMExecution& execution, const ICallArguments& arguments) {
       VMObjectVanillaMutex::WriteLock lock{ this->mutex };
       HardValue argument;
       for (size_t index = 0; arguments.getArgumentValueByIndex(index, argument); ++index) {
-        this->elements.emplace_back(this->vm, argument);
+        if (!this->elements.push(this->vm, argument)) {
+          return this->raiseRuntimeError(execution, "Unable to push ", describe(argument.get()), " onto '", describe(*this->containerType), "'");
+        }
+        lock.modified = true;
+      }
+      if constexpr (STORAGE::Traceable) {
+        this->remember();
+      }
+      return HardValue::Void;
+    }
+    HardValue vmCallSort(IVMExecution& execution, const ICallArguments& arguments) {
+      // Without a comparator the elements are sorted in place without leaving C++
+      if (!this->hasAccessability(Accessability::Set)) {
+        return this->raisePrefixError(execution, " does not permit sorting");
+      }
+      HardObject comparator;
+      switch (arguments.getArgumentCount()) {
+      case 0:
+      {
+        VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+        this->elements.sort();
         lock.modified = true;
+        return HardValue::Void;
+      }
+      case 1:
+        if (!this->getCallbackArgument(arguments, 0, comparator)) {
+          return this->raiseRuntimeError(execution, "Array 'sort()' expects its argument to be a comparison function");
+        }
+        break;
+      default:
+        return this->raiseRuntimeError(execution, "Array 'sort()' expects at most one argument");
+      }
+      uint64_t modifications;
+      std::vector<HardValue> values;
+      {
+        VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+        modifications = lock.modifications;
+        this->snapshotLocked(execution, values);
+      }
+      // Merge sorting tolerates the comparator giving up part-way through
+      HardValue raised;
+      std::stable_sort(values.begin(), values.end(), [&](const HardValue& lhs, const HardValue& rhs) {
+        if (raised.hasFlowControl()) {
+          return false;
+        }
+        CallArguments comparison;
+        comparison.addUnnamed(lhs, nullptr);
+        comparison.addUnnamed(rhs, nullptr);
+        auto retval = execution.callFunction(comparator, comparison);
+        if (retval.hasFlowControl()) {
+          raised = retval;
+          return false;
+        }
+        Int order;
+        if (!retval->getInt(order)) {
+          raised = this->raiseRuntimeError(execution, "Array 'sort()' expects its comparison function to return an 'int', but instead got ", describe(retval.get()));
+          return false;
+        }
+        return order < 0;
+      });
+      if (raised.hasFlowControl()) {
+        return raised;
       }
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      if (lock.modifications != modifications) {
+        return this->raisePrefixError(execution, " has been modified during sorting");
+      }
+      for (size_t index = 0; index < values.size(); ++index) {
+        auto success = this->elements.set(this->vm, execution, index, values[index]);
+        assert(success);
+        (void)success;
+      }
+      if constexpr (STORAGE::Traceable) {
+        this->remember();
+      }
+      lock.modified = true;
       return HardValue::Void;
     }
+    HardValue vmCallSlice(IVMExecution& execution, const ICallArguments& arguments) {
+      if (!this->hasAccessability(Accessability::Get)) {
+        return this->raisePrefixError(execution, " does not permit reading indexed values");
+      }
+      if (arguments.getArgumentCount() > 2) {
+        return this->raiseRuntimeError(execution, "Array 'slice()' expects at most two arguments");
+      }
+      auto result = this->createSibling(this->elementType);
+      VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+      size_t begin, end;
+      auto error = this->getRangeArguments(execution, "slice", arguments, 0, begin, end);
+      if (error.hasFlowControl()) {
+        return error;
+      }
+      result->elements.append(this->vm, execution, this->elements, begin, end);
+      return this->createArrayValue(execution, result);
+    }
+    HardValue vmCallConcat(IVMExecution& execution, const ICallArguments& arguments) {
+      // Array arguments are flattened by one level; anything else is appended as a single element
+      if (!this->hasAccessability(Accessability::Get)) {
+        return this->raisePrefixError(execution, " does not permit reading indexed values");
+      }
+      auto result = this->createSibling(this->elementType);
+      {
+        VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+        result->elements.append(this->vm, execution, this->elements, 0, this->elements.size());
+      }
+      HardValue argument;
+      for (size_t index = 0; arguments.getArgumentValueByIndex(index, argument); ++index) {
+        HardObject object;
+        auto* array = argument->getHardObject(object) ? dynamic_cast<VMObjectVanillaArrayBase*>(object.get()) : nullptr;
+        if (array == nullptr) {
+          if (!result->elements.push(this->vm, argument)) {
+            return this->raiseRuntimeError(execution, "Unable to concatenate ", describe(argument.get()), " onto '", describe(*this->containerType), "'");
+          }
+          continue;
+        }
+        auto* sibling = dynamic_cast<VMObjectVanillaArray*>(array);
+        if (sibling != nullptr) {
+          // Same storage policy, so copy the elements without boxing them
+          VMObjectVanillaMutex::ReadLock lock{ sibling->mutex };
+          result->elements.append(this->vm, execution, sibling->elements, 0, sibling->elements.size());
+          continue;
+        }
+        std::vector<HardValue> values;
+        array->snapshot(execution, values);
+        for (const auto& value : values) {
+          if (!result->elements.push(this->vm, value)) {
+            return this->raiseRuntimeError(execution, "Unable to concatenate ", describe(value.get()), " onto '", describe(*this->containerType), "'");
+          }
+        }
+      }
+      return this->createArrayValue(execution, result);
+    }
+    HardValue vmCallIndexOf(IVMExecution& execution, const ICallArguments& arguments) {
+      if (!this->hasAccessability(Accessability::Get)) {
+        return this->raisePrefixError(execution, " does not permit reading indexed values");
+      }
+      HardValue value;
+      if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, value)) {
+        return this->raiseRuntimeError(execution, "Array 'indexOf()' expects exactly one argument");
+      }
+      VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+      auto found = this->elements.find(value);
+      if (found == SIZE_MAX) {
+        return execution.createHardValueInt(-1);
+      }
+      return execution.createHardValueInt(Int(found));
+    }
+    HardValue vmCallReverse(IVMExecution& execution, const ICallArguments& arguments) {
+      if (!this->hasAccessability(Accessability::Set)) {
+        return this->raisePrefixError(execution, " does not permit reversing");
+      }
+      if (arguments.getArgumentCount() != 0) {
+        return this->raiseRuntimeError(execution, "Array 'reverse()' expects no arguments");
+      }
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      this->elements.reverse();
+      lock.modified = true;
+      return HardValue::Void;
+    }
+    HardValue vmCallFill(IVMExecution& execution, const ICallArguments& arguments) {
+      if (!this->hasAccessability(Accessability::Set)) {
+        return this->raisePrefixError(execution, " does not permit writing indexed values");
+      }
+      HardValue value;
+      if ((arguments.getArgumentCount() > 3) || !arguments.getArgumentValueByIndex(0, value)) {
+        return this->raiseRuntimeError(execution, "Array 'fill()' expects between one and three arguments");
+      }
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      size_t begin, end;
+      auto error = this->getRangeArguments(execution, "fill", arguments, 1, begin, end);
+      if (error.hasFlowControl()) {
+        return error;
+      }
+      if (!this->elements.fill(this->vm, execution, begin, end, value)) {
+        return this->raiseRuntimeError(execution, "Unable to fill '", describe(*this->containerType), "' with ", describe(value.get()));
+      }
+      if constexpr (STORAGE::Traceable) {
+        this->remember();
+      }
+      lock.modified = true;
+      return HardValue::Void;
+    }
+    HardValue vmCallMap(IVMExecution& execution, const ICallArguments& arguments) {
+      HardObject mapper;
+      if ((arguments.getArgumentCount() != 1) || !this->getCallbackArgument(arguments, 0, mapper)) {
+        return this->raiseRuntimeError(execution, "Array 'map()' expects exactly one argument: a mapping function");
+      }
+      std::vector<HardValue> values;
+      auto error = this->snapshotReadable(execution, values);
+      if (error.hasFlowControl()) {
+        return error;
+      }
+      // The mapping function may return anything
+      using Result = VMObjectVanillaArray<VMObjectVanillaArraySoftStorage>;
+      auto containerType = this->vm.getTypeForge().forgeArrayType(Type::AnyQ, this->accessability);
+      auto result = makeHardObject<Result, HardPtr<Result>>(this->vm, containerType, Type::AnyQ, this->accessability);
+      for (size_t index = 0; index < values.size(); ++index) {
+        CallArguments mapping;
+        mapping.addUnnamed(values[index], nullptr);
+        mapping.addUnnamed(execution.createHardValueInt(Int(index)), nullptr);
+        auto retval = execution.callFunction(mapper, mapping);
+        if (retval.hasFlowControl()) {
+          return retval;
+        }
+        result->elements.push(this->vm, retval);
+      }
+      return this->createArrayValue(execution, result);
+    }
+    HardValue vmCallFilter(IVMExecution& execution, const ICallArguments& arguments) {
+      HardObject predicate;
+      if ((arguments.getArgumentCount() != 1) || !this->getCallbackArgument(arguments, 0, predicate)) {
+        return this->raiseRuntimeError(execution, "Array 'filter()' expects exactly one argument: a predicate function");
+      }
+      std::vector<HardValue> values;
+      auto error = this->snapshotReadable(execution, values);
+      if (error.hasFlowControl()) {
+        return error;
+      }
+      auto result = this->createSibling(this->elementType);
+      for (size_t index = 0; index < values.size(); ++index) {
+        CallArguments filtering;
+        filtering.addUnnamed(values[index], nullptr);
+        filtering.addUnnamed(execution.createHardValueInt(Int(index)), nullptr);
+        auto retval = execution.callFunction(predicate, filtering);
+        if (retval.hasFlowControl()) {
+          return retval;
+        }
+        Bool keep;
+        if (!retval->getBool(keep)) {
+          return this->raiseRuntimeError(execution, "Array 'filter()' expects its predicate function to return a 'bool', but instead got ", describe(retval.get()));
+        }
+        if (keep) {
+          auto success = result->elements.push(this->vm, values[index]);
+          assert(success);
+          (void)success;
+        }
+      }
+      return this->createArrayValue(execution, result);
+    }
+    HardValue vmCallReduce(IVMExecution& execution, const ICallArguments& arguments) {
+      HardObject reducer;
+      auto count = arguments.getArgumentCount();
+      if ((count < 1) || (count > 2) || !this->getCallbackArgument(arguments, 0, reducer)) {
+        return this->raiseRuntimeError(execution, "Array 'reduce()' expects a reducing function and an optional initial value");
+      }
+      std::vector<HardValue> values;
+      auto error = this->snapshotReadable(execution, values);
+      if (error.hasFlowControl()) {
+        return error;
+      }
+      HardValue accumulator;
+      size_t index = 0;
+      if (!arguments.getArgumentValueByIndex(1, accumulator)) {
+        if (values.empty()) {
+          return this->raiseRuntimeError(execution, "Array 'reduce()' of an empty array requires an initial value");
+        }
+        accumulator = values[index++];
+      }
+      for (; index < values.size(); ++index) {
+        CallArguments reducing;
+        reducing.addUnnamed(accumulator, nullptr);
+        reducing.addUnnamed(values[index], nullptr);
+        accumulator = execution.callFunction(reducer, reducing);
+        if (accumulator.hasFlowControl()) {
+          break;
+        }
+      }
+      return accumulator;
+    }
+    void snapshotLocked(IVMExecution& execution, std::vector<HardValue>& values) const {
+      // Callbacks must run without the lock held, so they see a copy of the elements
+      values.reserve(this->elements.size());
+      for (size_t index = 0; index < this->elements.size(); ++index) {
+        values.push_back(this->elements.get(execution, index));
+      }
+    }
+    HardValue snapshotReadable(IVMExecution& execution, std::vector<HardValue>& values) {
+      if (!this->hasAccessability(Accessability::Get)) {
+        return this->raisePrefixError(execution, " does not permit reading indexed values");
+      }
+      VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+      this->snapshotLocked(execution, values);
+      return HardValue::Void;
+    }
+    bool getCallbackArgument(const ICallArguments& arguments, size_t index, HardObject& callback) const {
+      HardValue argument;
+      return arguments.getArgumentValueByIndex(index, argument) && argument->getHardObject(callback) && (callback != nullptr);
+    }
+    HardValue getRangeArguments(IVMExecution& execution, const char* method, const ICallArguments& arguments, size_t first, size_t& begin, size_t& end) {
+      // Negative indices count back from the end and out-of-range indices are clamped
+      auto length = this->elements.size();
+      size_t resolved[2] = { 0, length };
+      for (size_t index = 0; index < 2; ++index) {
+        HardValue argument;
+        if (arguments.getArgumentValueByIndex(first + index, argument)) {
+          Int ivalue;
+          if (!argument->getInt(ivalue)) {
+            return this->raiseRuntimeError(execution, "Array '", method, "()' expects its range arguments to be 'int' values, but instead got ", describe(argument.get()));
+          }
+          if (ivalue < 0) {
+            ivalue = std::max(ivalue + Int(length), Int(0));
+          }
+          resolved[index] = std::min(size_t(ivalue), length);
+        }
+      }
+      begin = resolved[0];
+      end = std::max(resolved[0], resolved[1]);
+      return HardValue::Void;
+    }
+    HardPtr<VMObjectVanillaArray> createSibling(const Type& elementType) const {
+      return makeHardObject<VMObjectVanillaArray, HardPtr<VMObjectVanillaArray>>(this->vm, this->containerType, elementType, this->accessability);
+    }
+    template<typename RESULT>
+    HardValue createArrayValue(IVMExecution& execution, const HardPtr<VMObjectVanillaArray<RESULT>>& result) const {
+      if constexpr (RESULT::Traceable) {
+        result->remember();
+      }
+      return execution.createHardValueObject(HardObject(result.get()));
+    }
   };
 
-  class VMObjectVanillaArrayIterator : public VMObjectVanillaIterator<VMObjectVanillaArray, VMObjectVanillaArray::IteratorState> {
+  template<typename STORAGE>
+  class VMObjectVanillaArrayIterator : public VMObjectVanillaIterator<VMObjectVanillaArray<STORAGE>, typename VMObjectVanillaArray<STORAGE>::IteratorState> {
     VMObjectVanillaArrayIterator(const VMObjectVanillaArrayIterator&) = delete;
     VMObjectVanillaArrayIterator& operator=(const VMObjectVanillaArrayIterator&) = delete;
   protected:
@@ -497,8 +1373,8 @@ namespace {
       printer << "Array iterator";
     }
   public:
-    VMObjectVanillaArrayIterator(IVM& vm, Container& array, VMObjectVanillaMutex::ReadLock& lock)
-      : VMObjectVanillaIterator(vm, array, lock) {
+    VMObjectVanillaArrayIterator(IVM& vm, VMObjectVanillaArray<STORAGE>& array, VMObjectVanillaMutex::ReadLock& lock)
+      : VMObjectVanillaIterator<VMObjectVanillaArray<STORAGE>, typename VMObjectVanillaArray<STORAGE>::IteratorState>(vm, array, lock) {
     }
     virtual int print(Printer& printer) const override {
       printer << "[vanilla array iterator]";
@@ -510,6 +1386,106 @@ namespace {
     }
   };
 
+  template<typename STORAGE>
+  HardValue VMObjectVanillaArray<STORAGE>::vmIterate(IVMExecution& execution) {
+    VMObjectVanillaMutex::ReadLock lock{ this->mutex };
+    auto iterator = makeHardObject<VMObjectVanillaArrayIterator<STORAGE>>(this->vm, *this, lock);
+    return execution.createHardValueObject(iterator);
+  }
+
+  class alignas(64) VMObjectVanillaShape {
+    // Hidden class shared by vanilla objects whose literal string properties were created in the same order
+    // The alignment leaves room for a slot index in the low bits of a shape address (see 'PropertyCache')
+    VMObjectVanillaShape(const VMObjectVanillaShape&) = delete;
+    VMObjectVanillaShape& operator=(const VMObjectVanillaShape&) = delete;
+  private:
+    const VMObjectVanillaShape* parent; // Null for the root
+    String name; // Name of the newest slot; earlier names are held by our ancestors
+    size_t slots;
+    std::unordered_map<String, VMObjectVanillaShape*> transitions; // Guarded by the owning 'VMObjectVanillaShapes' mutex
+  public:
+    static constexpr size_t NotFound = SIZE_MAX;
+    static constexpr size_t MaximumSlots = 64; // Larger objects degrade to dictionaries
+    static constexpr size_t MaximumTransitions = 64; // Objects that would branch further degrade to dictionaries
+    VMObjectVanillaShape()
+      : parent(nullptr),
+        slots(0) {
+    }
+    VMObjectVanillaShape(const VMObjectVanillaShape& parent, const String& name)
+      : parent(&parent),
+        name(name),
+        slots(parent.slots + 1) {
+    }
+    size_t getSlotCount() const {
+      return this->slots;
+    }
+    size_t findSlot(const String& name) const {
+      // Walk back towards the root; most lookups are satisfied by the inline caches anyway
+      for (auto* shape = this; shape->parent != nullptr; shape = shape->parent) {
+        if (shape->name.equals(name)) {
+          return shape->slots - 1;
+        }
+      }
+      return NotFound;
+    }
+    VMObjectVanillaShape* findTransition(const String& name) const {
+      auto found = this->transitions.find(name);
+      return (found == this->transitions.end()) ? nullptr : found->second;
+    }
+    bool canTransition() const {
+      return this->transitions.size() < MaximumTransitions;
+    }
+    void addTransition(VMObjectVanillaShape& transition) {
+      assert(transition.parent == this);
+      this->transitions.emplace(transition.name, &transition);
+    }
+    uintptr_t getCacheEntry(size_t slot) const {
+      // Pack the shape and slot into a single word so that concurrent runners never see a torn cache
+      assert(slot < MaximumSlots);
+      auto entry = reinterpret_cast<uintptr_t>(this);
+      assert((entry & (MaximumSlots - 1)) == 0);
+      return entry | slot;
+    }
+    bool hitCacheEntry(uintptr_t entry, size_t& slot) const {
+      if ((entry & ~uintptr_t(MaximumSlots - 1)) == reinterpret_cast<uintptr_t>(this)) {
+        slot = size_t(entry & (MaximumSlots - 1));
+        return true;
+      }
+      return false;
+    }
+  };
+  static_assert(alignof(VMObjectVanillaShape) >= VMObjectVanillaShape::MaximumSlots);
+
+  class VMObjectVanillaShapes : public HardReferenceCountedAllocator<IObjectShapes> {
+    VMObjectVanillaShapes(const VMObjectVanillaShapes&) = delete;
+    VMObjectVanillaShapes& operator=(const VMObjectVanillaShapes&) = delete;
+  private:
+    mutable std::mutex mutex;
+    std::deque<VMObjectVanillaShape> shapes; // Never shrinks, so inline caches cannot be fooled by a recycled address
+  public:
+    explicit VMObjectVanillaShapes(IAllocator& allocator)
+      : HardReferenceCountedAllocator<IObjectShapes>(allocator) {
+      this->shapes.emplace_back();
+    }
+    virtual size_t getShapeCount() const override {
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      return this->shapes.size();
+    }
+    VMObjectVanillaShape& getRoot() {
+      return this->shapes.front();
+    }
+    VMObjectVanillaShape* transition(VMObjectVanillaShape& from, const String& name) {
+      // Returns null if 'from' already has too many transitions
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      auto* found = from.findTransition(name);
+      if ((found == nullptr) && from.canTransition()) {
+        found = &this->shapes.emplace_back(from, name);
+        from.addTransition(*found);
+      }
+      return found;
+    }
+  };
+
   class VMObjectVanillaObject : public VMObjectVanillaContainer {
     VMObjectVanillaObject(const VMObjectVanillaObject&) = delete;
     VMObjectVanillaObject& operator=(const VMObjectVanillaObject&) = delete;
@@ -519,41 +1495,44 @@ namespace {
       uint64_t modifications;
     };
   private:
+    struct Slot {
+      SoftKey key;
+      SoftValue value;
+      Type type; // Null if 'unknownType' applies
+      Accessability accessability;
+    };
+    static constexpr size_t NotFound = VMObjectVanillaShape::NotFound;
     Type unknownType;
-    std::map<SoftKey, SoftValue, SoftComparator> properties;
-    std::map<SoftKey, Accessability, SoftComparator> accessabilities;
-    std::map<SoftKey, Type, SoftComparator> types;
-    std::vector<SoftKey> keys;
+    VMObjectVanillaShape* shape; // Null once we've degraded to a dictionary
+    std::vector<Slot> slots; // In order of creation
+    std::map<SoftKey, size_t, SoftComparator> dictionary; // Only used once we've degraded; keys duplicate those in 'slots'
   public:
     VMObjectVanillaObject(IVM& vm, const Type& containerType, Accessability accessability)
       : VMObjectVanillaContainer(vm, containerType, accessability),
-        unknownType(VMObjectVanillaObject::determineUnknownType(containerType)) {
+        unknownType(VMObjectVanillaObject::determineUnknownType(containerType)),
+        shape(&VMObjectVanillaObject::getShapes(vm).getRoot()) {
       assert(this->unknownType.validate());
+      this->adopt();
     }
     HardValue iteratorNext(IVMExecution& execution, IteratorState& state) {
       VMObjectVanillaMutex::ReadLock lock{ this->mutex };
       if (lock.modifications != state.modifications) {
         return this->raisePrefixError(execution, " has been modified during iteration");
       }
-      if (state.index >= this->keys.size()) {
+      if (state.index >= this->slots.size()) {
         return HardValue::Void;
       }
-      const auto& softkey = this->keys[state.index++];
-      auto key = this->vm.getSoftKey(softkey);
-      auto found = this->properties.find(softkey);
-      if (found == this->properties.end()) {
-        return this->raisePrefixError(execution, " is missing property '", key.get(), "' during iteration");
-      }
-      const auto& softvalue = found->second;
-      auto value = this->vm.getSoftValue(softvalue);
+      const auto& slot = this->slots[state.index++];
+      auto key = this->vm.getSoftKey(slot.key);
+      auto value = this->vm.getSoftValue(slot.value);
       auto object = ObjectFactory::createVanillaKeyValue(this->vm, key, value, Accessability::Get);
       return execution.createHardValueObject(object);
     }
     virtual void softVisit(ICollectable::IVisitor& visitor) const override {
-      // We only need to iterate around the property member elements as the key vectors are simply duplicates
-      for (const auto& property : this->properties) {
-        property.first.visit(visitor);
-        property.second.visit(visitor);
+      // The dictionary keys are simply duplicates of the slot keys
+      for (const auto& slot : this->slots) {
+        slot.key.visit(visitor);
+        slot.value.visit(visitor);
       }
     }
     virtual int print(Printer& printer) const override {
@@ -564,9 +1543,9 @@ namespace {
       unoptions.quote = '\0';
       Printer unquoted{ printer.stream, unoptions };
       char separator = '{';
-      for (const auto& key : this->keys) {
-        unquoted << separator << key.get() << ':';
-        quoted << this->properties.find(key)->second.get();
+      for (const auto& slot : this->slots) {
+        unquoted << separator << slot.key.get() << ':';
+        quoted << slot.value.get();
         separator = ',';
       }
       if (separator == '{') {
@@ -576,14 +1555,15 @@ namespace {
       return 0;
     }
     virtual HardValue vmIterate(IVMExecution& execution) override;
+    virtual HardValue vmIteratePairs(IVMExecution& execution, HardValue& pair) override;
     virtual HardValue vmIndexGet(IVMExecution& execution, const HardValue& index) override {
-      return this->propertyGet(execution, index);
+      return this->propertyGet(execution, index, nullptr);
     }
     virtual HardValue vmIndexSet(IVMExecution& execution, const HardValue& index, const HardValue& value) override {
-      return this->propertySet(execution, index, value);
+      return this->propertySet(execution, index, value, nullptr);
     }
     virtual HardValue vmIndexMut(IVMExecution& execution, const HardValue& index, ValueMutationOp mutation, const HardValue& value) override {
-      return this->propertyMut(execution, index, mutation, value);
+      return this->propertyMut(execution, index, mutation, value, nullptr);
     }
     virtual HardValue vmIndexRef(IVMExecution& execution, const HardValue& index) override {
       return this->propertyRef(execution, index, Modifiability::All);
@@ -592,13 +1572,13 @@ namespace {
       return this->propertyDel(execution, index);
     }
     virtual HardValue vmPropertyGet(IVMExecution& execution, const HardValue& property) override {
-      return this->propertyGet(execution, property);
+      return this->propertyGet(execution, property, nullptr);
     }
     virtual HardValue vmPropertySet(IVMExecution& execution, const HardValue& property, const HardValue& value) override {
-      return this->propertySet(execution, property, value);
+      return this->propertySet(execution, property, value, nullptr);
     }
     virtual HardValue vmPropertyMut(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value) override {
-      return this->propertyMut(execution, property, mutation, value);
+      return this->propertyMut(execution, property, mutation, value, nullptr);
     }
     virtual HardValue vmPropertyRef(IVMExecution& execution, const HardValue& property) override {
       return this->propertyRef(execution, property, Modifiability::All);
@@ -606,51 +1586,61 @@ namespace {
     virtual HardValue vmPropertyDel(IVMExecution& execution, const HardValue& property) override {
       return this->propertyDel(execution, property);
     }
+    virtual HardValue vmPropertyGetCached(IVMExecution& execution, const HardValue& property, PropertyCache& cache) override {
+      return this->propertyGet(execution, property, &cache);
+    }
+    virtual HardValue vmPropertySetCached(IVMExecution& execution, const HardValue& property, const HardValue& value, PropertyCache& cache) override {
+      return this->propertySet(execution, property, value, &cache);
+    }
+    virtual HardValue vmPropertyMutCached(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value, PropertyCache& cache) override {
+      return this->propertyMut(execution, property, mutation, value, &cache);
+    }
   private:
-    HardValue propertyGet(IVMExecution& execution, const HardValue& property) {
+    HardValue propertyGet(IVMExecution& execution, const HardValue& property, PropertyCache* cache) {
       VMObjectVanillaMutex::ReadLock lock{ this->mutex };
-      auto pfound = this->properties.find(property);
-      if (pfound == this->properties.end()) {
+      auto index = this->propertyFind(property, cache);
+      if (index == NotFound) {
         return this->raisePrefixError(execution, " does not contain property '", property, "'");
       }
-      if (!this->hasAccessability(property, Accessability::Get)) {
+      const auto& slot = this->slots[index];
+      if (!Bits::hasAllSet(slot.accessability, Accessability::Get)) {
         return this->raisePrefixError(execution, " does not permit getting property '", property, "'");
       }
-      return execution.getSoftValue(pfound->second);
+      return execution.getSoftValue(slot.value);
     }
-    HardValue propertySet(IVMExecution& execution, const HardValue& property, const HardValue& value) {
-      if (!this->hasAccessability(property, Accessability::Set)) {
+    HardValue propertySet(IVMExecution& execution, const HardValue& property, const HardValue& value, PropertyCache* cache) {
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      auto index = this->propertyFind(property, cache);
+      if (!this->hasAccessability(index, Accessability::Set)) {
         return this->raisePrefixError(execution, " does not permit setting property '", property, "'");
       }
-      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
-      auto pfound = this->properties.find(property);
-      if (pfound == this->properties.end()) {
+      if (index == NotFound) {
         if (this->unknownType == Type::Void) {
           return this->raisePrefixError(execution, " does not permit creating property '", property, "'");
         }
-        pfound = this->propertyCreate(property);
+        index = this->propertyCreate(property, cache != nullptr);
       }
-      auto ptype = this->propertyType(property);
-      if (ptype == nullptr) {
+      auto& slot = this->slots[index];
+      if (slot.type == nullptr) {
         // No need to type-check
-        if (!execution.setSoftValue(pfound->second, value)) {
+        if (!execution.setSoftValue(slot.value, value)) {
           return this->raiseRuntimeError(execution, "Type mismatch setting '", describe(*this->containerType), "' property '", property, "' to ", describe(value.get()));
         }
       } else {
         // Type-check the assignment
-        if (!execution.assignValue(pfound->second.get(), ptype, value.get())) {
-          return this->raiseRuntimeError(execution, "Type mismatch setting '", describe(*this->containerType), "' property '", property, "' (declared as '", describe(*ptype), "') to ", describe(value.get()));
+        if (!execution.assignValue(slot.value.get(), slot.type, value.get())) {
+          return this->raiseRuntimeError(execution, "Type mismatch setting '", describe(*this->containerType), "' property '", property, "' (declared as '", describe(*slot.type), "') to ", describe(value.get()));
         }
       }
       return HardValue::Void;
     }
-    HardValue propertyMut(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value) {
-      if (!this->hasAccessability(property, Accessability::Mut)) {
+    HardValue propertyMut(IVMExecution& execution, const HardValue& property, ValueMutationOp mutation, const HardValue& value, PropertyCache* cache) {
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      auto index = this->propertyFind(property, cache);
+      if (!this->hasAccessability(index, Accessability::Mut)) {
         return this->raisePrefixError(execution, " does not permit modifying property '", property, "'");
       }
-      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
-      auto pfound = this->properties.find(property);
-      if (pfound == this->properties.end()) {
+      if (index == NotFound) {
         // Unknown property
         if ((mutation != ValueMutationOp::Assign) && (mutation != ValueMutationOp::IfVoid)) {
           return this->raisePrefixError(execution, " does not contain property '", property, "'");
@@ -658,83 +1648,136 @@ namespace {
         if (this->unknownType == Type::Void) {
           return this->raisePrefixError(execution, " does not permit creating property '", property, "'");
         }
-        pfound = this->propertyCreate(property);
+        index = this->propertyCreate(property, cache != nullptr);
       }
       // TODO type check
-      return execution.mutSoftValue(pfound->second, mutation, value);
+      return execution.mutSoftValue(this->slots[index].value, mutation, value);
     }
     HardValue propertyRef(IVMExecution& execution, const HardValue& property, Modifiability modifiability) {
-      if (!this->hasAccessability(property, Accessability::Ref)) {
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      auto index = this->propertyFind(property, nullptr);
+      if (!this->hasAccessability(index, Accessability::Ref)) {
         return this->raisePrefixError(execution, " does not permit referencing property '", property, "'");
       }
-      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
-      auto ptype = this->propertyType(property);
+      auto ptype = this->propertyType(index);
       if (ptype == nullptr) {
         return this->raisePrefixError(execution, " does not contain property '", property, "'");
       }
       return execution.refProperty(HardObject{ this }, property, modifiability, ptype);
     }
     HardValue propertyDel(IVMExecution& execution, const HardValue& property) {
-      if (!this->hasAccessability(property, Accessability::Del)) {
+      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
+      auto index = this->propertyFind(property, nullptr);
+      if (!this->hasAccessability(index, Accessability::Del)) {
         return this->raisePrefixError(execution, " does not permit deleting property '", property, "'");
       }
-      VMObjectVanillaMutex::WriteLock lock{ this->mutex };
-      auto pfound = this->properties.find(property);
-      if (pfound == this->properties.end()) {
+      if (index == NotFound) {
         // Didn't exist
         return HardValue::Void;
       }
-      auto& needle = pfound->first.get();
-      std::erase_if(this->keys, [&needle](const SoftKey& key) { return SoftKey::compare(key.get(), needle) == 0; });
-      auto result = execution.getSoftValue(pfound->second);
-      this->properties.erase(pfound);
-      return result;
+      auto result = execution.getSoftValue(this->slots[index].value);
+      this->slots.erase(this->slots.begin() + std::ptrdiff_t(index));
+      // Shapes only ever grow, so deletion degrades us to a dictionary
+      this->shape = nullptr;
+      this->reindex();
+      return result;
+    }
+  protected:
+    bool slotSet(IVMExecution& execution, size_t index, const HardValue& value) {
+      // Overwrites the value in place without any accessability checks
+      assert(index < this->slots.size());
+      return execution.setSoftValue(this->slots[index].value, value);
+    }
+    size_t propertyFind(const HardValue& pkey, PropertyCache* cache) const {
+      if (this->shape != nullptr) {
+        size_t slot;
+        if ((cache != nullptr) && this->shape->hitCacheEntry(cache->entry.load(std::memory_order_relaxed), slot)) {
+          // Inline cache hit
+          assert(slot < this->slots.size());
+          return slot;
+        }
+        String name;
+        if (!pkey->getString(name)) {
+          // Shapes only describe string keys
+          return NotFound;
+        }
+        slot = this->shape->findSlot(name);
+        if ((cache != nullptr) && (slot != NotFound)) {
+          cache->entry.store(this->shape->getCacheEntry(slot), std::memory_order_relaxed);
+        }
+        return slot;
+      }
+      auto found = this->dictionary.find(pkey);
+      if (found == this->dictionary.end()) {
+        return NotFound;
+      }
+      return found->second;
+    }
+    size_t propertyCreate(const HardValue& pkey, bool literal) {
+      auto index = this->propertyAppend(pkey, SoftValue(this->vm), nullptr, this->accessability, literal);
+      this->remember();
+      return index;
+    }
+    size_t propertyAppend(const HardValue& pkey, SoftValue&& pvalue, const Type& ptype, Accessability paccessability, bool literal) {
+      // The caller must have already checked that the key does not exist
+      // Only literal property names extend shapes; computed and index keys degrade us to a dictionary
+      auto index = this->slots.size();
+      String name;
+      if (literal && (this->shape != nullptr) && (index < VMObjectVanillaShape::MaximumSlots) && pkey->getString(name)) {
+        // Names from the compiler are already interned, so later lookups usually compare by address
+        this->shape = VMObjectVanillaObject::getShapes(this->vm).transition(*this->shape, name);
+        if (this->shape == nullptr) {
+          this->reindex();
+        } else {
+          assert(this->shape->getSlotCount() == index + 1);
+        }
+      } else {
+        this->degrade();
+      }
+      auto& slot = this->slots.emplace_back(SoftKey(this->vm, pkey), std::move(pvalue), ptype, paccessability);
+      if (this->shape == nullptr) {
+        this->dictionary.emplace(SoftKey(slot.key), index);
+      }
+      return index;
     }
-  protected:
-    std::map<SoftKey, SoftValue, SoftComparator>::iterator propertyCreate(const HardValue& pkey) {
-      auto pair = this->properties.emplace(std::piecewise_construct, std::forward_as_tuple(this->vm, pkey), std::forward_as_tuple(this->vm));
-      assert(pair.first != this->properties.end());
-      assert(pair.second);
-      this->keys.emplace_back(pair.first->first);
-      return pair.first;
-    }
-    Accessability propertyAccessibility(const HardValue& pkey) const {
-      auto afound = this->accessabilities.find(pkey);
-      if (afound == this->accessabilities.end()) {
-        return this->accessability;
-      }
-      return afound->second;
-    }
-    Type propertyType(const HardValue& pkey) const {
-      auto tfound = this->types.find(pkey);
-      if (tfound == this->types.end()) {
+    Type propertyType(size_t index) const {
+      if ((index == NotFound) || (this->slots[index].type == nullptr)) {
         return this->unknownType;
       }
-      return tfound->second;
+      return this->slots[index].type;
     }
-    bool hasAccessability(const HardValue& pkey, Accessability bits) const {
-      return Bits::hasAllSet(this->propertyAccessibility(pkey), bits);
+    bool hasAccessability(size_t index, Accessability bits) const {
+      auto accessability = (index == NotFound) ? this->accessability : this->slots[index].accessability;
+      return Bits::hasAllSet(accessability, bits);
     }
     void propertyEmplace(const HardValue& pkey, const Type& ptype, const HardValue* pvalue, Accessability paccessability) {
       // Only used during construction, so implicitly thread-safe
-      auto emplaced = this->properties.emplace(std::piecewise_construct, std::forward_as_tuple(this->vm, pkey), std::forward_as_tuple(this->vm));
-      assert(emplaced.first != this->properties.end());
-      assert(emplaced.second);
-      auto success = (pvalue == nullptr) || this->vm.setSoftValue(emplaced.first->second, *pvalue);
+      assert(this->propertyFind(pkey, nullptr) == NotFound);
+      SoftValue soft{ this->vm };
+      auto success = (pvalue == nullptr) || this->vm.setSoftValue(soft, *pvalue);
       if (success) {
-        this->keys.emplace_back(emplaced.first->first);
-        if (ptype != nullptr) {
-          this->types.emplace(std::piecewise_construct, std::forward_as_tuple(this->vm, pkey), std::forward_as_tuple(ptype));
-        }
-        if (paccessability != this->accessability) {
-          this->accessabilities.emplace(std::piecewise_construct, std::forward_as_tuple(this->vm, pkey), std::forward_as_tuple(paccessability));
-        }
-      } else {
-        this->properties.erase(emplaced.first);
+        (void)this->propertyAppend(pkey, std::move(soft), ptype, paccessability, true);
       }
       assert(success);
     }
+    void degrade() {
+      // Switch from shape-based lookup to a per-instance dictionary
+      if (this->shape != nullptr) {
+        this->shape = nullptr;
+        this->reindex();
+      }
+    }
+    void reindex() {
+      assert(this->shape == nullptr);
+      this->dictionary.clear();
+      for (size_t index = 0; index < this->slots.size(); ++index) {
+        this->dictionary.emplace(SoftKey(this->slots[index].key), index);
+      }
+    }
   private:
+    static VMObjectVanillaShapes& getShapes(IVM& vm) {
+      return static_cast<VMObjectVanillaShapes&>(vm.getObjectShapes());
+    }
     static Type determineUnknownType(const Type& runtimeType) {
       assert(runtimeType.validate());
       if (Bits::hasAnySet(runtimeType->getPrimitiveFlags(), ValueFlags::Object)) {
@@ -780,16 +1823,26 @@ namespace {
   class VMObjectVanillaKeyValue : public VMObjectVanillaObject {
     VMObjectVanillaKeyValue(const VMObjectVanillaKeyValue&) = delete;
     VMObjectVanillaKeyValue& operator=(const VMObjectVanillaKeyValue&) = delete;
+  public:
+    IteratorState cursor; // Only used by pairs rebound by 'VMObjectVanillaObject::vmIteratePairs()'
   protected:
     virtual void printPrefix(Printer& printer) const override {
       printer << "Key-value pair";
     }
   public:
     VMObjectVanillaKeyValue(IVM& vm, const HardValue& key, const HardValue& value, Accessability accessability)
-      : VMObjectVanillaObject(vm, Type::Object, accessability) {
+      : VMObjectVanillaObject(vm, Type::Object, accessability),
+        cursor() {
       this->propertyEmplace(this->vm.createHardValue("key"), key->getRuntimeType(), &key, Accessability::Get);
       this->propertyEmplace(this->vm.createHardValue("value"), value->getRuntimeType(), &value, Accessability::Get);
     }
+    void rebind(IVMExecution& execution, const HardValue& key, const HardValue& value) {
+      // Reuse the existing soft values rather than allocating new ones
+      auto success = this->slotSet(execution, 0, key) && this->slotSet(execution, 1, value);
+      assert(success);
+      (void)success;
+      this->remember();
+    }
   };
 
   class VMObjectVanillaManifestation : public VMObjectVanillaContainer {
@@ -848,6 +1901,7 @@ namespace {
         assert(pair.first != this->properties.end());
         assert(pair.second);
         pfound = pair.first;
+        this->remember();
       }
       if (!execution.setSoftValue(pfound->second, value)) {
         return this->raisePrefixError(execution, " cannot modify property '", property, "'");
@@ -868,6 +1922,7 @@ namespace {
         ftype(ftype),
         captures(std::move(captures)) {
       assert(this->ftype != nullptr);
+      this->adopt();
     }
     virtual void softVisit(ICollectable::IVisitor& visitor) const override {
       for (const auto& capture : this->captures) {
@@ -936,6 +1991,7 @@ namespace {
         ftype(ftype),
         runner(&runner) {
       assert(this->ftype != nullptr);
+      this->adopt();
     }
     virtual void softVisit(ICollectable::IVisitor& visitor) const override {
       if (this->runner != nullptr) {
@@ -958,6 +2014,10 @@ namespace {
     virtual HardValue vmIterate(IVMExecution& execution) override {
       return execution.createHardValueObject(HardObject{ this });
     }
+    virtual HardValue vmIterateNext(IVMExecution&, IterationCursor&) override {
+      // The generator keeps its own position
+      return this->next();
+    }
   private:
     enum class FetchOutcome { Yield, Break, Continue, Error };
     FetchOutcome fetch(HardValue& retval) {
@@ -1061,7 +2121,7 @@ namespace {
       return Type::Object;
     }
     virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      StringBuilder sb;
+      StringBuilder sb{ this->vm.getAllocator() };
       size_t n = arguments.getArgumentCount();
       String name;
       HardValue value;
@@ -1180,6 +2240,7 @@ namespace {
     VMObjectPointerBase(IVM& vm, Modifiability modifiability)
       : VMObjectBase(vm),
         modifiability(modifiability) {
+      this->adopt();
     }
     virtual int print(Printer& printer) const override {
       // TODO
@@ -1231,13 +2292,13 @@ namespace {
       return HardValue(this->alias);
     }
     virtual HardValue pointeeSet(IVMExecution& execution, const HardValue& value) {
-      if (this->alias.set(value.get())) {
+      if (this->alias.set(this->vm.getAllocator(), value.get())) {
         return this->raiseRuntimeError(execution, "Cannot assign value via pointer");
       }
       return HardValue::Void;
     }
     virtual HardValue pointeeMut(IVMExecution&, ValueMutationOp mutation, const HardValue& value) {
-      return this->alias.mutate(mutation, value.get());
+      return this->alias.mutate(this->vm.getAllocator(), mutation, value.get());
     }
   };
 
@@ -1251,7 +2312,7 @@ namespace {
   public:
     VMObjectPointerToIndex(IVM& vm, const HardObject& instance, const HardValue& index, Modifiability modifiability, const Type& pointerType)
       : VMObjectPointerBase(vm, modifiability),
-        instance(vm, instance),
+        instance(vm, *this, instance),
         index(vm),
       pointerType(pointerType) {
       this->vm.setSoftValue(this->index, index); // cloned
@@ -1285,7 +2346,7 @@ namespace {
   public:
     VMObjectPointerToProperty(IVM& vm, const HardObject& instance, const HardValue& property, Modifiability modifiability, const Type& pointerType)
       : VMObjectPointerBase(vm, modifiability),
-        instance(vm, instance),
+        instance(vm, *this, instance),
         property(vm),
         pointerType(pointerType) {
       this->vm.setSoftValue(this->property, property); // cloned
@@ -1309,432 +2370,321 @@ namespace {
     }
   };
 
-  class VMStringProxyBase : public VMObjectBase {
-    VMStringProxyBase(const VMStringProxyBase&) = delete;
-    VMStringProxyBase& operator=(const VMStringProxyBase&) = delete;
-  protected:
-    String instance;
-    const char* proxy;
-    virtual void printPrefix(Printer& printer) const override {
-      printer << "String property '" << this->proxy << "()'";
-    }
+  class VMStringMethodCall {
+    VMStringMethodCall(const VMStringMethodCall&) = delete;
+    VMStringMethodCall& operator=(const VMStringMethodCall&) = delete;
   public:
-    VMStringProxyBase(IVM& vm, const String& instance, const char* proxy)
-      : VMObjectBase(vm),
-        instance(instance),
-        proxy(proxy) {
-      assert(this->proxy != nullptr);
+    IVM& vm;
+    IVMExecution& execution;
+    const StringMethod& method;
+    const String& instance;
+    VMStringMethodCall(IVM& vm, IVMExecution& execution, const StringMethod& method, const String& instance)
+      : vm(vm),
+        execution(execution),
+        method(method),
+        instance(instance) {
     }
-    virtual void softVisit(ICollectable::IVisitor&) const override {
-      // No soft links
+    template<typename... ARGS>
+    HardValue raisePrefixError(ARGS&&... args) {
+      StringBuilder sb{ this->vm.getAllocator() };
+      sb.add("String property '", this->method.name, "()'", std::forward<ARGS>(args)...);
+      return this->execution.raiseRuntimeError(sb.build(this->vm.getAllocator()), nullptr);
     }
-    virtual int print(Printer& printer) const override {
-      printer << "[string proxy " << this->proxy << "]"; // TODO
-      return 0;
+    template<HardValue(*HANDLER)(VMStringMethodCall&, const ICallArguments&)>
+    static HardValue handler(IVM& vm, IVMExecution& execution, const StringMethod& method, const String& instance, const ICallArguments& arguments) {
+      VMStringMethodCall call(vm, execution, method, instance);
+      return HANDLER(call, arguments);
     }
   };
 
-  class VMStringProxyCompareTo : public VMStringProxyBase {
-    VMStringProxyCompareTo(const VMStringProxyCompareTo&) = delete;
-    VMStringProxyCompareTo& operator=(const VMStringProxyCompareTo&) = delete;
-  public:
-    VMStringProxyCompareTo(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "compareTo") {
+  HardValue stringCompareTo(VMStringMethodCall& call, const ICallArguments& arguments) {
+    HardValue argument;
+    if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
+      return call.raisePrefixError(" expects one argument");
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
-    }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      HardValue argument;
-      if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
-        return this->raisePrefixError(execution, " expects one argument");
-      }
-      String other;
-      if (!argument->getString(other)) {
-        return this->raisePrefixError(execution, " expects its argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      return execution.createHardValueInt(this->instance.compareTo(other));
+    String other;
+    if (!argument->getString(other)) {
+      return call.raisePrefixError(" expects its argument to be a 'string', but instead got ", describe(argument.get()));
     }
-  };
+    return call.execution.createHardValueInt(call.instance.compareTo(other));
+  }
 
-  class VMStringProxyContains : public VMStringProxyBase {
-    VMStringProxyContains(const VMStringProxyContains&) = delete;
-    VMStringProxyContains& operator=(const VMStringProxyContains&) = delete;
-  public:
-    VMStringProxyContains(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "contains") {
-    }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+  HardValue stringContains(VMStringMethodCall& call, const ICallArguments& arguments) {
+    HardValue argument;
+    if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
+      return call.raisePrefixError(" expects one argument");
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      HardValue argument;
-      if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
-        return this->raisePrefixError(execution, " expects one argument");
-      }
-      String needle;
-      if (!argument->getString(needle)) {
-        return this->raisePrefixError(execution, " expects its argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      return execution.createHardValueBool(this->instance.contains(needle));
+    String needle;
+    if (!argument->getString(needle)) {
+      return call.raisePrefixError(" expects its argument to be a 'string', but instead got ", describe(argument.get()));
     }
-  };
+    return call.execution.createHardValueBool(call.instance.contains(needle));
+  }
 
-  class VMStringProxyEndsWith : public VMStringProxyBase {
-    VMStringProxyEndsWith(const VMStringProxyEndsWith&) = delete;
-    VMStringProxyEndsWith& operator=(const VMStringProxyEndsWith&) = delete;
-  public:
-    VMStringProxyEndsWith(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "endsWith") {
-    }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+  HardValue stringEndsWith(VMStringMethodCall& call, const ICallArguments& arguments) {
+    HardValue argument;
+    if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
+      return call.raisePrefixError(" expects one argument");
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      HardValue argument;
-      if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
-        return this->raisePrefixError(execution, " expects one argument");
-      }
-      String needle;
-      if (!argument->getString(needle)) {
-        return this->raisePrefixError(execution, " expects its argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      return execution.createHardValueBool(this->instance.endsWith(needle));
+    String needle;
+    if (!argument->getString(needle)) {
+      return call.raisePrefixError(" expects its argument to be a 'string', but instead got ", describe(argument.get()));
     }
-  };
+    return call.execution.createHardValueBool(call.instance.endsWith(needle));
+  }
 
-  class VMStringProxyHash : public VMStringProxyBase {
-    VMStringProxyHash(const VMStringProxyHash&) = delete;
-    VMStringProxyHash& operator=(const VMStringProxyHash&) = delete;
-  public:
-    VMStringProxyHash(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "hash") {
-    }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
-    }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      if (arguments.getArgumentCount() != 0) {
-        return this->raisePrefixError(execution, " expects no arguments");
-      }
-      return execution.createHardValueInt(Int(this->instance.hash()));
+  HardValue stringHash(VMStringMethodCall& call, const ICallArguments& arguments) {
+    if (arguments.getArgumentCount() != 0) {
+      return call.raisePrefixError(" expects no arguments");
     }
-  };
+    return call.execution.createHardValueInt(Int(call.instance.hash()));
+  }
 
-  class VMStringProxyIndexOf : public VMStringProxyBase {
-    VMStringProxyIndexOf(const VMStringProxyIndexOf&) = delete;
-    VMStringProxyIndexOf& operator=(const VMStringProxyIndexOf&) = delete;
-  public:
-    VMStringProxyIndexOf(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "indexOf") {
+  HardValue stringIndexOf(VMStringMethodCall& call, const ICallArguments& arguments) {
+    auto count = arguments.getArgumentCount();
+    if ((count < 1) || (count > 2)) {
+      return call.raisePrefixError(" expects one or two arguments, but instead got ", count);
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    HardValue argument;
+    String needle;
+    if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getString(needle)) {
+      return call.raisePrefixError(" expects its first argument to be a 'string', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      auto count = arguments.getArgumentCount();
-      if ((count < 1) || (count > 2)) {
-        return this->raisePrefixError(execution, " expects one or two arguments, but instead got ", count);
-      }
-      HardValue argument;
-      String needle;
-      if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getString(needle)) {
-        return this->raisePrefixError(execution, " expects its first argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      Int retval;
-      if (arguments.getArgumentValueByIndex(1, argument)) {
-        Int fromIndex;
-        if (!argument->getInt(fromIndex)) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be an 'int', but instead got ", describe(argument.get()));
-        }
-        if (fromIndex < 0) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be a non-negative integer, but instead got ", fromIndex);
-        }
-        retval = this->instance.indexOfString(needle, size_t(fromIndex));
-      } else {
-        retval = this->instance.indexOfString(needle);
+    Int retval;
+    if (arguments.getArgumentValueByIndex(1, argument)) {
+      Int fromIndex;
+      if (!argument->getInt(fromIndex)) {
+        return call.raisePrefixError(" expects its optional second argument to be an 'int', but instead got ", describe(argument.get()));
       }
-      if (retval < 0) {
-        return HardValue::Null;
+      if (fromIndex < 0) {
+        return call.raisePrefixError(" expects its optional second argument to be a non-negative integer, but instead got ", fromIndex);
       }
-      return execution.createHardValueInt(retval);
+      retval = call.instance.indexOfString(needle, size_t(fromIndex));
+    } else {
+      retval = call.instance.indexOfString(needle);
     }
-  };
-
-  class VMStringProxyJoin : public VMStringProxyBase {
-    VMStringProxyJoin(const VMStringProxyJoin&) = delete;
-    VMStringProxyJoin& operator=(const VMStringProxyJoin&) = delete;
-  public:
-    VMStringProxyJoin(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "join") {
-    }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    if (retval < 0) {
+      return HardValue::Null;
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      // OPTIMIZE
-      StringBuilder sb;
-      HardValue argument;
-      for (size_t index = 0; arguments.getArgumentValueByIndex(index, argument); ++index) {
-        if (index > 0) {
-          sb.add(this->instance);
-        }
-        sb.add(argument);
+    return call.execution.createHardValueInt(retval);
+  }
+
+  HardValue stringJoin(VMStringMethodCall& call, const ICallArguments& arguments) {
+    StringBuilder sb{ call.vm.getAllocator() };
+    HardValue argument;
+    for (size_t index = 0; arguments.getArgumentValueByIndex(index, argument); ++index) {
+      if (index > 0) {
+        sb.add(call.instance);
       }
-      return execution.createHardValueString(sb.build(this->vm.getAllocator()));
+      sb.add(argument);
     }
-  };
+    return call.execution.createHardValueString(sb.build(call.vm.getAllocator()));
+  }
 
-  class VMStringProxyLastIndexOf : public VMStringProxyBase {
-    VMStringProxyLastIndexOf(const VMStringProxyLastIndexOf&) = delete;
-    VMStringProxyLastIndexOf& operator=(const VMStringProxyLastIndexOf&) = delete;
-  public:
-    VMStringProxyLastIndexOf(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "lastIndexOf") {
+  HardValue stringLastIndexOf(VMStringMethodCall& call, const ICallArguments& arguments) {
+    auto count = arguments.getArgumentCount();
+    if ((count < 1) || (count > 2)) {
+      return call.raisePrefixError(" expects one or two arguments, but instead got ", count);
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    HardValue argument;
+    String needle;
+    if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getString(needle)) {
+      return call.raisePrefixError(" expects its first argument to be a 'string', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      auto count = arguments.getArgumentCount();
-      if ((count < 1) || (count > 2)) {
-        return this->raisePrefixError(execution, " expects one or two arguments, but instead got ", count);
-      }
-      HardValue argument;
-      String needle;
-      if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getString(needle)) {
-        return this->raisePrefixError(execution, " expects its first argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      Int retval;
-      if (arguments.getArgumentValueByIndex(1, argument)) {
-        Int fromIndex;
-        if (!argument->getInt(fromIndex)) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be an 'int', but instead got ", describe(argument.get()));
-        }
-        if (fromIndex < 0) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be a non-negative integer, but instead got ", fromIndex);
-        }
-        retval = this->instance.lastIndexOfString(needle, size_t(fromIndex));
-      } else {
-        retval = this->instance.lastIndexOfString(needle);
+    Int retval;
+    if (arguments.getArgumentValueByIndex(1, argument)) {
+      Int fromIndex;
+      if (!argument->getInt(fromIndex)) {
+        return call.raisePrefixError(" expects its optional second argument to be an 'int', but instead got ", describe(argument.get()));
       }
-      if (retval < 0) {
-        return HardValue::Null;
+      if (fromIndex < 0) {
+        return call.raisePrefixError(" expects its optional second argument to be a non-negative integer, but instead got ", fromIndex);
       }
-      return execution.createHardValueInt(retval);
+      retval = call.instance.lastIndexOfString(needle, size_t(fromIndex));
+    } else {
+      retval = call.instance.lastIndexOfString(needle);
     }
-  };
+    if (retval < 0) {
+      return HardValue::Null;
+    }
+    return call.execution.createHardValueInt(retval);
+  }
 
-  class VMStringProxyPadLeft : public VMStringProxyBase {
-    VMStringProxyPadLeft(const VMStringProxyPadLeft&) = delete;
-    VMStringProxyPadLeft& operator=(const VMStringProxyPadLeft&) = delete;
-  public:
-    VMStringProxyPadLeft(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "padLeft") {
+  HardValue stringPadLeft(VMStringMethodCall& call, const ICallArguments& arguments) {
+    auto count = arguments.getArgumentCount();
+    if ((count < 1) || (count > 2)) {
+      return call.raisePrefixError(" expects one or two arguments, but instead got ", count);
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    HardValue argument;
+    Int target;
+    if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getInt(target)) {
+      return call.raisePrefixError(" expects its first argument to be an 'int', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      auto count = arguments.getArgumentCount();
-      if ((count < 1) || (count > 2)) {
-        return this->raisePrefixError(execution, " expects one or two arguments, but instead got ", count);
-      }
-      HardValue argument;
-      Int target;
-      if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getInt(target)) {
-        return this->raisePrefixError(execution, " expects its first argument to be an 'int', but instead got ", describe(argument.get()));
-      }
-      if (target < 0) {
-        return this->raisePrefixError(execution, " expects its first argument to be a non-negative integer, but instead got ", target);
-      }
-      if (arguments.getArgumentValueByIndex(1, argument)) {
-        String padding;
-        if (!argument->getString(padding)) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be a 'string', but instead got ", describe(argument.get()));
-        }
-        return execution.createHardValueString(this->instance.padLeft(this->vm.getAllocator(), size_t(target), padding));
+    if (target < 0) {
+      return call.raisePrefixError(" expects its first argument to be a non-negative integer, but instead got ", target);
+    }
+    if (arguments.getArgumentValueByIndex(1, argument)) {
+      String padding;
+      if (!argument->getString(padding)) {
+        return call.raisePrefixError(" expects its optional second argument to be a 'string', but instead got ", describe(argument.get()));
       }
-      return execution.createHardValueString(this->instance.padLeft(this->vm.getAllocator(), size_t(target)));
+      return call.execution.createHardValueString(call.instance.padLeft(call.vm.getAllocator(), size_t(target), padding));
     }
-  };
+    return call.execution.createHardValueString(call.instance.padLeft(call.vm.getAllocator(), size_t(target)));
+  }
 
-  class VMStringProxyPadRight : public VMStringProxyBase {
-    VMStringProxyPadRight(const VMStringProxyPadRight&) = delete;
-    VMStringProxyPadRight& operator=(const VMStringProxyPadRight&) = delete;
-  public:
-    VMStringProxyPadRight(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "padRight") {
+  HardValue stringPadRight(VMStringMethodCall& call, const ICallArguments& arguments) {
+    auto count = arguments.getArgumentCount();
+    if ((count < 1) || (count > 2)) {
+      return call.raisePrefixError(" expects one or two arguments, but instead got ", count);
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    HardValue argument;
+    Int target;
+    if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getInt(target)) {
+      return call.raisePrefixError(" expects its first argument to be an 'int', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      auto count = arguments.getArgumentCount();
-      if ((count < 1) || (count > 2)) {
-        return this->raisePrefixError(execution, " expects one or two arguments, but instead got ", count);
-      }
-      HardValue argument;
-      Int target;
-      if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getInt(target)) {
-        return this->raisePrefixError(execution, " expects its first argument to be an 'int', but instead got ", describe(argument.get()));
-      }
-      if (target < 0) {
-        return this->raisePrefixError(execution, " expects its first argument to be a non-negative integer, but instead got ", target);
-      }
-      if (arguments.getArgumentValueByIndex(1, argument)) {
-        String padding;
-        if (!argument->getString(padding)) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be a 'string', but instead got ", describe(argument.get()));
-        }
-        return execution.createHardValueString(this->instance.padRight(this->vm.getAllocator(), size_t(target), padding));
+    if (target < 0) {
+      return call.raisePrefixError(" expects its first argument to be a non-negative integer, but instead got ", target);
+    }
+    if (arguments.getArgumentValueByIndex(1, argument)) {
+      String padding;
+      if (!argument->getString(padding)) {
+        return call.raisePrefixError(" expects its optional second argument to be a 'string', but instead got ", describe(argument.get()));
       }
-      return execution.createHardValueString(this->instance.padRight(this->vm.getAllocator(), size_t(target)));
+      return call.execution.createHardValueString(call.instance.padRight(call.vm.getAllocator(), size_t(target), padding));
     }
-  };
+    return call.execution.createHardValueString(call.instance.padRight(call.vm.getAllocator(), size_t(target)));
+  }
 
-  class VMStringProxyRepeat : public VMStringProxyBase {
-    VMStringProxyRepeat(const VMStringProxyRepeat&) = delete;
-    VMStringProxyRepeat& operator=(const VMStringProxyRepeat&) = delete;
-  public:
-    VMStringProxyRepeat(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "repeat") {
+  HardValue stringRepeat(VMStringMethodCall& call, const ICallArguments& arguments) {
+    HardValue argument;
+    if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
+      return call.raisePrefixError(" expects one argument");
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    Int count;
+    if (!argument->getInt(count)) {
+      return call.raisePrefixError(" expects its argument to be an 'int', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      HardValue argument;
-      if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
-        return this->raisePrefixError(execution, " expects one argument");
-      }
-      Int count;
-      if (!argument->getInt(count)) {
-        return this->raisePrefixError(execution, " expects its argument to be an 'int', but instead got ", describe(argument.get()));
-      }
-      if (count < 0) {
-        return this->raisePrefixError(execution, " expects its argument to be a non-negative integer, but instead got ", count);
-      }
-      return execution.createHardValueString(this->instance.repeat(this->vm.getAllocator(), size_t(count)));
+    if (count < 0) {
+      return call.raisePrefixError(" expects its argument to be a non-negative integer, but instead got ", count);
     }
-  };
+    return call.execution.createHardValueString(call.instance.repeat(call.vm.getAllocator(), size_t(count)));
+  }
 
-  class VMStringProxyReplace : public VMStringProxyBase {
-    VMStringProxyReplace(const VMStringProxyReplace&) = delete;
-    VMStringProxyReplace& operator=(const VMStringProxyReplace&) = delete;
-  public:
-    VMStringProxyReplace(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "replace") {
+  HardValue stringReplace(VMStringMethodCall& call, const ICallArguments& arguments) {
+    auto count = arguments.getArgumentCount();
+    if ((count < 2) || (count > 3)) {
+      return call.raisePrefixError(" expects two or three arguments, but instead got ", count);
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    HardValue argument;
+    String needle;
+    if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getString(needle)) {
+      return call.raisePrefixError(" expects its first argument to be a 'string', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      auto count = arguments.getArgumentCount();
-      if ((count < 2) || (count > 3)) {
-        return this->raisePrefixError(execution, " expects two or three arguments, but instead got ", count);
-      }
-      HardValue argument;
-      String needle;
-      if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getString(needle)) {
-        return this->raisePrefixError(execution, " expects its first argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      String replacement;
-      if (!arguments.getArgumentValueByIndex(1, argument) || !argument->getString(replacement)) {
-        return this->raisePrefixError(execution, " expects its second argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      Int occurrences = std::numeric_limits<Int>::max();
-      if (arguments.getArgumentValueByIndex(2, argument)) {
-        if (!argument->getInt(occurrences)) {
-          return this->raisePrefixError(execution, " expects its optional third argument to be an 'int', but instead got ", describe(argument.get()));
-        }
+    String replacement;
+    if (!arguments.getArgumentValueByIndex(1, argument) || !argument->getString(replacement)) {
+      return call.raisePrefixError(" expects its second argument to be a 'string', but instead got ", describe(argument.get()));
+    }
+    Int occurrences = std::numeric_limits<Int>::max();
+    if (arguments.getArgumentValueByIndex(2, argument)) {
+      if (!argument->getInt(occurrences)) {
+        return call.raisePrefixError(" expects its optional third argument to be an 'int', but instead got ", describe(argument.get()));
       }
-      return execution.createHardValueString(this->instance.replace(this->vm.getAllocator(), needle, replacement, occurrences));
     }
-  };
+    return call.execution.createHardValueString(call.instance.replace(call.vm.getAllocator(), needle, replacement, occurrences));
+  }
 
-  class VMStringProxySlice : public VMStringProxyBase {
-    VMStringProxySlice(const VMStringProxySlice&) = delete;
-    VMStringProxySlice& operator=(const VMStringProxySlice&) = delete;
-  public:
-    VMStringProxySlice(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "slice") {
+  HardValue stringSlice(VMStringMethodCall& call, const ICallArguments& arguments) {
+    auto count = arguments.getArgumentCount();
+    if ((count < 1) || (count > 2)) {
+      return call.raisePrefixError(" expects one or two arguments, but instead got ", count);
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    HardValue argument;
+    Int begin;
+    if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getInt(begin)) {
+      return call.raisePrefixError(" expects its first argument to be an 'int', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      auto count = arguments.getArgumentCount();
-      if ((count < 1) || (count > 2)) {
-        return this->raisePrefixError(execution, " expects one or two arguments, but instead got ", count);
-      }
-      HardValue argument;
-      Int begin;
-      if (!arguments.getArgumentValueByIndex(0, argument) || !argument->getInt(begin)) {
-        return this->raisePrefixError(execution, " expects its first argument to be an 'int', but instead got ", describe(argument.get()));
-      }
-      Int end = std::numeric_limits<Int>::max();
-      if (arguments.getArgumentValueByIndex(1, argument)) {
-        if (!argument->getInt(end)) {
-          return this->raisePrefixError(execution, " expects its optional second argument to be an 'int', but instead got ", describe(argument.get()));
-        }
+    Int end = std::numeric_limits<Int>::max();
+    if (arguments.getArgumentValueByIndex(1, argument)) {
+      if (!argument->getInt(end)) {
+        return call.raisePrefixError(" expects its optional second argument to be an 'int', but instead got ", describe(argument.get()));
       }
-      return execution.createHardValueString(this->instance.slice(this->vm.getAllocator(), begin, end));
     }
-  };
+    return call.execution.createHardValueString(call.instance.slice(call.vm.getAllocator(), begin, end));
+  }
 
-  class VMStringProxyStartsWith : public VMStringProxyBase {
-    VMStringProxyStartsWith(const VMStringProxyStartsWith&) = delete;
-    VMStringProxyStartsWith& operator=(const VMStringProxyStartsWith&) = delete;
-  public:
-    VMStringProxyStartsWith(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "startsWith") {
+  HardValue stringStartsWith(VMStringMethodCall& call, const ICallArguments& arguments) {
+    HardValue argument;
+    if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
+      return call.raisePrefixError(" expects one argument");
     }
-    virtual Type vmRuntimeType() override {
-      // TODO
-      return Type::Object;
+    String needle;
+    if (!argument->getString(needle)) {
+      return call.raisePrefixError(" expects its argument to be a 'string', but instead got ", describe(argument.get()));
     }
-    virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      HardValue argument;
-      if ((arguments.getArgumentCount() != 1) || !arguments.getArgumentValueByIndex(0, argument)) {
-        return this->raisePrefixError(execution, " expects one argument");
-      }
-      String needle;
-      if (!argument->getString(needle)) {
-        return this->raisePrefixError(execution, " expects its argument to be a 'string', but instead got ", describe(argument.get()));
-      }
-      return execution.createHardValueBool(this->instance.startsWith(needle));
+    return call.execution.createHardValueBool(call.instance.startsWith(needle));
+  }
+
+  HardValue stringToString(VMStringMethodCall& call, const ICallArguments& arguments) {
+    if (arguments.getArgumentCount() != 0) {
+      return call.raisePrefixError(" expects no arguments");
     }
+    return call.execution.createHardValueString(call.instance);
+  }
+
+  const StringMethod stringMethods[] = {
+    { "compareTo", VMStringMethodCall::handler<stringCompareTo> },
+    { "contains", VMStringMethodCall::handler<stringContains> },
+    { "endsWith", VMStringMethodCall::handler<stringEndsWith> },
+    { "hash", VMStringMethodCall::handler<stringHash> },
+    { "indexOf", VMStringMethodCall::handler<stringIndexOf> },
+    { "join", VMStringMethodCall::handler<stringJoin> },
+    { "lastIndexOf", VMStringMethodCall::handler<stringLastIndexOf> },
+    { "padLeft", VMStringMethodCall::handler<stringPadLeft> },
+    { "padRight", VMStringMethodCall::handler<stringPadRight> },
+    { "repeat", VMStringMethodCall::handler<stringRepeat> },
+    { "replace", VMStringMethodCall::handler<stringReplace> },
+    { "slice", VMStringMethodCall::handler<stringSlice> },
+    { "startsWith", VMStringMethodCall::handler<stringStartsWith> },
+    { "toString", VMStringMethodCall::handler<stringToString> }
   };
 
-  class VMStringProxyToString : public VMStringProxyBase {
-    VMStringProxyToString(const VMStringProxyToString&) = delete;
-    VMStringProxyToString& operator=(const VMStringProxyToString&) = delete;
+  class VMStringProxy : public VMObjectBase {
+    VMStringProxy(const VMStringProxy&) = delete;
+    VMStringProxy& operator=(const VMStringProxy&) = delete;
+  private:
+    String instance;
+    const StringMethod& method;
+  protected:
+    virtual void printPrefix(Printer& printer) const override {
+      printer << "String property '" << this->method.name << "()'";
+    }
   public:
-    VMStringProxyToString(IVM& vm, const String& instance)
-      : VMStringProxyBase(vm, instance, "toString") {
+    VMStringProxy(IVM& vm, const String& instance, const StringMethod& method)
+      : VMObjectBase(vm),
+        instance(instance),
+        method(method) {
+      assert(this->method.name != nullptr);
+      assert(this->method.handler != nullptr);
+    }
+    virtual void softVisit(ICollectable::IVisitor&) const override {
+      // No soft links
+    }
+    virtual int print(Printer& printer) const override {
+      // Prints the bound receiver and method name, e.g. '[string proxy "hello".indexOf]'
+      Print::Options options{ printer.options };
+      options.quote = '"';
+      Printer inner{ printer.stream, options };
+      inner << "[string proxy " << this->instance << '.' << this->method.name << ']';
+      return 0;
     }
     virtual Type vmRuntimeType() override {
       // TODO
       return Type::Object;
     }
     virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      if (arguments.getArgumentCount() != 0) {
-        return this->raisePrefixError(execution, " expects no arguments");
-      }
-      return execution.createHardValueString(this->instance);
+      // Proxies are only materialized when the method is used as a first-class value (e.g. 'var f = s.indexOf;')
+      return this->method.call(this->vm, execution, this->instance, arguments);
     }
   };
 
@@ -1871,7 +2821,7 @@ namespace {
       if (arguments.getArgumentValueByIndex(0, value)) {
         Print::Options options{};
         options.names = false;
-        StringBuilder sb{ options };
+        StringBuilder sb{ this->vm.getAllocator(), options };
         sb << value->getRuntimeType();
         return this->vm.createHardValueString(sb.build(this->vm.getAllocator()));
       }
@@ -1944,16 +2894,30 @@ namespace {
       this->type = forge.forgeShapeType(forge.forgeStringShape());
     }
     virtual HardValue vmCall(IVMExecution& execution, const ICallArguments& arguments) override {
-      // Constructor calls
-      StringBuilder sb;
+      // Constructor calls: string arguments are concatenated without copying so that 'string(s, ...)' in a loop isn't quadratic
+      auto& allocator = this->vm.getAllocator();
+      String result;
+      StringBuilder sb{ allocator };
       size_t count = arguments.getArgumentCount();
       for (size_t index = 0; index < count; ++index) {
         HardValue value;
         if (arguments.getArgumentValueByIndex(index, value)) {
-          sb.add(value);
+          String text;
+          if (value->getString(text)) {
+            if (!sb.empty()) {
+              result = result.concat(allocator, sb.build(allocator));
+              sb.clear();
+            }
+            result = result.concat(allocator, text);
+          } else {
+            sb.add(value);
+          }
         }
       }
-      return execution.createHardValueString(sb.build(this->vm.getAllocator()));
+      if (!sb.empty()) {
+        result = result.concat(allocator, sb.build(allocator));
+      }
+      return execution.createHardValueString(result);
     }
     virtual const char* getManifestationName() const override {
       return "string";
@@ -2278,36 +3242,79 @@ namespace {
 }
 
 VMObjectVanillaMutex::ReadLock::ReadLock(VMObjectVanillaMutex& mutex)
-  : lock(mutex.mutex),
-    modifications(mutex.modifications) {
+  : mutex(mutex),
+    lock(mutex.mutex, std::defer_lock),
+    modifications(mutex.acquire(this->lock)) {
+}
+
+VMObjectVanillaMutex::ReadLock::~ReadLock() {
+  if (!this->lock.owns_lock()) {
+    this->mutex.leave();
+  }
 }
 
 VMObjectVanillaMutex::WriteLock::WriteLock(VMObjectVanillaMutex& mutex)
   : mutex(mutex),
-    lock(mutex.mutex),
+    lock(mutex.mutex, std::defer_lock),
+    modifications(mutex.acquire(this->lock)),
     modified(false) {
 }
 
 VMObjectVanillaMutex::WriteLock::~WriteLock() {
+  // Modification counters are maintained whether or not the lock was taken, so iterators still notice mutation
   if (this->modified) {
     this->mutex.modifications++;
   }
+  if (!this->lock.owns_lock()) {
+    this->mutex.leave();
+  }
 }
 
-egg::ovum::HardValue VMObjectVanillaArray::vmIterate(IVMExecution& execution) {
+egg::ovum::HardValue VMObjectVanillaObject::vmIterate(IVMExecution& execution) {
   VMObjectVanillaMutex::ReadLock lock{ this->mutex };
-  auto iterator = makeHardObject<VMObjectVanillaArrayIterator>(this->vm, *this, lock);
+  auto iterator = makeHardObject<VMObjectVanillaObjectIterator>(this->vm, *this, lock);
   return execution.createHardValueObject(iterator);
 }
 
-egg::ovum::HardValue VMObjectVanillaObject::vmIterate(IVMExecution& execution) {
+egg::ovum::HardValue VMObjectVanillaObject::vmIteratePairs(IVMExecution& execution, HardValue& pair) {
+  // Walks the slots directly, rebinding a single key-value pair for the whole iteration
   VMObjectVanillaMutex::ReadLock lock{ this->mutex };
-  auto iterator = makeHardObject<VMObjectVanillaObjectIterator>(this->vm, *this, lock);
-  return execution.createHardValueObject(iterator);
+  VMObjectVanillaKeyValue* kv;
+  HardObject object;
+  if (pair->getHardObject(object)) {
+    kv = static_cast<VMObjectVanillaKeyValue*>(object.get());
+    assert(dynamic_cast<VMObjectVanillaKeyValue*>(object.get()) == kv);
+    if (lock.modifications != kv->cursor.modifications) {
+      return this->raisePrefixError(execution, " has been modified during iteration");
+    }
+  } else {
+    kv = nullptr;
+  }
+  auto index = (kv == nullptr) ? 0 : kv->cursor.index;
+  if (index >= this->slots.size()) {
+    return HardValue::Void;
+  }
+  const auto& slot = this->slots[index];
+  auto key = this->vm.getSoftKey(slot.key);
+  auto value = this->vm.getSoftValue(slot.value);
+  if (kv == nullptr) {
+    object = makeHardObject<VMObjectVanillaKeyValue>(this->vm, key, value, Accessability::Get);
+    kv = static_cast<VMObjectVanillaKeyValue*>(object.get());
+    kv->cursor.modifications = lock.modifications;
+    pair = execution.createHardValueObject(object);
+  } else {
+    kv->rebind(execution, key, value);
+  }
+  kv->cursor.index = index + 1;
+  return pair;
+}
+
+egg::ovum::SoftObject::SoftObject(IVM& vm, const ICollectable& owner, const HardObject& instance)
+  : SoftPtr(vm.acquireSoftObject(owner, instance.get())) {
 }
 
-egg::ovum::SoftObject::SoftObject(IVM& vm, const HardObject& instance)
-  : SoftPtr(vm.acquireSoftObject(instance.get())) {
+egg::ovum::HardPtr<egg::ovum::IObjectShapes> egg::ovum::ObjectFactory::createObjectShapes(IAllocator& allocator) {
+  return HardPtr<IObjectShapes>(allocator.makeRaw<VMObjectVanillaShapes>(allocator));
 }
 
 egg::ovum::HardObject egg::ovum::ObjectFactory::createBuiltinAssert(IVM& vm) {
@@ -2330,9 +3337,22 @@ egg::ovum::HardObject egg::ovum::ObjectFactory::createBuiltinSymtable(IVM& vm) {
   return makeHardObject<VMObjectBuiltinSymtable>(vm);
 }
 
-egg::ovum::HardObject egg::ovum::ObjectFactory::createVanillaArray(IVM& vm, const Type& elementType, Accessability accessability) {
+egg::ovum::HardObject egg::ovum::ObjectFactory::createVanillaArray(IVM& vm, const Type& elementType, Accessability accessability, bool declared) {
   auto containerType = vm.getTypeForge().forgeArrayType(elementType, accessability);
-  return makeHardObject<VMObjectVanillaArray>(vm, containerType, elementType, accessability);
+  // Arrays of primitives hold their elements unboxed, but only if the element type was declared and can therefore be enforced
+  if (!declared) {
+    return makeHardObject<VMObjectVanillaArray<VMObjectVanillaArraySoftStorage>>(vm, containerType, elementType, accessability);
+  }
+  if (elementType == Type::Int) {
+    return makeHardObject<VMObjectVanillaArray<VMObjectVanillaArrayUnboxedStorage<Int>>>(vm, containerType, elementType, accessability);
+  }
+  if (elementType == Type::Float) {
+    return makeHardObject<VMObjectVanillaArray<VMObjectVanillaArrayUnboxedStorage<Float>>>(vm, containerType, elementType, accessability);
+  }
+  if (elementType == Type::Bool) {
+    return makeHardObject<VMObjectVanillaArray<VMObjectVanillaArrayUnboxedStorage<Bool>>>(vm, containerType, elementType, accessability);
+  }
+  return makeHardObject<VMObjectVanillaArray<VMObjectVanillaArraySoftStorage>>(vm, containerType, elementType, accessability);
 }
 
 egg::ovum::HardObject egg::ovum::ObjectFactory::createVanillaObject(IVM& vm, const Type& runtimeType, Accessability accessability) {
@@ -2364,60 +3384,21 @@ egg::ovum::HardObject egg::ovum::ObjectFactory::createPointerToProperty(IVM& vm,
   return makeHardObject<VMObjectPointerToProperty>(vm, instance, property, modifiability, pointerType);
 }
 
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyCompareTo(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyCompareTo>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyContains(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyContains>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyEndsWith(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyEndsWith>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyHash(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyHash>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyIndexOf(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyIndexOf>(vm, instance);
+egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxy(IVM& vm, const String& instance, const StringMethod& method) {
+  return makeHardObject<VMStringProxy>(vm, instance, method);
 }
 
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyJoin(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyJoin>(vm, instance);
+egg::ovum::HardValue egg::ovum::StringMethod::call(IVM& vm, IVMExecution& execution, const String& instance, const ICallArguments& arguments) const {
+  return this->handler(vm, execution, *this, instance, arguments);
 }
 
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyLastIndexOf(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyLastIndexOf>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyPadLeft(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyPadLeft>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyPadRight(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyPadRight>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyRepeat(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyRepeat>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyReplace(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyReplace>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxySlice(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxySlice>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyStartsWith(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyStartsWith>(vm, instance);
-}
-
-egg::ovum::HardObject egg::ovum::ObjectFactory::createStringProxyToString(IVM& vm, const String& instance) {
-  return makeHardObject<VMStringProxyToString>(vm, instance);
+const egg::ovum::StringMethod* egg::ovum::StringMethod::find(const String& name) {
+  for (auto& method : stringMethods) {
+    if (name.equals(method.name)) {
+      return &method;
+    }
+  }
+  return nullptr;
 }
 
 egg::ovum::HardObject egg::ovum::ObjectFactory::createManifestationType(IVM& vm) {
@@ -27,7 +27,7 @@ namespace egg::ovum {
     SoftObject(const SoftObject&) = delete;
     SoftObject& operator=(const SoftObject&) = delete;
   public:
-    SoftObject(IVM& vm, const HardObject& instance);
+    SoftObject(IVM& vm, const ICollectable& owner, const HardObject& instance);
     bool validate() const {
       auto* object = this->get();
       return (object != nullptr) && object->validate();
@@ -45,6 +45,22 @@ namespace egg::ovum {
     virtual HardObject build() = 0;
   };
 
+  class IObjectShapes : public IHardAcquireRelease {
+  public:
+    // Interface
+    virtual size_t getShapeCount() const = 0;
+  };
+
+  class StringMethod {
+  public:
+    // Native member function of 'string' values (e.g. 's.indexOf(x)') shared by proxies and direct method calls
+    using Handler = HardValue(*)(IVM& vm, IVMExecution& execution, const StringMethod& method, const String& instance, const ICallArguments& arguments);
+    const char* name;
+    Handler handler;
+    HardValue call(IVM& vm, IVMExecution& execution, const String& instance, const ICallArguments& arguments) const;
+    static const StringMethod* find(const String& name); // Returns nullptr if unknown
+  };
+
   class ObjectFactory {
   public:
     // Builtin factories
@@ -63,7 +79,7 @@ namespace egg::ovum {
     static HardObject createManifestationObject(IVM& vm);
     static HardObject createManifestationAny(IVM& vm);
     // Vanilla factories
-    static HardObject createVanillaArray(IVM& vm, const Type& elementType, Accessability accessability);
+    static HardObject createVanillaArray(IVM& vm, const Type& elementType, Accessability accessability, bool declared);
     static HardObject createVanillaObject(IVM& vm, const Type& runtimeType, Accessability accessability);
     static HardObject createVanillaKeyValue(IVM& vm, const HardValue& key, const HardValue& value, Accessability accessability);
     static HardObject createVanillaManifestation(IVM& vm, const Type& infratype, const Type& metatype);
@@ -73,22 +89,11 @@ namespace egg::ovum {
     static HardObject createPointerToIndex(IVM& vm, const HardObject& instance, const HardValue& index, Modifiability modifiability, const Type& pointerType);
     static HardObject createPointerToProperty(IVM& vm, const HardObject& instance, const HardValue& property, Modifiability modifiability, const Type& pointerType);
     // String proxy factories
-    static HardObject createStringProxyCompareTo(IVM& vm, const String& instance);
-    static HardObject createStringProxyContains(IVM& vm, const String& instance);
-    static HardObject createStringProxyEndsWith(IVM& vm, const String& instance);
-    static HardObject createStringProxyHash(IVM& vm, const String& instance);
-    static HardObject createStringProxyIndexOf(IVM& vm, const String& instance);
-    static HardObject createStringProxyJoin(IVM& vm, const String& instance);
-    static HardObject createStringProxyLastIndexOf(IVM& vm, const String& instance);
-    static HardObject createStringProxyPadLeft(IVM& vm, const String& instance);
-    static HardObject createStringProxyPadRight(IVM& vm, const String& instance);
-    static HardObject createStringProxyRepeat(IVM& vm, const String& instance);
-    static HardObject createStringProxyReplace(IVM& vm, const String& instance);
-    static HardObject createStringProxySlice(IVM& vm, const String& instance);
-    static HardObject createStringProxyStartsWith(IVM& vm, const String& instance);
-    static HardObject createStringProxyToString(IVM& vm, const String& instance);
+    static HardObject createStringProxy(IVM& vm, const String& instance, const StringMethod& method);
     // Builder factories
     static HardPtr<IObjectBuilder> createObjectBuilder(IVM& vm, const Type& containerType, Accessability accessability);
     static HardPtr<IObjectBuilder> createRuntimeErrorBuilder(IVM& vm, const String& message, const HardPtr<IVMCallStack>& callstack);
+    // Shape factories
+    static HardPtr<IObjectShapes> createObjectShapes(IAllocator& allocator);
   };
 }
@@ -7,7 +7,9 @@
 #include <fstream>
 #include <regex>
 #include <fcntl.h>
+#include <linux/membarrier.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <sys/times.h>
 
 namespace {
@@ -186,6 +188,41 @@ egg::ovum::os::memory::Snapshot egg::ovum::os::memory::snapshot() {
   return snapshot;
 }
 
+void egg::ovum::os::memory::barrier() {
+  // See https://man7.org/linux/man-pages/man2/membarrier.2.html
+  static const bool expedited = ::syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+  if (expedited && (::syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) == 0)) {
+    return;
+  }
+  // Fall back to forcing a TLB shootdown on every core running this process (e.g. under WSL1)
+  static std::mutex mutex;
+  static auto* page = static_cast<std::atomic<int>*>(::mmap(nullptr, 1, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  std::lock_guard<std::mutex> lock{ mutex };
+  if ((page == MAP_FAILED) || (::mprotect(page, 1, PROT_READ | PROT_WRITE) != 0)) {
+    throw egg::ovum::Exception("Cannot issue process-wide memory barrier");
+  }
+  page->fetch_add(1);
+  ::mprotect(page, 1, PROT_READ);
+}
+
+void* egg::ovum::os::memory::reserve(size_t bytes) {
+  auto* reserved = ::mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return (reserved == MAP_FAILED) ? nullptr : reserved;
+}
+
+bool egg::ovum::os::memory::commit(void* address, size_t bytes) {
+  return ::mprotect(address, bytes, PROT_READ | PROT_WRITE) == 0;
+}
+
+void egg::ovum::os::memory::decommit(void* address, size_t bytes) {
+  // Replacing the mapping discards the contents and any physical pages
+  (void)::mmap(address, bytes, PROT_NONE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+}
+
+void egg::ovum::os::memory::release(void* reserved, size_t bytes) {
+  (void)::munmap(reserved, bytes);
+}
+
 egg::ovum::os::process::Snapshot egg::ovum::os::process::snapshot() {
   tms tms;
   ::times(&tms);
@@ -7,6 +7,16 @@ namespace egg::ovum::os::memory {
   };
   Snapshot snapshot();
 
+  // Executes a full memory barrier on every running thread of this process (expensive)
+  void barrier();
+
+  // Reserves address space without backing it with memory (returns nullptr on failure)
+  void* reserve(size_t bytes);
+  // Backs part of a reservation with zeroed memory, or returns that memory to the system
+  bool commit(void* address, size_t bytes);
+  void decommit(void* address, size_t bytes);
+  void release(void* reserved, size_t bytes);
+
 #if EGG_PLATFORM == EGG_PLATFORM_MSVC
   // Microsoft-style run-time
   inline void* alloc(size_t bytes, size_t alignment) {
@@ -228,6 +228,26 @@ egg::ovum::os::memory::Snapshot egg::ovum::os::memory::snapshot() {
   return snapshot;
 }
 
+void egg::ovum::os::memory::barrier() {
+  ::FlushProcessWriteBuffers();
+}
+
+void* egg::ovum::os::memory::reserve(size_t bytes) {
+  return ::VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool egg::ovum::os::memory::commit(void* address, size_t bytes) {
+  return ::VirtualAlloc(address, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void egg::ovum::os::memory::decommit(void* address, size_t bytes) {
+  (void)::VirtualFree(address, bytes, MEM_DECOMMIT);
+}
+
+void egg::ovum::os::memory::release(void* reserved, size_t) {
+  (void)::VirtualFree(reserved, 0, MEM_RELEASE);
+}
+
 egg::ovum::os::process::Snapshot egg::ovum::os::process::snapshot() {
   Snapshot snapshot;
   if (!getProcessTimes(snapshot)) {
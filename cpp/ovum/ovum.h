@@ -1,6 +1,8 @@
 #include "ovum/platform.h"
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -14,6 +16,10 @@
 #include <source_location>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "ovum/interfaces.h"
 #include "ovum/utility.h"
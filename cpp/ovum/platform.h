@@ -58,3 +58,8 @@
 #else
 #define EGG_WARNING_SUPPRESS_FALLTHROUGH [[fallthrough]];
 #endif
+
+// Define EGG_SINGLE_THREADED=1 to use plain (non-atomic) reference counts when each VM is confined to one thread
+#if !defined(EGG_SINGLE_THREADED)
+#define EGG_SINGLE_THREADED 0
+#endif
@@ -53,19 +53,19 @@ void egg::ovum::Print::write(std::ostream& stream, bool value, const Options&) {
 }
 
 void egg::ovum::Print::write(std::ostream& stream, int32_t value, const Options&) {
-  stream << value;
+  Arithmetic::print(stream, int64_t(value));
 }
 
 void egg::ovum::Print::write(std::ostream& stream, int64_t value, const Options&) {
-  stream << value;
+  Arithmetic::print(stream, value);
 }
 
 void egg::ovum::Print::write(std::ostream& stream, uint32_t value, const Options&) {
-  stream << value;
+  Arithmetic::print(stream, uint64_t(value));
 }
 
 void egg::ovum::Print::write(std::ostream& stream, uint64_t value, const Options&) {
-  stream << value;
+  Arithmetic::print(stream, value);
 }
 
 void egg::ovum::Print::write(std::ostream& stream, float value, const Options&) {
@@ -87,7 +87,15 @@ void egg::ovum::Print::write(std::ostream& stream, const std::string& value, con
 }
 
 void egg::ovum::Print::write(std::ostream& stream, const String& value, const Options& options) {
-  Print::write(stream, value.toUTF8(), options);
+  if (options.quote == '\0') {
+    // Avoid an intermediate copy
+    auto* memory = value.get();
+    if (memory != nullptr) {
+      stream.write(reinterpret_cast<const char*>(memory->begin()), std::streamsize(memory->bytes()));
+    }
+  } else {
+    Print::write(stream, value.toUTF8(), options);
+  }
 }
 
 void egg::ovum::Print::write(std::ostream& stream, ValueFlags value, const Options&) {
@@ -408,7 +416,7 @@ void egg::ovum::Print::escape(std::ostream& stream, const std::string& value, ch
 }
 
 void egg::ovum::Printer::write(const HardValue& value) {
-  this->write(value.get());
+  this->write(*value.get());
 }
 
 void egg::ovum::Printer::write(const HardObject& value) {
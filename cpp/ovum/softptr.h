@@ -5,11 +5,13 @@ namespace egg::ovum {
     SoftReferenceCounted& operator=(const SoftReferenceCounted&) = delete;
   protected:
     mutable IBasket* basket;
+    mutable ICollectable::Link link;
   public:
     template<typename... ARGS>
     explicit SoftReferenceCounted(ARGS&&... args)
       : HardReferenceCounted<T>(std::forward<ARGS>(args)...),
-        basket(nullptr) {
+        basket(nullptr),
+        link() {
     }
     virtual ~SoftReferenceCounted() override {
       // Make sure we're no longer a member of a basket
@@ -39,6 +41,10 @@ namespace egg::ovum {
       }
       return ICollectable::SetBasketResult::Failed;
     }
+    virtual ICollectable::Link* softGetLink() const override {
+      // Fetch our intrusive basket membership
+      return &this->link;
+    }
   };
 
   template<typename T>
@@ -91,6 +97,10 @@ namespace egg::ovum {
       // We cannot be added to a basket
       return ICollectable::SetBasketResult::Exempt;
     }
+    virtual ICollectable::Link* softGetLink() const override {
+      // We cannot be added to a basket
+      return nullptr;
+    }
     virtual void softVisit(ICollectable::IVisitor&) const override {
       // Nothing to do
     }
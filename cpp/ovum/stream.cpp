@@ -12,44 +12,61 @@ namespace {
     return (ch == '\r') || (ch == '\n');
   }
 
-  int readContinuation(ByteStream& stream, int value, size_t count) {
+  const size_t chunkBytes = 4096;
+
+  size_t decodeCodepoint(const uint8_t* p, const uint8_t* q, char32_t& codepoint, const char*& failure) {
+    // Decode a single codepoint returning its length or zero with a 'failure' message
     // See https://en.wikipedia.org/wiki/UTF-8
-    do {
-      auto b = stream.get();
-      if (b < 0) {
-        throw egg::ovum::Exception("Invalid UTF-8 encoding (truncated continuation): '{resource}'").with("resource", stream.getResourceName());
+    assert(p < q);
+    auto length = UTF8::sizeFromLeadByte(*p);
+    if (length == 1) {
+      codepoint = *p;
+      return 1;
+    }
+    if (length == SIZE_MAX) {
+      failure = ((*p & 0xC0) == 0x80) ? "Invalid UTF-8 encoding (unexpected continuation): '{resource}'" : "Invalid UTF-8 encoding (bad lead byte): '{resource}'";
+      return 0;
+    }
+    char32_t value = *p & (0x7F >> length);
+    for (size_t i = 1; i < length; ++i) {
+      if (p + i >= q) {
+        failure = "Invalid UTF-8 encoding (truncated continuation): '{resource}'";
+        return 0;
       }
-      b ^= 0x80;
+      auto b = p[i] ^ 0x80;
       if (b > 0x3F) {
-        throw egg::ovum::Exception("Invalid UTF-8 encoding (invalid continuation): '{resource}'").with("resource", stream.getResourceName());
+        failure = "Invalid UTF-8 encoding (invalid continuation): '{resource}'";
+        return 0;
       }
-      value = (value << 6) | b;
-    } while (--count);
-    return value;
-  }
-
-  int readCodepoint(ByteStream& stream) {
-    auto b = stream.get();
-    if (b < 0x80) {
-      // EOF or ASCII codepoint
-      return b;
-    }
-    if (b < 0xC0) {
-      throw egg::ovum::Exception("Invalid UTF-8 encoding (unexpected continuation): '{resource}'").with("resource", stream.getResourceName());
+      value = (value << 6) | char32_t(b);
     }
-    if (b < 0xE0) {
-      // One continuation byte
-      return readContinuation(stream, b & 0x1F, 1);
+    static const char32_t minimum[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if (value < minimum[length]) {
+      failure = "Invalid UTF-8 encoding (overlong sequence): '{resource}'";
+      return 0;
     }
-    if (b < 0xF0) {
-      // Two continuation bytes
-      return readContinuation(stream, b & 0x0F, 2);
+    if (((value >= 0xD800) && (value <= 0xDFFF)) || (value > 0x10FFFF)) {
+      failure = "Invalid UTF-8 encoding (invalid codepoint): '{resource}'";
+      return 0;
     }
-    if (b < 0xF8) {
-      // Three continuation bytes
-      return readContinuation(stream, b & 0x07, 3);
+    codepoint = value;
+    return length;
+  }
+
+  size_t completeSequences(const uint8_t* p, const uint8_t* q) {
+    // Find the number of bytes before any sequence truncated by the end of the chunk
+    auto lead = q;
+    while ((lead > p) && ((q - lead) < 4)) {
+      auto b = *--lead;
+      if ((b & 0xC0) != 0x80) {
+        auto length = UTF8::sizeFromLeadByte(b);
+        if ((length != SIZE_MAX) && (length > size_t(q - lead))) {
+          return size_t(lead - p);
+        }
+        break;
+      }
     }
-    throw egg::ovum::Exception("Invalid UTF-8 encoding (bad lead byte): '{resource}'").with("resource", stream.getResourceName());
+    return size_t(q - p);
   }
 }
 
@@ -68,12 +85,12 @@ EggboxByteStream::~EggboxByteStream() {
 }
 
 int egg::ovum::CharStream::get() {
-  auto codepoint = readCodepoint(this->bytes);
+  auto codepoint = this->read();
   if (this->swallowBOM) {
     // See https://en.wikipedia.org/wiki/Byte_order_mark
     this->swallowBOM = false;
     if (codepoint == 0xFEFF) {
-      codepoint = readCodepoint(this->bytes);
+      codepoint = this->read();
     }
   }
   return codepoint;
@@ -82,13 +99,69 @@ int egg::ovum::CharStream::get() {
 void egg::ovum::CharStream::slurp(std::u32string& text) {
   for (auto ch = this->get(); ch >= 0; ch = this->get()) {
     text.push_back(char32_t(ch));
+    // Append the remainder of the decoded chunk in one go
+    text.append(this->decoded, this->next);
+    this->next = this->decoded.size();
   }
 }
 
 bool egg::ovum::CharStream::rewind() {
+  this->undecoded.clear();
+  this->decoded.clear();
+  this->next = 0;
+  this->failure = nullptr;
   return this->bytes.rewind();
 }
 
+int egg::ovum::CharStream::read() {
+  while (this->next >= this->decoded.size()) {
+    if (this->failure != nullptr) {
+      throw egg::ovum::Exception(this->failure).with("resource", this->bytes.getResourceName());
+    }
+    if (!this->fill()) {
+      return -1;
+    }
+  }
+  return int(this->decoded[this->next++]);
+}
+
+bool egg::ovum::CharStream::fill() {
+  // Decode the next chunk of bytes in bulk, returning false at EOF
+  auto carried = this->undecoded.size();
+  this->undecoded.resize(carried + chunkBytes);
+  auto fetched = this->bytes.read(this->undecoded.data() + carried, chunkBytes);
+  this->undecoded.resize(carried + fetched);
+  if (this->undecoded.empty()) {
+    return false;
+  }
+  auto* p = this->undecoded.data();
+  auto* q = p + this->undecoded.size();
+  if (fetched > 0) {
+    // Leave any truncated sequence for the next chunk
+    q = p + completeSequences(p, q);
+  }
+  this->decoded.resize(size_t(q - p));
+  this->next = 0;
+  if (UTF8::measure(p, q) != SIZE_MAX) {
+    // Fast path for well-formed chunks
+    this->decoded.resize(UTF8::decode(this->decoded.data(), p, q));
+  } else {
+    // Decode up to the first malformed sequence
+    size_t count = 0;
+    while (p < q) {
+      auto length = decodeCodepoint(p, q, this->decoded[count], this->failure);
+      if (length == 0) {
+        break;
+      }
+      p += length;
+      count++;
+    }
+    this->decoded.resize(count);
+  }
+  this->undecoded.erase(this->undecoded.begin(), this->undecoded.begin() + (q - this->undecoded.data()));
+  return true;
+}
+
 bool egg::ovum::TextStream::ensure(size_t count) {
   int ch = 0;
   if (this->upcoming.empty()) {
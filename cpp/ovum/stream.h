@@ -37,6 +37,14 @@ namespace egg::ovum {
       }
       return -1;
     }
+    size_t read(uint8_t* buffer, size_t count) {
+      // Read up to 'count' bytes returning the number actually read (zero at EOF)
+      this->stream.read(reinterpret_cast<char*>(buffer), std::streamsize(count));
+      if (this->stream.bad()) {
+        throw egg::ovum::Exception("Failed to read bytes from binary file: '{path}'").with("path", this->resource);
+      }
+      return size_t(this->stream.gcount());
+    }
     bool rewind() {
       this->stream.clear();
       return this->stream.seekg(0).good();
@@ -86,6 +94,10 @@ namespace egg::ovum {
   private:
     ByteStream& bytes;
     bool swallowBOM;
+    std::vector<uint8_t> undecoded; // trailing bytes of a sequence split across chunks
+    std::u32string decoded; // codepoints decoded in bulk from the last chunk
+    size_t next = 0; // index into 'decoded'
+    const char* failure = nullptr; // raised once 'decoded' is exhausted
   public:
     explicit CharStream(ByteStream& bytes, bool swallowBOM = true)
       : bytes(bytes), swallowBOM(swallowBOM) {
@@ -96,6 +108,9 @@ namespace egg::ovum {
     const std::string& getResourceName() const {
       return this->bytes.getResourceName();
     }
+  private:
+    int read();
+    bool fill();
   };
 
   class EggboxCharStream : public CharStream {
@@ -2,6 +2,7 @@
 #include "ovum/utf.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 namespace {
   using namespace egg::ovum;
@@ -9,6 +10,357 @@ namespace {
   const uint8_t emptyByte = 0;
   const UTF8 emptyReader(&emptyByte, &emptyByte, 0);
 
+  class MemoryString : public HardReferenceCountedAllocator<IMemory> {
+    MemoryString(const MemoryString&) = delete;
+    MemoryString& operator=(const MemoryString&) = delete;
+  public:
+    static constexpr size_t Stride = 32; // Code points between entries in the sparse offset index
+    static constexpr size_t Indexed = Stride * 2; // Non-ASCII strings at least this long are indexed on first random access
+  protected:
+    size_t size;
+    size_t codepoints;
+  private:
+    mutable Atomic<const size_t*> strides; // Byte offsets of every 'Stride'th code point (built lazily)
+    mutable Atomic<const IStringPool*> pool; // The pool that interned this string, if any
+    mutable Atomic<int64_t> hashcode; // Zero if not yet computed (see 'String::hash()')
+  protected:
+    MemoryString(IAllocator& allocator, size_t size, size_t codepoints)
+      : HardReferenceCountedAllocator<IMemory>(allocator), size(size), codepoints(codepoints), strides(nullptr), pool(nullptr), hashcode(0) {
+      assert(size > 0);
+      assert(codepoints <= size);
+    }
+  public:
+    virtual ~MemoryString() override {
+      auto* table = this->strides.get();
+      if (table != nullptr) {
+        this->allocator.deallocate(const_cast<size_t*>(table), alignof(size_t));
+      }
+    }
+    virtual IMemory::Tag tag() const override {
+      return IMemory::Tag{ this->codepoints };
+    }
+    virtual void copyTo(uint8_t* target) const {
+      // Copy all the bytes without necessarily making them contiguous first
+      std::memcpy(target, this->begin(), this->size);
+    }
+    virtual const MemoryString& owner(size_t& offset) const {
+      // The string that actually holds our bytes, adjusting 'offset' accordingly
+      (void)offset;
+      return *this;
+    }
+    virtual size_t depth() const {
+      // Number of unflattened rope levels below this string
+      return 0;
+    }
+    size_t getByteCount() const {
+      // Unlike 'IMemory::bytes()' this never flattens ropes
+      return this->size;
+    }
+    size_t getCodePointCount() const {
+      return this->codepoints;
+    }
+    size_t offset(size_t index) const {
+      // Byte offset of the code point at 'index' via the sparse index
+      assert(index < this->codepoints);
+      assert(this->codepoints >= MemoryString::Indexed);
+      auto* table = this->strides.get();
+      if (table == nullptr) {
+        table = this->index();
+      }
+      auto* base = this->begin();
+      auto* p = base + table[index / MemoryString::Stride];
+      for (auto skip = index % MemoryString::Stride; skip > 0; --skip) {
+        // Step over the lead byte and any continuation bytes
+        do {
+          ++p;
+        } while ((*p & 0xC0) == 0x80);
+      }
+      return size_t(p - base);
+    }
+    int64_t hash() const {
+      // Computed once on demand; like Java, a string whose hash is genuinely zero is simply recomputed
+      auto cached = this->hashcode.get();
+      if (cached == 0) {
+        cached = this->computeHash();
+        this->hashcode.set(cached);
+      }
+      return cached;
+    }
+    const IStringPool* interned() const {
+      return this->pool.get();
+    }
+    bool intern(const IStringPool& by) const {
+      // Only the first pool to claim a string may mark it
+      auto* before = this->pool.update(nullptr, &by);
+      return (before == nullptr) || (before == &by);
+    }
+    void unintern(const IStringPool& by) const {
+      // Called when the pool is destroyed so that its address can be safely reused
+      (void)this->pool.update(&by, nullptr);
+    }
+    static const MemoryString& from(const IMemory& memory) {
+      // All string memory is created within this translation unit
+      return static_cast<const MemoryString&>(memory);
+    }
+  private:
+    int64_t computeHash() const {
+      // See https://docs.oracle.com/javase/6/docs/api/java/lang/String.html#hashCode()
+      uint64_t hash = 0;
+      auto* p = this->begin();
+      auto* q = p + this->size;
+      if (this->codepoints == this->size) {
+        // ASCII-only strings have one byte per code point
+        while (p < q) {
+          hash = hash * 31 + *p++;
+        }
+      } else {
+        UTF8 reader{ p, q, 0 };
+        char32_t codepoint = 0;
+        while (reader.forward(codepoint)) {
+          hash = hash * 31 + uint32_t(codepoint);
+        }
+      }
+      return int64_t(hash);
+    }
+    const size_t* index() const {
+      // Build the index; if another thread beats us to it, use theirs
+      auto entries = (this->codepoints + MemoryString::Stride - 1) / MemoryString::Stride;
+      auto* table = static_cast<size_t*>(this->allocator.allocate(entries * sizeof(size_t), alignof(size_t)));
+      assert(table != nullptr);
+      size_t codepoint = 0;
+      auto* p = this->begin();
+      for (size_t offset = 0; offset < this->size; ++offset) {
+        if ((p[offset] & 0xC0) != 0x80) {
+          if ((codepoint % MemoryString::Stride) == 0) {
+            table[codepoint / MemoryString::Stride] = offset;
+          }
+          ++codepoint;
+        }
+      }
+      assert(codepoint == this->codepoints);
+      auto* before = this->strides.update(nullptr, table);
+      if (before != nullptr) {
+        this->allocator.deallocate(table, alignof(size_t));
+        return before;
+      }
+      return table;
+    }
+  };
+
+  class MemoryStringContiguous final : public MemoryString {
+    MemoryStringContiguous(const MemoryStringContiguous&) = delete;
+    MemoryStringContiguous& operator=(const MemoryStringContiguous&) = delete;
+  public:
+    MemoryStringContiguous(IAllocator& allocator, size_t size, size_t codepoints)
+      : MemoryString(allocator, size, codepoints) {
+    }
+    virtual const uint8_t* begin() const override {
+      return this->base();
+    }
+    virtual const uint8_t* end() const override {
+      return this->base() + this->size;
+    }
+    uint8_t* base() const {
+      // The bytes immediately follow the header
+      return const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(this + 1));
+    }
+    static MemoryStringContiguous* create(IAllocator& allocator, size_t bytes, size_t codepoints) {
+      // The caller is responsible for filling in the bytes
+      auto* memory = allocator.create<MemoryStringContiguous>(bytes, allocator, bytes, codepoints);
+      assert(memory != nullptr);
+      return memory;
+    }
+  };
+
+  class MemoryStringSlice final : public MemoryString {
+    MemoryStringSlice(const MemoryStringSlice&) = delete;
+    MemoryStringSlice& operator=(const MemoryStringSlice&) = delete;
+  public:
+    static constexpr size_t Minimum = 256; // Substrings shorter than this (in bytes) are cheaper to copy
+    static constexpr size_t Fraction = 2; // Substrings smaller than this fraction of their owner are copied so as not to pin it
+  private:
+    String parent; // Never itself a slice
+    size_t start;
+  public:
+    MemoryStringSlice(IAllocator& allocator, const MemoryString& parent, size_t start, size_t size, size_t codepoints)
+      : MemoryString(allocator, size, codepoints), parent(&parent), start(start) {
+      assert((start + size) <= parent.getByteCount());
+    }
+    virtual const uint8_t* begin() const override {
+      return this->parent->begin() + this->start;
+    }
+    virtual const uint8_t* end() const override {
+      return this->begin() + this->size;
+    }
+    virtual const MemoryString& owner(size_t& offset) const override {
+      offset += this->start;
+      return MemoryString::from(*this->parent);
+    }
+  };
+
+  class MemoryStringRope final : public MemoryString {
+    MemoryStringRope(const MemoryStringRope&) = delete;
+    MemoryStringRope& operator=(const MemoryStringRope&) = delete;
+  public:
+    static constexpr size_t Minimum = 1024; // Concatenations shorter than this (in bytes) are cheaper to copy
+    static constexpr size_t Deepest = 512; // Deeper ropes are flattened to bound recursion when copying and destroying
+  private:
+    mutable std::mutex mutex;
+    mutable String lhs; // Released once flattened
+    mutable String rhs; // Released once flattened
+    mutable Atomic<const uint8_t*> flat; // Contiguous bytes (built lazily)
+    size_t levels;
+  public:
+    MemoryStringRope(IAllocator& allocator, const String& lhs, const String& rhs)
+      : MemoryString(allocator, MemoryString::from(*lhs).getByteCount() + MemoryString::from(*rhs).getByteCount(), lhs.length() + rhs.length()),
+        lhs(lhs),
+        rhs(rhs),
+        flat(nullptr),
+        levels(std::max(MemoryString::from(*lhs).depth(), MemoryString::from(*rhs).depth()) + 1) {
+    }
+    virtual ~MemoryStringRope() override {
+      auto* bytes = this->flat.get();
+      if (bytes != nullptr) {
+        this->allocator.deallocate(const_cast<uint8_t*>(bytes), 1);
+      }
+    }
+    virtual const uint8_t* begin() const override {
+      auto* bytes = this->flat.get();
+      if (bytes == nullptr) {
+        bytes = this->flatten();
+      }
+      return bytes;
+    }
+    virtual const uint8_t* end() const override {
+      return this->begin() + this->size;
+    }
+    virtual void copyTo(uint8_t* target) const override {
+      // Avoid flattening intermediate nodes when flattening their ancestors
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      auto* bytes = this->flat.get();
+      if (bytes != nullptr) {
+        std::memcpy(target, bytes, this->size);
+      } else {
+        this->copyChildren(target);
+      }
+    }
+    virtual size_t depth() const override {
+      return (this->flat.get() == nullptr) ? this->levels : 0;
+    }
+    bool children(String& left, String& right) const {
+      // Fails if the rope has already been flattened
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      if (this->flat.get() != nullptr) {
+        return false;
+      }
+      left = this->lhs;
+      right = this->rhs;
+      return true;
+    }
+  private:
+    void copyChildren(uint8_t* target) const {
+      auto& left = MemoryString::from(*this->lhs);
+      left.copyTo(target);
+      MemoryString::from(*this->rhs).copyTo(target + left.getByteCount());
+    }
+    const uint8_t* flatten() const {
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      auto* bytes = this->flat.get();
+      if (bytes == nullptr) {
+        auto* buffer = static_cast<uint8_t*>(this->allocator.allocate(this->size, 1));
+        assert(buffer != nullptr);
+        this->copyChildren(buffer);
+        this->flat.set(buffer);
+        this->lhs = String();
+        this->rhs = String();
+        bytes = buffer;
+      }
+      return bytes;
+    }
+  };
+
+  String concatenate(IAllocator& allocator, const String& lhs, const String& rhs) {
+    // Both strings are known to be non-empty
+    auto& left = MemoryString::from(*lhs);
+    auto& right = MemoryString::from(*rhs);
+    auto bytes = left.getByteCount() + right.getByteCount();
+    if (bytes < MemoryStringRope::Minimum) {
+      auto* memory = MemoryStringContiguous::create(allocator, bytes, left.getCodePointCount() + right.getCodePointCount());
+      left.copyTo(memory->base());
+      right.copyTo(memory->base() + left.getByteCount());
+      return String(memory);
+    }
+    if ((left.depth() > 0) && (right.depth() == 0) && (right.getByteCount() < MemoryStringRope::Minimum)) {
+      // Appending a short piece to a rope: coalesce it with the rope's right-hand leaf if that is also short
+      String inner;
+      String outer;
+      if (static_cast<const MemoryStringRope&>(left).children(outer, inner)) {
+        auto& leaf = MemoryString::from(*inner);
+        if ((leaf.depth() == 0) && ((leaf.getByteCount() + right.getByteCount()) < MemoryStringRope::Minimum)) {
+          return String(allocator.makeRaw<MemoryStringRope>(allocator, outer, concatenate(allocator, inner, rhs)));
+        }
+      }
+    }
+    if (std::max(left.depth(), right.depth()) >= MemoryStringRope::Deepest) {
+      // Flattening resets the depth of the deeper side(s)
+      if (left.depth() >= MemoryStringRope::Deepest) {
+        (void)left.begin();
+      }
+      if (right.depth() >= MemoryStringRope::Deepest) {
+        (void)right.begin();
+      }
+    }
+    return String(allocator.makeRaw<MemoryStringRope>(allocator, lhs, rhs));
+  }
+
+  class StringPool : public HardReferenceCountedAllocator<IStringPool> {
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+  private:
+    mutable std::mutex mutex;
+    std::unordered_set<String> strings;
+  public:
+    explicit StringPool(IAllocator& allocator)
+      : HardReferenceCountedAllocator<IStringPool>(allocator) {
+    }
+    virtual ~StringPool() override {
+      for (const auto& string : this->strings) {
+        MemoryString::from(*string.get()).unintern(*this);
+      }
+    }
+    virtual String intern(const String& value) override {
+      auto* memory = value.get();
+      if (memory == nullptr) {
+        return value;
+      }
+      auto& string = MemoryString::from(*memory);
+      if (string.interned() == this) {
+        // Already canonical, so no need to lock
+        return value;
+      }
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      auto found = this->strings.find(value);
+      if (found != this->strings.end()) {
+        return *found;
+      }
+      if (string.intern(*this)) {
+        this->strings.insert(value);
+        return value;
+      }
+      // Already interned by another pool, so take a private copy
+      auto copy = String::fromUTF8(this->allocator, memory->begin(), memory->bytes(), value.length());
+      auto claimed = MemoryString::from(*copy.get()).intern(*this);
+      assert(claimed);
+      (void)claimed;
+      this->strings.insert(copy);
+      return copy;
+    }
+    virtual size_t getStringCount() const override {
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      return this->strings.size();
+    }
+  };
+
   UTF8 readerBegin(const String& s) {
     auto* p = s.get();
     if (p == nullptr) {
@@ -35,6 +387,14 @@ namespace {
       // Go to the very end
       return readerEnd(s);
     }
+    if (length == p->bytes()) {
+      // ASCII-only strings have one byte per code point
+      return UTF8(p->begin(), p->end(), index);
+    }
+    if (length >= MemoryString::Indexed) {
+      // Longer strings use the sparse index to avoid quadratic behaviour when indexing in loops
+      return UTF8(p->begin(), p->end(), MemoryString::from(*p).offset(index));
+    }
     if (index > (length >> 1)) {
       // We're closer to the end of the string
       auto reader = readerEnd(s);
@@ -46,152 +406,255 @@ namespace {
     return reader;
   }
 
-  bool iterationMatch(UTF8 lhsReader, UTF8 rhsReader, size_t count, bool compensateForBackwards) {
-    // OPTIMIZE using std::memcmp
-    // Note reader parameters passed-by-value
-    assert(count > 0);
-    if (compensateForBackwards) {
-      // Compensate for the lhs originally reading backwards
-      lhsReader.forward();
+  // UTF-8 is self-synchronising so a byte-level match of well-formed needle is always a whole code point match
+  const size_t searchHorspoolNeedle = 4; // Needles shorter than this (in bytes) just filter on the first byte
+  const size_t searchHorspoolHaystack = 256; // Haystacks shorter than this (in bytes) don't amortize the skip table
+
+  const uint8_t* searchForward(const uint8_t* p, const uint8_t* q, const uint8_t* needle, size_t bytes) {
+    // Find the first occurrence of the needle bytes within [p, q)
+    assert(bytes > 0);
+    if (size_t(q - p) < bytes) {
+      return nullptr;
     }
-    char32_t lhsCodePoint;
-    char32_t rhsCodePoint;
-    while (--count > 0) {
-      if (!lhsReader.forward(lhsCodePoint) || !rhsReader.forward(rhsCodePoint) || (lhsCodePoint != rhsCodePoint)) {
-        return false;
+    auto* last = q - bytes;
+    if ((bytes < searchHorspoolNeedle) || (size_t(q - p) < searchHorspoolHaystack)) {
+      // Let 'memchr' (usually vectorised) find candidates by their first byte
+      while (p <= last) {
+        p = static_cast<const uint8_t*>(std::memchr(p, needle[0], size_t(last - p) + 1));
+        if (p == nullptr) {
+          return nullptr;
+        }
+        if (std::memcmp(p + 1, needle + 1, bytes - 1) == 0) {
+          return p;
+        }
+        ++p;
       }
+      return nullptr;
     }
-    return true;
+    // See https://en.wikipedia.org/wiki/Boyer%E2%80%93Moore%E2%80%93Horspool_algorithm
+    size_t skip[256];
+    std::fill(std::begin(skip), std::end(skip), bytes);
+    for (size_t i = 0; i < bytes - 1; ++i) {
+      skip[needle[i]] = bytes - 1 - i;
+    }
+    auto tail = needle[bytes - 1];
+    while (p <= last) {
+      auto b = p[bytes - 1];
+      if ((b == tail) && (std::memcmp(p, needle, bytes - 1) == 0)) {
+        return p;
+      }
+      p += skip[b];
+    }
+    return nullptr;
   }
 
-  int64_t indexOfCodePointByIteration(const String& haystack, char32_t needle, size_t fromIndex) {
-    // Iterate around the haystack for the needle
-    auto haystackReader = readerIndex(haystack, fromIndex);
-    int64_t index = int64_t(fromIndex);
-    char32_t haystackCodePoint;
-    while (haystackReader.forward(haystackCodePoint)) {
-      if (haystackCodePoint == needle) {
-        return index;
-      }
-      index++;
-    }
-    return -1; // Not found
-  }
-
-  int64_t indexOfStringByIteration(const String& haystack, const String& needle, size_t fromIndex) {
-    // Iterate around the haystack for the needle
-    auto needleLength = needle.length();
-    assert(needleLength > 0);
-    auto needleReader = readerBegin(needle);
-    char32_t needleCodePoint;
-    if (needleReader.forward(needleCodePoint)) {
-      int64_t index = 0;
-      auto haystackReader = readerIndex(haystack, fromIndex);
-      char32_t haystackCodePoint;
-      while (haystackReader.forward(haystackCodePoint)) {
-        if ((haystackCodePoint == needleCodePoint) && iterationMatch(haystackReader, needleReader, needleLength, false)) {
-          return index;
+  const uint8_t* searchBackward(const uint8_t* p, const uint8_t* q, const uint8_t* needle, size_t bytes) {
+    // Find the last occurrence of the needle bytes within [p, q)
+    assert(bytes > 0);
+    if (size_t(q - p) < bytes) {
+      return nullptr;
+    }
+    auto* candidate = q - bytes;
+    if ((bytes < searchHorspoolNeedle) || (size_t(q - p) < searchHorspoolHaystack)) {
+      for (;;) {
+        if ((*candidate == needle[0]) && (std::memcmp(candidate + 1, needle + 1, bytes - 1) == 0)) {
+          return candidate;
         }
-        index++;
+        if (candidate == p) {
+          return nullptr;
+        }
+        --candidate;
+      }
+    }
+    // Horspool mirrored: shift according to the byte at the start of the window
+    size_t skip[256];
+    std::fill(std::begin(skip), std::end(skip), bytes);
+    for (size_t i = bytes - 1; i > 0; --i) {
+      skip[needle[i]] = i;
+    }
+    for (;;) {
+      auto b = *candidate;
+      if ((b == needle[0]) && (std::memcmp(candidate + 1, needle + 1, bytes - 1) == 0)) {
+        return candidate;
+      }
+      auto step = skip[b];
+      if (size_t(candidate - p) < step) {
+        return nullptr;
       }
+      candidate -= step;
+    }
+  }
+
+  size_t countCodePoints(const IMemory& memory, const uint8_t* p, const uint8_t* q) {
+    // Convert a byte range of the string to a code point count
+    if (size_t(memory.tag().u) == memory.bytes()) {
+      // ASCII-only strings have one byte per code point
+      return size_t(q - p);
     }
-    return -1; // Not found
+    return UTF8::count(p, q);
   }
 
-  int64_t lastIndexOfCodePointByIteration(const String& haystack, char32_t needle, size_t fromIndex) {
-    // Iterate around the haystack for the needle from back-to-front
-    auto haystackReader = readerIndex(haystack, fromIndex);
-    auto index = int64_t(std::min(fromIndex, haystack.length()));
-    auto haystackCodePoint = needle;
-    while (haystackReader.backward(haystackCodePoint)) {
-      index--;
-      if (haystackCodePoint == needle) {
-        return index;
+  String fromRange(IAllocator& allocator, const IMemory& memory, size_t start, size_t bytes, size_t codepoints) {
+    // Create a string from a byte range of another string, sharing the bytes only if the range is long and covers much of the owner
+    if (bytes >= MemoryStringSlice::Minimum) {
+      auto offset = start;
+      auto& owner = MemoryString::from(memory).owner(offset);
+      if ((bytes * MemoryStringSlice::Fraction) >= owner.getByteCount()) {
+        return String(allocator.makeRaw<MemoryStringSlice>(allocator, owner, offset, bytes, codepoints));
       }
     }
-    return -1; // Not found
+    return String::fromUTF8(allocator, memory.begin() + start, bytes, codepoints);
   }
 
-  int64_t lastIndexOfStringByIteration(const String& haystack, const String& needle, size_t fromIndex) {
-    // Iterate around the haystack for the needle from back-to-front
-    auto needleLength = needle.length();
-    assert(needleLength > 0);
-    auto needleReader = readerBegin(needle);
-    char32_t needleCodePoint;
-    if (needleReader.forward(needleCodePoint)) {
-      auto index = int64_t(std::min(fromIndex, haystack.length()));
-      auto haystackReader = readerIndex(haystack, fromIndex);
-      char32_t haystackCodePoint;
-      while (haystackReader.backward(haystackCodePoint)) {
-        index--;
-        if ((haystackCodePoint == needleCodePoint) && iterationMatch(haystackReader, needleReader, needleLength, true)) {
-          return index;
-        }
+  String fromBytes(IAllocator& allocator, const IMemory& memory, const uint8_t* p, const uint8_t* q) {
+    // Create a string from a byte range of another string
+    return fromRange(allocator, memory, size_t(p - memory.begin()), size_t(q - p), countCodePoints(memory, p, q));
+  }
+
+  int64_t indexOfBytes(const String& haystack, const uint8_t* needle, size_t bytes, size_t fromIndex) {
+    // Search forwards for the first occurrence at or after code point 'fromIndex'
+    auto* memory = haystack.get();
+    if ((memory == nullptr) || (fromIndex >= haystack.length())) {
+      return -1;
+    }
+    auto* p = memory->begin() + readerIndex(haystack, fromIndex).getIterationInternal();
+    auto* found = searchForward(p, memory->end(), needle, bytes);
+    if (found == nullptr) {
+      return -1;
+    }
+    return int64_t(fromIndex + countCodePoints(*memory, p, found));
+  }
+
+  int64_t lastIndexOfBytes(const String& haystack, const uint8_t* needle, size_t bytes, size_t fromIndex) {
+    // Search backwards for the last occurrence at or before code point 'fromIndex'
+    auto* memory = haystack.get();
+    if (memory == nullptr) {
+      return -1;
+    }
+    auto* p = memory->begin();
+    auto* q = memory->end();
+    if (fromIndex < haystack.length()) {
+      // Allow the needle to overhang 'fromIndex'
+      q = p + std::min(readerIndex(haystack, fromIndex).getIterationInternal() + bytes, memory->bytes());
+    }
+    auto* found = searchBackward(p, q, needle, bytes);
+    if (found == nullptr) {
+      return -1;
+    }
+    return int64_t(countCodePoints(*memory, p, found));
+  }
+
+  int64_t indexOfCodePointBySearch(const String& haystack, char32_t needle, size_t fromIndex) {
+    uint8_t utf8[4];
+    auto bytes = UTF32::encode(utf8, &needle, &needle + 1);
+    return indexOfBytes(haystack, utf8, bytes, fromIndex);
+  }
+
+  int64_t indexOfStringBySearch(const String& haystack, const String& needle, size_t fromIndex) {
+    assert(!needle.empty());
+    return indexOfBytes(haystack, needle->begin(), needle->bytes(), fromIndex);
+  }
+
+  int64_t lastIndexOfCodePointBySearch(const String& haystack, char32_t needle, size_t fromIndex) {
+    uint8_t utf8[4];
+    auto bytes = UTF32::encode(utf8, &needle, &needle + 1);
+    return lastIndexOfBytes(haystack, utf8, bytes, fromIndex);
+  }
+
+  int64_t lastIndexOfStringBySearch(const String& haystack, const String& needle, size_t fromIndex) {
+    assert(!needle.empty());
+    return lastIndexOfBytes(haystack, needle->begin(), needle->bytes(), fromIndex);
+  }
+
+  void splitBySearchForward(IAllocator& allocator, std::vector<String>& dst, const String& src, const String& separator, size_t limit) {
+    // Split by string from the beginning working in bytes throughout
+    assert(!separator.empty());
+    auto* memory = src.get();
+    if (memory == nullptr) {
+      dst.emplace_back();
+      return;
+    }
+    auto* p = memory->begin();
+    auto* q = memory->end();
+    auto* needle = separator->begin();
+    auto bytes = separator->bytes();
+    auto* found = searchForward(p, q, needle, bytes);
+    while (found != nullptr) {
+      dst.emplace_back(fromBytes(allocator, *memory, p, found));
+      p = found + bytes;
+      if (--limit == 0) {
+        break;
       }
+      found = searchForward(p, q, needle, bytes);
     }
-    return -1; // Not found
+    dst.emplace_back(fromBytes(allocator, *memory, p, q));
+  }
+
+  void splitBySearchBackward(IAllocator& allocator, std::vector<String>& dst, const String& src, const String& separator, size_t limit) {
+    // Split by string from the end working in bytes throughout
+    assert(!separator.empty());
+    auto* memory = src.get();
+    if (memory == nullptr) {
+      dst.emplace_back();
+      return;
+    }
+    auto* p = memory->begin();
+    auto* q = memory->end();
+    auto* needle = separator->begin();
+    auto bytes = separator->bytes();
+    auto* found = searchBackward(p, q, needle, bytes);
+    while (found != nullptr) {
+      dst.emplace_back(fromBytes(allocator, *memory, found + bytes, q));
+      q = found;
+      if (--limit == 0) {
+        break;
+      }
+      found = searchBackward(p, q, needle, bytes);
+    }
+    dst.emplace_back(fromBytes(allocator, *memory, p, q));
+    std::reverse(dst.begin(), dst.end());
   }
 
   void splitPositive(IAllocator& allocator, std::vector<String>& dst, const String& src, const String& separator, size_t limit) {
     // Unlike the original parameter, 'limit' is the maximum number of SPLITS to perform
-    // OPTIMIZE
     assert(dst.size() == 0);
-    size_t begin = 0;
     assert(limit > 0);
-    if (separator.empty()) {
-      // Split into codepoints
-      do {
-        auto cp = src.codePointAt(begin);
-        if (cp < 0) {
-          return; // Don't add a trailing empty string
-        }
-        dst.push_back(String::fromUTF32(allocator, &cp, 1));
-      } while (++begin < limit);
-    } else {
-      // Split by string
-      assert(separator.length() > 0);
-      auto index = src.indexOfString(separator, 0);
-      while (index >= 0) {
-        dst.emplace_back(src.substring(allocator, begin, size_t(index)));
-        begin = size_t(index) + separator.length();
-        if (--limit == 0) {
-          break;
-        }
-        index = src.indexOfString(separator, begin);
-      }
+    if (!separator.empty()) {
+      splitBySearchForward(allocator, dst, src, separator, limit);
+      return;
     }
+    // Split into codepoints
+    // OPTIMIZE
+    size_t begin = 0;
+    do {
+      auto cp = src.codePointAt(begin);
+      if (cp < 0) {
+        return; // Don't add a trailing empty string
+      }
+      dst.push_back(String::fromUTF32(allocator, &cp, 1));
+    } while (++begin < limit);
     dst.emplace_back(src.substring(allocator, begin, SIZE_MAX));
   }
 
   void splitNegative(IAllocator& allocator, std::vector<String>& dst, const String& src, const String& separator, size_t limit) {
     // Unlike the original parameter, 'limit' is the maximum number of SPLITS to perform
-    // OPTIMIZE
     assert(dst.size() == 0);
-    size_t end = src.length();
     assert(limit > 0);
-    auto length = separator.length();
-    if (length == 0) {
-      // Split into codepoints
-      do {
-        auto cp = src.codePointAt(--end);
-        if (cp < 0) {
-          std::reverse(dst.begin(), dst.end());
-          return; // Don't add a trailing empty string
-        }
-        dst.push_back(String::fromUTF32(allocator, &cp, 1));
-      } while (--limit > 0);
-    } else {
-      // Split by string
-      auto index = src.lastIndexOfString(separator, SIZE_MAX);
-      while (index >= 0) {
-        dst.emplace_back(src.substring(allocator, size_t(index) + length, end));
-        end = size_t(index);
-        if ((end < length) || (--limit == 0)) {
-          break;
-        }
-        index = src.lastIndexOfString(separator, end - length);
-      }
+    if (!separator.empty()) {
+      splitBySearchBackward(allocator, dst, src, separator, limit);
+      return;
     }
+    // Split into codepoints
+    // OPTIMIZE
+    size_t end = src.length();
+    do {
+      auto cp = src.codePointAt(--end);
+      if (cp < 0) {
+        std::reverse(dst.begin(), dst.end());
+        return; // Don't add a trailing empty string
+      }
+      dst.push_back(String::fromUTF32(allocator, &cp, 1));
+    } while (--limit > 0);
     dst.emplace_back(src.substring(allocator, 0, end));
     std::reverse(dst.begin(), dst.end());
   }
@@ -214,6 +677,62 @@ namespace {
       }
     }
   }
+
+  // String builders reserve room for a string header at the front of their buffers so that they can be handed over
+  constexpr size_t stringBufferHeader = sizeof(MemoryStringContiguous);
+  constexpr size_t stringBufferMinimum = 64;
+
+  void* allocateBuffer(IAllocator* allocator, size_t bytes) {
+    if (allocator == nullptr) {
+      return AllocatorDefaultPolicy::memalloc(bytes, alignof(MemoryStringContiguous));
+    }
+    return allocator->allocate(bytes, alignof(MemoryStringContiguous));
+  }
+
+  void deallocateBuffer(IAllocator* allocator, void* allocated) {
+    if (allocator == nullptr) {
+      AllocatorDefaultPolicy::memfree(allocated, alignof(MemoryStringContiguous));
+    } else {
+      allocator->deallocate(allocated, alignof(MemoryStringContiguous));
+    }
+  }
+
+  String repeatToLength(IAllocator& allocator, const String& padding, size_t codepoints, bool leading) {
+    // Repeat 'padding' to exactly 'codepoints' code points, truncating the first or last repetition as required
+    assert(!padding.empty());
+    assert(codepoints > 0);
+    auto& memory = MemoryString::from(*padding);
+    auto* src = memory.begin();
+    auto size = memory.getByteCount();
+    auto n = memory.getCodePointCount();
+    auto whole = codepoints / n;
+    auto partial = codepoints % n;
+    size_t cut = 0; // Byte offset at which the partial repetition is truncated
+    size_t extra = 0; // Bytes in the partial repetition
+    if (partial > 0) {
+      if (leading) {
+        cut = readerIndex(padding, n - partial).getIterationInternal();
+        extra = size - cut;
+      } else {
+        cut = readerIndex(padding, partial).getIterationInternal();
+        extra = cut;
+      }
+    }
+    auto* result = MemoryStringContiguous::create(allocator, whole * size + extra, codepoints);
+    auto* dst = result->base();
+    if (leading && (extra > 0)) {
+      std::memcpy(dst, src + cut, extra);
+      dst += extra;
+    }
+    for (; whole > 0; --whole) {
+      std::memcpy(dst, src, size);
+      dst += size;
+    }
+    if (!leading && (extra > 0)) {
+      std::memcpy(dst, src, extra);
+    }
+    return String(result);
+  }
 }
 
 bool egg::ovum::String::validate() const {
@@ -222,7 +741,7 @@ bool egg::ovum::String::validate() const {
     return true;
   }
   auto codepoints = size_t(memory->tag().u);
-  auto bytes = memory->bytes();
+  auto bytes = MemoryString::from(*memory).getByteCount();
   return (codepoints >= ((bytes + 3) / 4)) && (codepoints <= bytes);
 }
 
@@ -232,8 +751,8 @@ size_t egg::ovum::String::length() const {
     return 0;
   }
   auto codepoints = size_t(memory->tag().u);
-  assert(codepoints >= ((memory->bytes() + 3) / 4));
-  assert(codepoints <= memory->bytes());
+  assert(codepoints >= ((MemoryString::from(*memory).getByteCount() + 3) / 4));
+  assert(codepoints <= MemoryString::from(*memory).getByteCount());
   return codepoints;
 }
 
@@ -243,6 +762,20 @@ int32_t egg::ovum::String::codePointAt(size_t index) const {
   return reader.forward(codepoint) ? int32_t(codepoint) : -1;
 }
 
+int32_t egg::ovum::String::codePointNext(size_t& offset) const {
+  auto* p = this->get();
+  if ((p == nullptr) || (offset >= p->bytes())) {
+    return -1;
+  }
+  UTF8 reader{ p->begin(), p->end(), offset };
+  char32_t codepoint = 0;
+  if (!reader.forward(codepoint)) {
+    return -1;
+  }
+  offset = reader.getIterationInternal();
+  return int32_t(codepoint);
+}
+
 bool egg::ovum::String::equals(const char* utf8) const {
   // Ordinal comparison (note: cannot handle NUL characters in UTF8 strings)
   auto* memory = this->get();
@@ -263,18 +796,24 @@ bool egg::ovum::String::equals(const char* utf8) const {
 
 bool egg::ovum::String::equals(const String& other) const {
   // Ordinal comparison
-  return Memory::equal(this->get(), other.get());
+  auto* lhs = this->get();
+  auto* rhs = other.get();
+  if ((lhs != rhs) && (lhs != nullptr) && (rhs != nullptr)) {
+    auto* pool = MemoryString::from(*lhs).interned();
+    if ((pool != nullptr) && (pool == MemoryString::from(*rhs).interned())) {
+      // Distinct strings interned by the same pool cannot be equal
+      return false;
+    }
+  }
+  return Memory::equal(lhs, rhs);
 }
 
 int64_t egg::ovum::String::hash() const {
-  // See https://docs.oracle.com/javase/6/docs/api/java/lang/String.html#hashCode()
-  int64_t i = 0;
-  auto reader = readerBegin(*this);
-  char32_t codepoint = 0;
-  while (reader.forward(codepoint)) {
-    i = i * 31 + int64_t(uint32_t(codepoint));
+  auto* memory = this->get();
+  if (memory == nullptr) {
+    return 0;
   }
-  return i;
+  return MemoryString::from(*memory).hash();
 }
 
 int64_t egg::ovum::String::compareTo(const String& other) const {
@@ -307,7 +846,15 @@ int64_t egg::ovum::String::compareTo(const String& other) const {
 }
 
 bool egg::ovum::String::contains(const String& needle) const {
-  return this->indexOfString(needle) >= 0;
+  if (needle.empty()) {
+    return true;
+  }
+  auto* haystack = this->get();
+  if (haystack == nullptr) {
+    return false;
+  }
+  // No need to convert the byte offset back to a code point index
+  return searchForward(haystack->begin(), haystack->end(), needle->begin(), needle->bytes()) != nullptr;
 }
 
 bool egg::ovum::String::startsWith(const String& needle) const {
@@ -341,31 +888,25 @@ bool egg::ovum::String::endsWith(const String& needle) const {
 }
 
 int64_t egg::ovum::String::indexOfCodePoint(char32_t codepoint, size_t fromIndex) const {
-  return indexOfCodePointByIteration(*this, codepoint, fromIndex);
+  return indexOfCodePointBySearch(*this, codepoint, fromIndex);
 }
 
 int64_t egg::ovum::String::indexOfString(const String& needle, size_t fromIndex) const {
-  switch (needle.length()) {
-  case 0:
+  if (needle.empty()) {
     return (fromIndex <= this->length()) ? int64_t(fromIndex) : -1;
-  case 1:
-    return indexOfCodePointByIteration(*this, char32_t(needle.codePointAt(0)), fromIndex);
   }
-  return indexOfStringByIteration(*this, needle, fromIndex);
+  return indexOfStringBySearch(*this, needle, fromIndex);
 }
 
 int64_t egg::ovum::String::lastIndexOfCodePoint(char32_t codepoint, size_t fromIndex) const {
-  return lastIndexOfCodePointByIteration(*this, codepoint, fromIndex);
+  return lastIndexOfCodePointBySearch(*this, codepoint, fromIndex);
 }
 
 int64_t egg::ovum::String::lastIndexOfString(const String& needle, size_t fromIndex) const {
-  switch (needle.length()) {
-  case 0:
+  if (needle.empty()) {
     return int64_t(std::min(fromIndex, this->length()));
-  case 1:
-    return lastIndexOfCodePointByIteration(*this, char32_t(needle.codePointAt(0)), fromIndex);
   }
-  return lastIndexOfStringByIteration(*this, needle, fromIndex);
+  return lastIndexOfStringBySearch(*this, needle, fromIndex);
 }
 
 egg::ovum::String egg::ovum::String::replace(IAllocator& allocator, const String& needle, const String& replacement, int64_t occurrences) const {
@@ -411,14 +952,9 @@ egg::ovum::String egg::ovum::String::substring(IAllocator& allocator, size_t beg
     // The whole string
     return *this;
   }
-  auto p = readerIndex(*this, begin);
-  auto q = p;
-  if (!q.skipForward(codepoints)) {
-    // Malformed string
-    throw Exception("Malformed UTF-8 string");
-  }
-  auto bytes = size_t(q.get() - p.get());
-  return String::fromUTF8(allocator, p.get(), bytes, codepoints);
+  auto p = readerIndex(*this, begin).getIterationInternal();
+  auto q = readerIndex(*this, end).getIterationInternal();
+  return fromRange(allocator, *this->get(), p, q - p, codepoints);
 }
 
 egg::ovum::String egg::ovum::String::repeat(IAllocator& allocator, size_t count) const {
@@ -431,11 +967,7 @@ egg::ovum::String egg::ovum::String::repeat(IAllocator& allocator, size_t count)
   case 1:
     return *this;
   }
-  StringBuilder sb;
-  do {
-    sb.add(*this);
-  } while (--count > 0);
-  return sb.build(allocator);
+  return repeatToLength(allocator, *this, this->length() * count, false);
 }
 
 bool egg::ovum::String::empty() const {
@@ -449,7 +981,8 @@ bool egg::ovum::String::lessThan(const String& other) const {
     return !other.empty();
   }
   auto* rhs = other.get();
-  if (rhs == nullptr) {
+  if ((rhs == nullptr) || (rhs == lhs)) {
+    // Includes the same interned string
     return false;
   }
   auto lsize = lhs->bytes();
@@ -487,66 +1020,73 @@ egg::ovum::String egg::ovum::String::join(IAllocator& allocator, const std::vect
   case 1:
     return parts[0];
   }
-  StringBuilder sb;
-  sb.add(parts[0]);
-  auto between = this->toUTF8();
-  for (size_t i = 1; i < n; ++i) {
-    sb.add(between, parts[i]);
+  // Measure first so that the parts can be copied straight into the result
+  size_t bytes = 0;
+  size_t codepoints = 0;
+  for (const auto& part : parts) {
+    if (!part.empty()) {
+      bytes += MemoryString::from(*part).getByteCount();
+      codepoints += part.length();
+    }
+  }
+  const MemoryString* between = nullptr;
+  if (!this->empty()) {
+    between = &MemoryString::from(*this->get());
+    bytes += between->getByteCount() * (n - 1);
+    codepoints += between->getCodePointCount() * (n - 1);
+  }
+  if (bytes == 0) {
+    return String();
+  }
+  auto* memory = MemoryStringContiguous::create(allocator, bytes, codepoints);
+  auto* p = memory->base();
+  for (size_t i = 0; i < n; ++i) {
+    if ((i > 0) && (between != nullptr)) {
+      between->copyTo(p);
+      p += between->getByteCount();
+    }
+    if (!parts[i].empty()) {
+      auto& part = MemoryString::from(*parts[i]);
+      part.copyTo(p);
+      p += part.getByteCount();
+    }
+  }
+  assert(p == memory->base() + bytes);
+  return String(memory);
+}
+
+egg::ovum::String egg::ovum::String::concat(IAllocator& allocator, const String& other) const {
+  if (other.empty()) {
+    return *this;
+  }
+  if (this->empty()) {
+    return other;
   }
-  return sb.build(allocator);
+  return concatenate(allocator, *this, other);
 }
 
 egg::ovum::String egg::ovum::String::padLeft(IAllocator& allocator, size_t target) const {
-  // OPTIMIZE
   const char space = ' ';
   return this->padLeft(allocator, target, String::fromUTF8(allocator, &space, 1, 1));
 }
 
 egg::ovum::String egg::ovum::String::padLeft(IAllocator& allocator, size_t target, const String& padding) const {
-  // OPTIMIZE
   auto current = this->length();
-  auto n = padding.length();
-  if ((n == 0) || (target <= current)) {
+  if (padding.empty() || (target <= current)) {
     return *this;
   }
-  auto extra = target - current;
-  assert(extra > 0);
-  std::string dst;
-  auto utf8 = padding.toUTF8();
-  auto partial = extra % n;
-  if (partial > 0) {
-    dst.assign(egg::ovum::UTF8::offsetOfCodePoint(utf8, n - partial), utf8.cend());
-  }
-  for (auto whole = extra / n; whole > 0; --whole) {
-    dst.append(utf8);
-  }
-  dst.append(this->toUTF8());
-  return String::fromUTF8(allocator, dst.data(), dst.size(), target);
+  return repeatToLength(allocator, padding, target - current, true).concat(allocator, *this);
 }
 
 egg::ovum::String egg::ovum::String::padRight(IAllocator& allocator, size_t target, const String& padding) const {
-  // OPTIMIZE
   auto current = this->length();
-  auto n = padding.length();
-  if ((n == 0) || (target <= current)) {
+  if (padding.empty() || (target <= current)) {
     return *this;
   }
-  auto extra = target - current;
-  assert(extra > 0);
-  auto dst = this->toUTF8();
-  auto utf8 = padding.toUTF8();
-  for (auto whole = extra / n; whole > 0; --whole) {
-    dst.append(utf8);
-  }
-  auto partial = extra % n;
-  if (partial > 0) {
-    dst.append(utf8.cbegin(), egg::ovum::UTF8::offsetOfCodePoint(utf8, partial));
-  }
-  return String::fromUTF8(allocator, dst.data(), dst.size(), target);
+  return this->concat(allocator, repeatToLength(allocator, padding, target - current, false));
 }
 
 egg::ovum::String egg::ovum::String::padRight(IAllocator& allocator, size_t target) const {
-  // OPTIMIZE
   const char space = ' ';
   return this->padRight(allocator, target, String::fromUTF8(allocator, &space, 1, 1));
 }
@@ -560,7 +1100,6 @@ std::string egg::ovum::String::toUTF8() const {
 }
 
 egg::ovum::String egg::ovum::String::fromUTF8(IAllocator& allocator, const void* utf8, size_t bytes, size_t codepoints) {
-  // TODO detect malformed/overlong/etc
   if ((utf8 != nullptr) && (bytes == SIZE_MAX)) {
     bytes = std::strlen(static_cast<const char*>(utf8));
   }
@@ -569,29 +1108,145 @@ egg::ovum::String egg::ovum::String::fromUTF8(IAllocator& allocator, const void*
   }
   auto* data = static_cast<const uint8_t*>(utf8);
   if (codepoints == SIZE_MAX) {
+    // Rejects malformed, truncated, overlong and surrogate sequences
     codepoints = UTF8::measure(data, data + bytes);
   }
   if (codepoints > bytes) {
     throw Exception("Invalid UTF-8 input data");
   }
-  auto* memory = allocator.create<MemoryContiguous>(bytes, allocator, bytes, IMemory::Tag{ codepoints });
-  assert(memory != nullptr);
+  auto* memory = MemoryStringContiguous::create(allocator, bytes, codepoints);
   std::memcpy(memory->base(), data, bytes);
   return String(memory);
 }
 
 egg::ovum::String egg::ovum::String::fromUTF32(IAllocator& allocator, const void* utf32, size_t codepoints) {
-  auto utf8 = egg::ovum::UTF32::toUTF8(static_cast<const char32_t*>(utf32), codepoints);
+  auto* data = static_cast<const char32_t*>(utf32);
+  if ((data != nullptr) && (codepoints == SIZE_MAX)) {
+    codepoints = std::char_traits<char32_t>::length(data);
+  }
+  auto utf8 = egg::ovum::UTF32::toUTF8(data, codepoints);
   return String::fromUTF8(allocator, utf8.data(), utf8.size(), codepoints);
 }
 
-egg::ovum::String egg::ovum::StringBuilder::build(IAllocator& allocator) const {
-  // OPTIMIZE
-  auto utf8 = this->ss.str();
-  return String::fromUTF8(allocator, utf8.data(), utf8.size());
+egg::ovum::HardPtr<egg::ovum::IStringPool> egg::ovum::StringFactory::createStringPool(IAllocator& allocator) {
+  return HardPtr<IStringPool>(allocator.makeRaw<StringPool>(allocator));
+}
+
+egg::ovum::StringBuffer::StringBuffer(IAllocator* allocator)
+  : allocator(allocator), block(nullptr), capacity(0), counted(0), codepoints(0) {
+}
+
+egg::ovum::StringBuffer::~StringBuffer() {
+  if (this->block != nullptr) {
+    deallocateBuffer(this->allocator, this->block);
+  }
+}
+
+egg::ovum::String egg::ovum::StringBuffer::build(IAllocator& allocator) {
+  auto* p = this->pbase();
+  auto bytes = size_t(this->pptr() - p);
+  if (bytes == 0) {
+    return String();
+  }
+  if (!this->built.empty()) {
+    // Nothing has been written since the last hand-over
+    return this->built;
+  }
+  this->count();
+  assert(UTF8::measure(reinterpret_cast<const uint8_t*>(p), reinterpret_cast<const uint8_t*>(p) + bytes) == this->codepoints);
+  if (&allocator != this->allocator) {
+    return String::fromUTF8(allocator, p, bytes, this->codepoints);
+  }
+  // Construct the string header in the space reserved at the front of the block
+  auto* memory = new(this->block) MemoryStringContiguous(allocator, bytes, this->codepoints);
+  assert(memory->begin() == reinterpret_cast<const uint8_t*>(p));
+  this->block = nullptr;
+  this->capacity = 0;
+  this->built = String(memory);
+  // Any further writes will copy the handed-over bytes into a fresh block
+  this->setp(p, p + bytes);
+  this->advance(bytes);
+  return this->built;
+}
+
+void egg::ovum::StringBuffer::clear() {
+  this->built = String();
+  if (this->block != nullptr) {
+    auto* base = static_cast<char*>(this->block) + stringBufferHeader;
+    this->setp(base, base + this->capacity);
+  } else {
+    this->setp(nullptr, nullptr);
+  }
+  this->counted = 0;
+  this->codepoints = 0;
+}
+
+std::streambuf::int_type egg::ovum::StringBuffer::overflow(int_type ch) {
+  if (traits_type::eq_int_type(ch, traits_type::eof())) {
+    return traits_type::not_eof(ch);
+  }
+  this->reserve(1);
+  *this->pptr() = traits_type::to_char_type(ch);
+  this->pbump(1);
+  return ch;
+}
+
+std::streamsize egg::ovum::StringBuffer::xsputn(const char* s, std::streamsize n) {
+  if (n > 0) {
+    this->reserve(size_t(n));
+    std::memcpy(this->pptr(), s, size_t(n));
+    this->advance(size_t(n));
+  }
+  return n;
+}
+
+void egg::ovum::StringBuffer::reserve(size_t extra) {
+  if (size_t(this->epptr() - this->pptr()) >= extra) {
+    return;
+  }
+  // Count as we go so that the bytes are only scanned once
+  this->count();
+  auto* p = this->pbase();
+  auto used = size_t(this->pptr() - p);
+  auto wanted = std::max({ used + extra, this->capacity * 2, stringBufferMinimum });
+  auto* fresh = allocateBuffer(this->allocator, stringBufferHeader + wanted);
+  auto* base = static_cast<char*>(fresh) + stringBufferHeader;
+  if (used > 0) {
+    std::memcpy(base, p, used);
+  }
+  if (this->block != nullptr) {
+    deallocateBuffer(this->allocator, this->block);
+  }
+  this->built = String();
+  this->block = fresh;
+  this->capacity = wanted;
+  this->setp(base, base + wanted);
+  this->advance(used);
+}
+
+void egg::ovum::StringBuffer::advance(size_t bytes) {
+  // 'pbump()' only takes an 'int'
+  while (bytes > size_t(INT_MAX)) {
+    this->pbump(INT_MAX);
+    bytes -= size_t(INT_MAX);
+  }
+  this->pbump(int(bytes));
+}
+
+void egg::ovum::StringBuffer::count() {
+  // Writes via 'sputc()' bypass our overrides, so count lazily
+  auto* p = reinterpret_cast<const uint8_t*>(this->pbase());
+  auto used = size_t(reinterpret_cast<const uint8_t*>(this->pptr()) - p);
+  if (used > this->counted) {
+    this->codepoints += UTF8::count(p + this->counted, p + used);
+    this->counted = used;
+  }
 }
 
 std::ostream& operator<<(std::ostream& os, const egg::ovum::String& text) {
-  // OPTIMIZE
-  return os << text.toUTF8();
+  auto* memory = text.get();
+  if (memory != nullptr) {
+    os.write(reinterpret_cast<const char*>(memory->begin()), std::streamsize(memory->bytes()));
+  }
+  return os;
 }
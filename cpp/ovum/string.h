@@ -12,6 +12,7 @@ namespace egg::ovum {
     // See http://chilliant.blogspot.co.uk/2018/05/egg-strings.html
     size_t length() const;
     int32_t codePointAt(size_t index) const;
+    int32_t codePointNext(size_t& offset) const; // 'offset' is in bytes and is advanced past the code point
     bool equals(const String& other) const;
     int64_t hash() const;
     int64_t compareTo(const String& other) const;
@@ -32,6 +33,7 @@ namespace egg::ovum {
     String slice(IAllocator& allocator, int64_t begin, int64_t end = INT64_MAX) const;
     std::vector<String> split(IAllocator& allocator, const String& separator, int64_t limit = INT64_MAX) const;
     String join(IAllocator& allocator, const std::vector<String>& parts) const;
+    String concat(IAllocator& allocator, const String& other) const; // May share rather than copy the bytes of both
     String padLeft(IAllocator& allocator, size_t target) const;
     String padLeft(IAllocator& allocator, size_t target, const String& padding) const;
     String padRight(IAllocator& allocator, size_t target) const;
@@ -52,14 +54,61 @@ namespace egg::ovum {
     static String fromUTF32(IAllocator& allocator, const void* utf32, size_t codepoints = SIZE_MAX);
   };
 
+  class IStringPool : public IHardAcquireRelease {
+  public:
+    // Interface
+    virtual String intern(const String& value) = 0; // Returns the canonical instance equal to 'value'
+    virtual size_t getStringCount() const = 0;
+  };
+
+  class StringFactory {
+  public:
+    // Distinct strings interned by the same pool are never equal, so comparisons are by address
+    static HardPtr<IStringPool> createStringPool(IAllocator& allocator);
+  };
+
+  class StringBuffer : public std::streambuf {
+    StringBuffer(const StringBuffer&) = delete;
+    StringBuffer& operator=(const StringBuffer&) = delete;
+  private:
+    IAllocator* allocator; // Null if the bytes must always be copied when building
+    void* block; // Room for a string header followed by the bytes written so far (owned unless handed over)
+    size_t capacity;
+    size_t counted; // Bytes already included in 'codepoints'
+    size_t codepoints;
+    String built; // Holds the handed-over block until more bytes are written
+  public:
+    explicit StringBuffer(IAllocator* allocator);
+    virtual ~StringBuffer() override;
+    bool empty() const {
+      return this->pptr() == this->pbase();
+    }
+    std::string toUTF8() const {
+      return std::string(this->pbase(), this->pptr());
+    }
+    String build(IAllocator& allocator);
+    void clear();
+  protected:
+    virtual int_type overflow(int_type ch) override;
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override;
+  private:
+    void reserve(size_t extra);
+    void advance(size_t bytes);
+    void count();
+  };
+
   class StringBuilder : public Printer {
     StringBuilder(const StringBuilder&) = delete;
     StringBuilder& operator=(const StringBuilder&) = delete;
   private:
-    std::stringstream ss;
+    StringBuffer buffer;
+    std::ostream os;
   public:
     explicit StringBuilder(const Print::Options& options = Print::Options::DEFAULT)
-      : Printer(ss, options) {
+      : Printer(os, options), buffer(nullptr), os(&buffer) {
+    }
+    explicit StringBuilder(IAllocator& allocator, const Print::Options& options = Print::Options::DEFAULT)
+      : Printer(os, options), buffer(&allocator), os(&buffer) {
     }
     template<typename T>
     StringBuilder& add(const T& value) {
@@ -71,15 +120,21 @@ namespace egg::ovum {
       return this->add(value).add(std::forward<ARGS>(args)...);
     }
     bool empty() const {
-      return this->ss.rdbuf()->in_avail() == 0;
+      return this->buffer.empty();
+    }
+    void clear() {
+      this->buffer.clear();
     }
     std::string toUTF8() const {
-      return this->ss.str();
+      return this->buffer.toUTF8();
+    }
+    String build(IAllocator& allocator) {
+      // Hands the buffer over without copying if the builder was constructed with the same allocator
+      return this->buffer.build(allocator);
     }
-    String build(IAllocator& allocator) const;
     template<typename... ARGS>
     static String concat(IAllocator& allocator, ARGS&&... args) {
-      StringBuilder sb;
+      StringBuilder sb{ allocator };
       return sb.add(std::forward<ARGS>(args)...).build(allocator);
     }
   };
@@ -101,9 +101,9 @@ namespace egg::test {
     egg::test::Allocator allocator;
     egg::test::Logger logger;
     egg::ovum::HardPtr<egg::ovum::IVM> vm;
-    VM()
-      : allocator(),
-        vm(egg::ovum::VMFactory::createDefault(allocator, logger)) {
+    explicit VM(egg::ovum::VMEngine engine = egg::ovum::VMEngine::TreeWalker, egg::ovum::IAllocator* target = nullptr)
+      : allocator((target == nullptr) ? Allocator::Expectation::AtLeastOneAllocation : Allocator::Expectation::Unknown),
+        vm(egg::ovum::VMFactory::createDefault((target == nullptr) ? allocator : *target, logger, engine)) {
     }
     ~VM() {
       this->vm->shutdown().verify(std::cout);
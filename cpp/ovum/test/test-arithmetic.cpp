@@ -258,7 +258,28 @@ TEST(TestArithmetic, Format) {
   ASSERT_EQ("123456789.123457", format(123456789.123456789, 15));
   ASSERT_EQ("123456789.1234568", format(123456789.123456789, 16));
   ASSERT_EQ("123456789.12345679", format(123456789.123456789, 17));
-  ASSERT_EQ("123456789.123456789", format(123456789.123456789, 18));
+  ASSERT_EQ("123456789.123456791", format(123456789.123456789, 18));
+}
+
+TEST(TestArithmetic, Parse) {
+  double f = 0;
+  const std::string valid = "1.25e+2";
+  ASSERT_TRUE(egg::ovum::Arithmetic::parse(f, valid.data(), valid.data() + valid.size()));
+  ASSERT_EQ(125.0, f);
+  const std::string partial = "1.25x";
+  ASSERT_FALSE(egg::ovum::Arithmetic::parse(f, partial.data(), partial.data() + partial.size()));
+  const std::string huge = "1e999";
+  ASSERT_FALSE(egg::ovum::Arithmetic::parse(f, huge.data(), huge.data() + huge.size()));
+  uint64_t u = 0;
+  const std::string decimal = "18446744073709551615";
+  ASSERT_TRUE(egg::ovum::Arithmetic::parse(u, decimal.data(), decimal.data() + decimal.size()));
+  ASSERT_EQ(UINT64_MAX, u);
+  const std::string overflow = "18446744073709551616";
+  ASSERT_FALSE(egg::ovum::Arithmetic::parse(u, overflow.data(), overflow.data() + overflow.size()));
+  const std::string hexadecimal = "DeadBeef";
+  ASSERT_TRUE(egg::ovum::Arithmetic::parse(u, hexadecimal.data(), hexadecimal.data() + hexadecimal.size(), 16));
+  ASSERT_EQ(0xDEADBEEFu, u);
+  ASSERT_FALSE(egg::ovum::Arithmetic::parse(u, decimal.data(), decimal.data()));
 }
 
 TEST(TestArithmetic, Denormals) {
@@ -189,7 +189,7 @@ TEST(TestEonTokenizer, Identifier) {
 }
 
 TEST(TestEonTokenizer, SequentialOperators) {
-  egg::test::Allocator allocator;
+  egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations };
   EonTokenizerItem item;
   auto tokenizer = createFromString(allocator, "{:-1}");
   ASSERT_EQ(EonTokenizerKind::ObjectStart, tokenizer->next(item));
@@ -71,6 +71,17 @@ TEST(TestGC, Atomic64) {
   ASSERT_EQ(-100, a64.get());
 }
 
+TEST(TestGC, Unsynchronized) {
+  egg::ovum::Unsynchronized<int64_t> u64{ 100 };
+  ASSERT_EQ(100, u64.get());
+  ASSERT_EQ(101, u64.increment());
+  ASSERT_EQ(100, u64.decrement());
+  ASSERT_EQ(100, u64.exchange(1));
+  ASSERT_EQ(0, u64.decrement());
+  u64.set(-1);
+  ASSERT_EQ(-1, u64.get());
+}
+
 TEST(TestGC, Monitor) {
   Monitor monitor;
   ASSERT_EQ("", monitor.read());
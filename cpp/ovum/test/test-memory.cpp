@@ -49,6 +49,86 @@ TEST(TestMemory, AllocatorDefault) {
   allocator.destroy(header);
 }
 
+TEST(TestMemory, AllocatorPool) {
+  egg::ovum::AllocatorPool allocator;
+  egg::ovum::IAllocator::Statistics stats;
+  const size_t align = alignof(std::max_align_t);
+  // Small allocations are rounded up to their size class
+  auto* small = allocator.allocate(24, align);
+  ASSERT_NE(nullptr, small);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(small) % align);
+  ASSERT_TRUE(readWriteTest(small));
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(1u, stats.totalBlocksAllocated);
+  ASSERT_EQ(32u, stats.totalBytesAllocated);
+  ASSERT_EQ(1u, stats.currentBlocksAllocated);
+  ASSERT_EQ(32u, stats.currentBytesAllocated);
+  // Freed blocks are reused by the same size class
+  allocator.deallocate(small, align);
+  ASSERT_EQ(small, allocator.allocate(32, align));
+  allocator.deallocate(small, align);
+  // Large allocations bypass the pool
+  auto* large = allocator.allocate(1000, align);
+  ASSERT_NE(nullptr, large);
+  ASSERT_TRUE(readWriteTest(large));
+  allocator.deallocate(large, align);
+  // Fill more than one page of a single size class
+  std::vector<void*> blocks;
+  for (size_t index = 0; index < 2 * egg::ovum::AllocatorPool::PageBytes / 64; ++index) {
+    blocks.push_back(allocator.allocate(64, align));
+  }
+  ASSERT_EQ(4u, allocator.getPageCount());
+  std::sort(blocks.begin(), blocks.end());
+  ASSERT_EQ(blocks.end(), std::adjacent_find(blocks.begin(), blocks.end()));
+  for (auto* block : blocks) {
+    allocator.deallocate(block, align);
+  }
+  // Empty pages are released, except those still being allocated from
+  ASSERT_EQ(2u, allocator.getPageCount());
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(3u + blocks.size(), stats.totalBlocksAllocated);
+  ASSERT_EQ(0u, stats.currentBlocksAllocated);
+  ASSERT_EQ(0u, stats.currentBytesAllocated);
+}
+
+#if !EGG_SINGLE_THREADED
+TEST(TestMemory, AllocatorPoolForeignThread) {
+  egg::ovum::AllocatorPool allocator;
+  egg::ovum::IAllocator::Statistics stats;
+  const size_t align = alignof(std::max_align_t);
+  std::vector<void*> blocks;
+  for (size_t index = 0; index < egg::ovum::AllocatorPool::PageBytes / 64; ++index) {
+    blocks.push_back(allocator.allocate(64, align));
+  }
+  void* foreign = nullptr;
+  std::thread thread{ [&]() {
+    // Pooled blocks freed here are queued for the owner; allocations here bypass the pool
+    for (auto* block : blocks) {
+      allocator.deallocate(block, align);
+    }
+    foreign = allocator.allocate(64, align);
+  } };
+  thread.join();
+  ASSERT_NE(nullptr, foreign);
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(1u, stats.currentBlocksAllocated);
+  // The owner frees the foreign block and reuses the queued ones once its current page fills
+  allocator.deallocate(foreign, align);
+  ASSERT_EQ(2u, allocator.getPageCount());
+  std::vector<void*> again;
+  for (size_t index = 0; index < egg::ovum::AllocatorPool::PageBytes / 64; ++index) {
+    again.push_back(allocator.allocate(64, align));
+  }
+  ASSERT_EQ(2u, allocator.getPageCount());
+  for (auto* block : again) {
+    allocator.deallocate(block, align);
+  }
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_EQ(0u, stats.currentBlocksAllocated);
+  ASSERT_EQ(0u, stats.currentBytesAllocated);
+}
+#endif
+
 TEST(TestMemory, MemoryEmpty) {
   egg::test::Allocator allocator{ egg::test::Allocator::Expectation::NoAllocations };
   auto empty = egg::ovum::MemoryFactory::createEmpty();
@@ -98,6 +98,25 @@ TEST(TestStreams, StringCharStreamBad) {
   ASSERT_THROW(StringCharStream("\xC0\x01").slurp(text), Exception);
   // Invalid UTF-8 encoding (bad lead byte)
   ASSERT_THROW(StringCharStream("\xFF").slurp(text), Exception);
+  // Invalid UTF-8 encoding (overlong sequence)
+  ASSERT_THROW(StringCharStream("\xC0\x80").slurp(text), Exception);
+  // Invalid UTF-8 encoding (invalid codepoint)
+  ASSERT_THROW(StringCharStream("\xED\xA0\x80").slurp(text), Exception);
+}
+
+TEST(TestStreams, StringCharStreamChunks) {
+  // Sequences that straddle the boundaries between bulk-decoded chunks
+  std::string utf8;
+  for (size_t i = 0; i < 3000; ++i) {
+    utf8 += "\xE2\x82\xAC\xF0\x9F\xA5\x9A";
+  }
+  StringCharStream scs(utf8);
+  std::u32string text;
+  scs.slurp(text);
+  ASSERT_EQ(6000u, text.size());
+  ASSERT_EQ(U'\x20AC', text[4000]);
+  ASSERT_EQ(U'\x1F95A', text[5999]);
+  ASSERT_THROW(StringCharStream(utf8 + "\xE2\x82").slurp(text), Exception);
 }
 
 TEST(TestStreams, FileTextStream) {
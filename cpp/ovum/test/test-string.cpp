@@ -269,6 +269,90 @@ TEST(TestString, LastIndexOfString) {
   ASSERT_EQ(0, allocator.concat("beggar").lastIndexOfString(allocator.concat("beggar")));
 }
 
+TEST(TestString, Search) {
+  egg::test::Allocator allocator;
+  auto beggar = allocator.concat("beggar beggar");
+  // Indices are absolute even when searching from an offset
+  ASSERT_EQ(8, beggar.indexOfString(allocator.concat("egg"), 2));
+  ASSERT_EQ(8, beggar.indexOfString(allocator.concat("egg"), 8));
+  ASSERT_EQ(-1, beggar.indexOfString(allocator.concat("egg"), 9));
+  ASSERT_EQ(9, beggar.indexOfCodePoint(U'g', 4));
+  // Last occurrences may start at 'fromIndex' itself
+  ASSERT_EQ(8, beggar.lastIndexOfString(allocator.concat("egg"), 8));
+  ASSERT_EQ(1, beggar.lastIndexOfString(allocator.concat("egg"), 7));
+  ASSERT_EQ(-1, beggar.lastIndexOfString(allocator.concat("egg"), 0));
+  ASSERT_EQ(3, beggar.lastIndexOfCodePoint(U'g', 3));
+  // Multi-byte code points in long haystacks
+  std::u32string text;
+  for (size_t i = 0; i < 100; ++i) {
+    text += U"e\u00E9\U0001F95A";
+  }
+  text += U"needle\u00E9";
+  text += text;
+  auto haystack = egg::ovum::String::fromUTF32(allocator, text.data(), text.size());
+  auto needle = egg::ovum::String::fromUTF32(allocator, U"needle\u00E9");
+  ASSERT_EQ(300, haystack.indexOfString(needle));
+  ASSERT_EQ(607, haystack.indexOfString(needle, 301));
+  ASSERT_EQ(607, haystack.lastIndexOfString(needle));
+  ASSERT_EQ(300, haystack.lastIndexOfString(needle, 606));
+  ASSERT_EQ(-1, haystack.indexOfString(allocator.concat("needless")));
+  ASSERT_EQ(1, haystack.indexOfCodePoint(U'\u00E9'));
+  ASSERT_EQ(613, haystack.lastIndexOfCodePoint(U'\u00E9'));
+  ASSERT_TRUE(haystack.contains(needle));
+  ASSERT_FALSE(haystack.contains(allocator.concat("needless")));
+  auto split = haystack.split(allocator, needle);
+  ASSERT_EQ(3u, split.size());
+  ASSERT_EQ(300u, split[0].length());
+  ASSERT_EQ(300u, split[1].length());
+  ASSERT_EQ(0u, split[2].length());
+  auto replaced = haystack.replace(allocator, needle, allocator.concat("!"));
+  ASSERT_EQ(602u, replaced.length());
+  ASSERT_EQ(300, replaced.indexOfCodePoint(U'!'));
+  // Adjacent separators
+  split = allocator.concat("x----y").split(allocator, allocator.concat("--"), -5);
+  ASSERT_EQ(3u, split.size());
+  ASSERT_EQ("x", split[0].toUTF8());
+  ASSERT_EQ("", split[1].toUTF8());
+  ASSERT_EQ("y", split[2].toUTF8());
+}
+
+TEST(TestString, Intern) {
+  egg::test::Allocator allocator;
+  auto pool = egg::ovum::StringFactory::createStringPool(allocator);
+  auto a = pool->intern(allocator.concat("alpha"));
+  auto b = pool->intern(allocator.concat("alpha"));
+  auto c = pool->intern(allocator.concat("beta"));
+  ASSERT_EQ(a.get(), b.get());
+  ASSERT_NE(a.get(), c.get());
+  ASSERT_EQ(2u, pool->getStringCount());
+  ASSERT_TRUE(a.equals(b));
+  ASSERT_FALSE(a.equals(c));
+  ASSERT_TRUE(a.equals(allocator.concat("alpha")));
+  ASSERT_TRUE(a.lessThan(c));
+  ASSERT_FALSE(a.lessThan(b));
+  ASSERT_EQ(egg::ovum::String(), pool->intern(egg::ovum::String()));
+  // Strings interned elsewhere are copied
+  auto other = egg::ovum::StringFactory::createStringPool(allocator);
+  auto d = other->intern(a);
+  ASSERT_NE(a.get(), d.get());
+  ASSERT_TRUE(a.equals(d));
+  ASSERT_EQ(d.get(), other->intern(allocator.concat("alpha")).get());
+}
+
+TEST(TestString, Hash) {
+  egg::test::Allocator allocator;
+  ASSERT_EQ(0, egg::ovum::String().hash());
+  auto egg = allocator.concat("egg");
+  int64_t expected = ('e' * 31 + 'g') * 31 + 'g';
+  ASSERT_EQ(expected, egg.hash());
+  ASSERT_EQ(expected, egg.hash()); // Cached
+  ASSERT_EQ(expected, allocator.concat("egg").hash());
+  auto pound = egg::ovum::String::fromUTF32(allocator, U"\u00A3g");
+  ASSERT_EQ(int64_t(0xA3 * 31 + 'g'), pound.hash());
+  std::hash<egg::ovum::String> hasher;
+  ASSERT_EQ(size_t(expected), hasher(egg));
+}
+
 TEST(TestString, Substring) {
   egg::test::Allocator allocator;
 
@@ -300,6 +384,27 @@ TEST(TestString, Substring) {
   ASSERT_EQ("", allocator.concat("egg").substring(allocator, 11, 10).toUTF8());
 }
 
+TEST(TestString, CodePointAt) {
+  egg::test::Allocator allocator;
+  auto ascii = allocator.concat("egg");
+  ASSERT_EQ('e', ascii.codePointAt(0));
+  ASSERT_EQ('g', ascii.codePointAt(2));
+  ASSERT_EQ(-1, ascii.codePointAt(3));
+  // Long enough to build the sparse index
+  std::u32string expected;
+  for (size_t i = 0; i < 100; ++i) {
+    expected += U"e\u00E9\U0001F95A";
+  }
+  auto str = egg::ovum::String::fromUTF32(allocator, expected.data(), expected.size());
+  ASSERT_EQ(expected.size(), str.length());
+  for (size_t i = expected.size(); i-- > 0; ) {
+    ASSERT_EQ(int32_t(expected[i]), str.codePointAt(i));
+  }
+  ASSERT_EQ(-1, str.codePointAt(expected.size()));
+  ASSERT_EQ(str.substring(allocator, 32, 35).toUTF8(), allocator.concat("\U0001F95Ae\u00E9").toUTF8());
+  ASSERT_EQ(str.substring(allocator, 297).toUTF8(), allocator.concat("e\u00E9\U0001F95A").toUTF8());
+}
+
 TEST(TestString, Slice) {
   static const char expected_egg[9][9][4] = {
     { "", "", "e", "eg", "", "e", "eg", "egg", "egg" },
@@ -495,3 +600,92 @@ TEST(TestString, PadRight) {
   ASSERT_EQ("egg", egg.padRight(allocator, 2, pad).toUTF8());
   ASSERT_EQ("egg", egg.padRight(allocator, 0, pad).toUTF8());
 }
+
+TEST(TestString, PadUnicode) {
+  egg::test::Allocator allocator;
+
+  auto egg = allocator.concat("egg");
+  auto pad = allocator.concat("é1€");
+  ASSERT_EQ("1€é1€egg", egg.padLeft(allocator, 8, pad).toUTF8());
+  ASSERT_EQ("eggé1€é1", egg.padRight(allocator, 8, pad).toUTF8());
+  ASSERT_EQ(8u, egg.padLeft(allocator, 8, pad).length());
+  ASSERT_EQ(8u, egg.padRight(allocator, 8, pad).length());
+}
+
+TEST(TestString, Concat) {
+  egg::test::Allocator allocator;
+
+  egg::ovum::String empty;
+  auto abc = allocator.concat("abc");
+  ASSERT_EQ("abc", abc.concat(allocator, empty).toUTF8());
+  ASSERT_EQ("abc", empty.concat(allocator, abc).toUTF8());
+  ASSERT_EQ("abcabc", abc.concat(allocator, abc).toUTF8());
+
+  // Long concatenations share the bytes of both sides until flattened
+  auto big = abc.repeat(allocator, 1000);
+  auto rope = big.concat(allocator, allocator.concat("é")).concat(allocator, big);
+  ASSERT_EQ(6001u, rope.length());
+  ASSERT_EQ(int32_t(0x00E9), rope.codePointAt(3000));
+  ASSERT_EQ(int32_t('c'), rope.codePointAt(6000));
+  ASSERT_EQ(3000, rope.indexOfCodePoint(0x00E9));
+  ASSERT_EQ(big.toUTF8() + "é" + big.toUTF8(), rope.toUTF8());
+  ASSERT_TRUE(rope.substring(allocator, 0, 3000).equals(big));
+  ASSERT_TRUE(rope.substring(allocator, 3001).equals(big));
+
+  // Repeatedly appending short pieces stays linear and bounds the rope depth
+  egg::ovum::String text;
+  std::string expected;
+  for (int i = 0; i < 100000; ++i) {
+    auto piece = allocator.concat(i, ',');
+    text = text.concat(allocator, piece);
+    expected += piece.toUTF8();
+  }
+  ASSERT_EQ(expected.size(), text.length());
+  ASSERT_EQ(expected, text.toUTF8());
+  ASSERT_EQ(egg::ovum::String::fromUTF8(allocator, expected.data(), expected.size()).hash(), text.hash());
+}
+
+TEST(TestString, Shared) {
+  egg::test::Allocator allocator;
+
+  // Long substrings reference the bytes of their parent
+  auto big = allocator.concat("0123456789").repeat(allocator, 100);
+  auto slice = big.substring(allocator, 100, 900);
+  ASSERT_EQ(800u, slice.length());
+  ASSERT_EQ(big->begin() + 100, slice->begin());
+  ASSERT_EQ(big.toUTF8().substr(100, 800), slice.toUTF8());
+
+  // Slices of slices reference the original bytes
+  auto inner = slice.slice(allocator, 5, -5);
+  ASSERT_EQ(790u, inner.length());
+  ASSERT_EQ(big->begin() + 105, inner->begin());
+  ASSERT_TRUE(inner.startsWith(allocator.concat("56789")));
+  ASSERT_TRUE(inner.endsWith(allocator.concat("01234")));
+
+  // Short substrings are copied
+  auto small = big.substring(allocator, 10, 20);
+  ASSERT_EQ("0123456789", small.toUTF8());
+  ASSERT_NE(big->begin() + 10, small->begin());
+
+  // Long substrings that are only a small part of their parent are copied too
+  auto part = big.substring(allocator, 100, 400);
+  ASSERT_EQ(300u, part.length());
+  ASSERT_NE(big->begin() + 100, part->begin());
+  ASSERT_EQ(big.toUTF8().substr(100, 300), part.toUTF8());
+
+  // Slices outlive their parents
+  big = egg::ovum::String();
+  slice = egg::ovum::String();
+  ASSERT_EQ(790u, inner.length());
+  ASSERT_EQ('5', inner.codePointAt(0));
+
+  // Splitting a large document shares only the parts that make up most of it
+  auto line = allocator.concat("x").repeat(allocator, 300);
+  auto document = allocator.concat(line, '\n', line, line, line, '\n', line);
+  auto lines = document.split(allocator, allocator.concat('\n'));
+  ASSERT_EQ(3u, lines.size());
+  ASSERT_NE(document->begin(), lines[0]->begin());
+  ASSERT_EQ(document->begin() + 301, lines[1]->begin());
+  ASSERT_NE(document->begin() + 1202, lines[2]->begin());
+  ASSERT_EQ(document.toUTF8(), allocator.concat('\n').join(allocator, lines).toUTF8());
+}
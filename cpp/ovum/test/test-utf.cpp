@@ -77,3 +77,116 @@ TEST(TestUTF32, toReadable) {
   ASSERT_EQ("U+20AC", egg::ovum::UTF32::toReadable(0x20AC));
   ASSERT_EQ("U+1F95A", egg::ovum::UTF32::toReadable(0x1F95A));
 }
+
+namespace {
+  using Acceleration = egg::ovum::UTF::Acceleration;
+
+  const Acceleration accelerations[] = { Acceleration::Scalar, Acceleration::SSE2, Acceleration::AVX2 };
+
+  class Accelerated {
+    Accelerated(const Accelerated&) = delete;
+    Accelerated& operator=(const Accelerated&) = delete;
+  private:
+    Acceleration previous;
+  public:
+    explicit Accelerated(Acceleration acceleration)
+      : previous(egg::ovum::UTF::setAcceleration(acceleration)) {
+    }
+    ~Accelerated() {
+      egg::ovum::UTF::setAcceleration(this->previous);
+    }
+  };
+
+  size_t measure(const std::string& utf8) {
+    auto p = reinterpret_cast<const uint8_t*>(utf8.data());
+    return egg::ovum::UTF8::measure(p, p + utf8.size());
+  }
+
+  std::string mixed(size_t repeats) {
+    // Mostly ASCII with a sprinkling of longer sequences at varying alignments
+    std::string utf8;
+    for (size_t i = 0; i < repeats; ++i) {
+      utf8 += "The quick brown fox ";
+      utf8.append(i % 7, 'x');
+      utf8 += testCases[2 + i % 4].utf8;
+    }
+    return utf8;
+  }
+}
+
+TEST(TestUTF8, Measure) {
+  for (auto acceleration : accelerations) {
+    Accelerated accelerated{ acceleration };
+    ASSERT_EQ(0u, measure(""));
+    ASSERT_EQ(6u, measure(std::string("\0\x24\xC2\xA3\xE2\x82\xAC\xF0\x9F\xA5\x9A\xF4\x8F\xBF\xBF", 15)));
+    ASSERT_EQ(SIZE_MAX, measure("\x80"));             // Unexpected continuation
+    ASSERT_EQ(SIZE_MAX, measure("\xC2"));             // Truncated
+    ASSERT_EQ(SIZE_MAX, measure("\xC2\x41"));         // Invalid continuation
+    ASSERT_EQ(SIZE_MAX, measure("\xC0\x80"));         // Overlong NUL
+    ASSERT_EQ(SIZE_MAX, measure("\xE0\x80\x80"));     // Overlong three-byte
+    ASSERT_EQ(SIZE_MAX, measure("\xF0\x80\x80\x80")); // Overlong four-byte
+    ASSERT_EQ(SIZE_MAX, measure("\xED\xA0\x80"));     // Surrogate U+D800
+    ASSERT_EQ(SIZE_MAX, measure("\xF4\x90\x80\x80")); // Beyond U+10FFFF
+    ASSERT_EQ(SIZE_MAX, measure("\xFF"));             // Bad lead byte
+    // Errors at the end of long inputs
+    auto utf8 = mixed(100);
+    auto expected = measure(utf8);
+    ASSERT_NE(SIZE_MAX, expected);
+    ASSERT_EQ(SIZE_MAX, measure(utf8 + "\xE2\x82"));
+    ASSERT_EQ(SIZE_MAX, measure(utf8 + "\xED\xBF\xBF" + utf8));
+    ASSERT_EQ(expected * 2 + 1, measure(utf8 + "\xED\x9F\xBF" + utf8));
+  }
+}
+
+TEST(TestUTF8, Accelerations) {
+  // All accelerations must agree with the scalar implementation
+  auto utf8 = mixed(1000);
+  auto p = reinterpret_cast<const uint8_t*>(utf8.data());
+  auto q = p + utf8.size();
+  auto expected = egg::ovum::UTF8::toUTF32(utf8);
+  for (auto acceleration : accelerations) {
+    Accelerated accelerated{ acceleration };
+    ASSERT_EQ(expected.size(), egg::ovum::UTF8::measure(p, q));
+    ASSERT_EQ(expected.size(), egg::ovum::UTF8::count(p, q));
+    std::u32string utf32(utf8.size(), U'\0');
+    utf32.resize(egg::ovum::UTF8::decode(utf32.data(), p, q));
+    ASSERT_EQ(expected, utf32);
+    ASSERT_EQ(utf8, egg::ovum::UTF32::toUTF8(utf32));
+    for (size_t offset = 0; offset < 64; ++offset) {
+      // Corrupt a lead byte at various alignments
+      auto corrupt = utf8;
+      auto lead = corrupt.find('\xE2', offset * 37);
+      corrupt[lead] = '\xC0';
+      ASSERT_EQ(SIZE_MAX, measure(corrupt));
+    }
+  }
+}
+
+TEST(TestUTF8, DISABLED_Benchmark) {
+  // Report the throughput of each acceleration (only those supported by this CPU are distinct)
+  // Run explicitly with '--gtest_also_run_disabled_tests --gtest_filter=TestUTF8.DISABLED_Benchmark' in an optimised build
+  auto utf8 = mixed(100000);
+  auto p = reinterpret_cast<const uint8_t*>(utf8.data());
+  auto q = p + utf8.size();
+  std::u32string utf32(utf8.size(), U'\0');
+  std::string back(utf8.size() * 4, '\0');
+  for (auto acceleration : accelerations) {
+    Accelerated accelerated{ acceleration };
+    auto actual = egg::ovum::UTF::getAcceleration();
+    auto started = std::chrono::steady_clock::now();
+    auto codepoints = egg::ovum::UTF8::measure(p, q);
+    auto measured = std::chrono::steady_clock::now();
+    ASSERT_EQ(codepoints, egg::ovum::UTF8::decode(utf32.data(), p, q));
+    auto decoded = std::chrono::steady_clock::now();
+    ASSERT_EQ(utf8.size(), egg::ovum::UTF32::encode(reinterpret_cast<uint8_t*>(back.data()), utf32.data(), utf32.data() + codepoints));
+    auto encoded = std::chrono::steady_clock::now();
+    auto throughput = [&](auto begin, auto end) {
+      auto seconds = std::chrono::duration<double>(end - begin).count();
+      return (seconds > 0) ? (double(utf8.size()) / seconds / 1000000.0) : 0.0;
+    };
+    std::cout << "[ BENCHMARK] UTF acceleration " << int(actual)
+              << ": measure " << size_t(throughput(started, measured)) << "MB/s"
+              << ", decode " << size_t(throughput(measured, decoded)) << "MB/s"
+              << ", encode " << size_t(throughput(decoded, encoded)) << "MB/s" << std::endl;
+  }
+}
@@ -107,6 +107,41 @@ TEST(TestLang, StringBuilder) {
   ASSERT_FALSE(sb.empty());
 }
 
+TEST(TestLang, StringBuilderHandover) {
+  egg::test::Allocator allocator;
+  egg::ovum::IAllocator::Statistics before{};
+  egg::ovum::IAllocator::Statistics after{};
+  egg::ovum::StringBuilder sb{ allocator };
+  for (int i = 0; i < 1000; ++i) {
+    sb.add(i, "é");
+  }
+  // The buffer is handed over without any further allocation
+  ASSERT_TRUE(allocator.statistics(before));
+  auto built = sb.build(allocator);
+  ASSERT_TRUE(allocator.statistics(after));
+  ASSERT_EQ(before.totalBlocksAllocated, after.totalBlocksAllocated);
+  ASSERT_EQ(sb.toUTF8(), built.toUTF8());
+  ASSERT_EQ(3890u, built.length());
+  ASSERT_EQ(int32_t(0x00E9), built.codePointAt(3889));
+  // Building again without writing returns the same string
+  ASSERT_EQ(built.get(), sb.build(allocator).get());
+  // Writing again copies the handed-over bytes
+  sb.add("!");
+  auto extended = sb.build(allocator);
+  ASSERT_EQ(3891u, extended.length());
+  ASSERT_EQ(3890u, built.length());
+  ASSERT_TRUE(extended.startsWith(built));
+  // Building with a different allocator copies
+  egg::test::Allocator other;
+  sb.clear();
+  ASSERT_TRUE(sb.empty());
+  sb.add("€uro");
+  auto copied = sb.build(other);
+  ASSERT_EQ("€uro", copied.toUTF8());
+  ASSERT_EQ(4u, copied.length());
+  ASSERT_EQ("€uro", sb.build(allocator).toUTF8());
+}
+
 #define TEST_ME(f, m, e) \
   me.fromFloat(f); \
   ASSERT_EQ(m, me.mantissa); \
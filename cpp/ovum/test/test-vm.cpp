@@ -13,6 +13,7 @@
 #define EXPR_CALL(func, ...) mbuilder->glue(mbuilder->exprFunctionCall(func, {}) COMMA(__VA_ARGS__))
 #define EXPR_LITERAL(value) mbuilder->exprLiteral(mbuilder->createHardValue(value), {})
 #define EXPR_LITERAL_VOID() mbuilder->exprLiteral(mbuilder->createHardValueVoid(), {})
+#define EXPR_ARRAY(...) mbuilder->glue(mbuilder->exprArrayConstruct(Type::AnyQ, false, {}) COMMA(__VA_ARGS__))
 #define EXPR_PROP_GET(instance, property) mbuilder->exprPropertyGet(instance, property, {})
 #define EXPR_VAR_GET(symbol) mbuilder->exprVariableGet(mbuilder->createString(symbol), {})
 #define TYPE_LITERAL(primitive) mbuilder->typeLiteral(Type::primitive, {})
@@ -92,6 +93,66 @@ namespace {
     auto retval = buildAndRun(vm, pbuilder, mbuilder);
     ASSERT_EQ(expected, retval->getPrimitiveFlag());
   }
+
+  egg::ovum::IBasket::Policy collectAtEveryPoll() {
+    egg::ovum::IBasket::Policy policy{};
+    policy.bytesAllocated = 0;
+    policy.blocksOwned = 1;
+    policy.blocksGrowth = 0;
+    return policy;
+  }
+
+  egg::ovum::IBasket::Statistics runExpandoCycle(egg::test::VM& vm, const egg::ovum::IBasket::Policy& policy, int live, bool collect) {
+    // Builds a chain of 'live' arrays that stays reachable throughout, then an expando cycle that is dropped
+    vm->getBasket().setPolicy(policy);
+    auto pbuilder = vm->createProgramBuilder();
+    auto mbuilder = pbuilder->createModuleBuilder(pbuilder->createString("test"));
+    // var b = expando();
+    auto& inner = STMT_VAR_DEFINE("b", TYPE_VARQ(), EXPR_CALL(EXPR_VAR_GET("expando")),
+      // a.x = b;
+      STMT_PROP_SET(EXPR_VAR_GET("a"), EXPR_LITERAL("x"), EXPR_VAR_GET("b")),
+      // b.x = a;
+      STMT_PROP_SET(EXPR_VAR_GET("b"), EXPR_LITERAL("x"), EXPR_VAR_GET("a")),
+      // a.y = expando(); -- old-to-young reference taken while a collection may be in progress
+      STMT_PROP_SET(EXPR_VAR_GET("a"), EXPR_LITERAL("y"), EXPR_CALL(EXPR_VAR_GET("expando"))),
+      // a.y.z = 42;
+      STMT_PROP_SET(EXPR_PROP_GET(EXPR_VAR_GET("a"), EXPR_LITERAL("y")), EXPR_LITERAL("z"), EXPR_LITERAL(42)),
+      // print(a.y.z); -- should print '42' because the new object survived
+      STMT_PRINT(EXPR_PROP_GET(EXPR_PROP_GET(EXPR_VAR_GET("a"), EXPR_LITERAL("y")), EXPR_LITERAL("z"))),
+      // a = null;
+      STMT_VAR_SET("a", EXPR_LITERAL(nullptr)),
+      // b = null;
+      STMT_VAR_SET("b", EXPR_LITERAL(nullptr))
+    );
+    if (collect) {
+      // print(collector());
+      mbuilder->appendChild(inner, STMT_PRINT(EXPR_CALL(EXPR_VAR_GET("collector"))));
+    }
+    // var a = expando();
+    auto* outer = &STMT_VAR_DEFINE("a", TYPE_VARQ(), EXPR_CALL(EXPR_VAR_GET("expando")), inner);
+    if (live > 0) {
+      // var heap = null;
+      outer = &STMT_VAR_DEFINE("heap", TYPE_VARQ(), EXPR_LITERAL(nullptr),
+        // var i = 0;
+        STMT_VAR_DEFINE("i", TYPE_VARQ(), EXPR_LITERAL(0),
+          // for (i = 0; i < live; ++i)
+          STMT_FOR_LOOP(
+            STMT_VAR_SET("i", EXPR_LITERAL(0)),
+            EXPR_BINARY(LessThan, EXPR_VAR_GET("i"), EXPR_LITERAL(live)),
+            STMT_VAR_MUTATE("i", Increment, EXPR_LITERAL_VOID()),
+            // heap = [heap];
+            STMT_VAR_SET("heap", EXPR_ARRAY(EXPR_VAR_GET("heap")))
+          ),
+          *outer
+        )
+      );
+    }
+    STMT_ROOT(*outer);
+    buildAndRunSucceeded(vm, *pbuilder, *mbuilder);
+    egg::ovum::IBasket::Statistics stats;
+    EXPECT_TRUE(vm->getBasket().statistics(stats));
+    return stats;
+  }
 }
 
 TEST(TestVM, CreateDefaultInstance) {
@@ -210,6 +271,95 @@ TEST(TestVM, FindManifestation) {
   ASSERT_FALSE(type->isPrimitive());
 }
 
+TEST(TestVM, ObjectShapes) {
+  egg::test::VM vm;
+  auto& shapes = vm->getObjectShapes();
+  auto before = shapes.getShapeCount();
+  ASSERT_GE(before, 1u);
+  auto build = [&vm](const char* first, const char* second) {
+    auto builder = egg::ovum::ObjectFactory::createObjectBuilder(*vm, Type::Object, egg::ovum::Accessability::All);
+    builder->addProperty(vm->createHardValue(first), nullptr, vm->createHardValue(1), egg::ovum::Accessability::All);
+    builder->addProperty(vm->createHardValue(second), nullptr, vm->createHardValue(2), egg::ovum::Accessability::All);
+    return builder->build();
+  };
+  // Objects with the same properties in the same order share shapes
+  auto a = build("alpha", "beta");
+  ASSERT_EQ(before + 2, shapes.getShapeCount());
+  auto b = build("alpha", "beta");
+  ASSERT_EQ(before + 2, shapes.getShapeCount());
+  auto c = build("alpha", "gamma");
+  ASSERT_EQ(before + 3, shapes.getShapeCount());
+  auto d = build("beta", "alpha");
+  ASSERT_EQ(before + 5, shapes.getShapeCount());
+  // Shapes stop branching once they have too many transitions
+  for (auto i = 0; i < 200; ++i) {
+    auto name = "name" + std::to_string(i);
+    (void)build(name.c_str(), "beta");
+  }
+  ASSERT_LE(shapes.getShapeCount(), before + 5 + 2 * 64);
+}
+
+TEST(TestVM, ObjectKeysNotInterned) {
+  egg::test::VM vm;
+  auto& pool = vm->getStringPool();
+  auto before = pool.getStringCount();
+  for (auto i = 0; i < 100; ++i) {
+    auto builder = egg::ovum::ObjectFactory::createObjectBuilder(*vm, Type::Object, egg::ovum::Accessability::All);
+    auto name = "key" + std::to_string(i);
+    builder->addProperty(vm->createHardValue(name.c_str()), nullptr, vm->createHardValue(i), egg::ovum::Accessability::All);
+    (void)builder->build();
+  }
+  // Only the compiler interns names, so run-time keys cannot grow the pool
+  ASSERT_EQ(before, pool.getStringCount());
+}
+
+#if !EGG_SINGLE_THREADED
+TEST(TestVM, ObjectSharedBetweenThreads) {
+  egg::test::VM vm;
+  auto builder = egg::ovum::ObjectFactory::createObjectBuilder(*vm, Type::Object, egg::ovum::Accessability::All);
+  builder->addProperty(vm->createHardValue("alpha"), nullptr, vm->createHardValue(1), egg::ovum::Accessability::All);
+  auto object = builder->build();
+  // Accessed without locking by the creating thread
+  egg::ovum::StringBuilder owned;
+  auto expected = owned.add(object).toUTF8();
+  ASSERT_CONTAINS(expected, "alpha");
+  // The first access from another thread switches to locking
+  std::string shared;
+  std::thread worker{ [&object, &shared]() {
+    egg::ovum::StringBuilder sb;
+    shared = sb.add(object).toUTF8();
+  } };
+  worker.join();
+  ASSERT_EQ(expected, shared);
+  ASSERT_PRINT(expected, object);
+}
+
+TEST(TestVM, ObjectRevokedDuringAccess) {
+  egg::test::VM vm;
+  auto builder = egg::ovum::ObjectFactory::createObjectBuilder(*vm, Type::Object, egg::ovum::Accessability::All);
+  builder->addProperty(vm->createHardValue("alpha"), nullptr, vm->createHardValue(1), egg::ovum::Accessability::All);
+  auto object = builder->build();
+  // The creating thread keeps accessing without locking while another thread revokes its ownership
+  std::atomic<bool> started{ false };
+  std::string shared;
+  std::thread worker{ [&object, &shared, &started]() {
+    while (!started.load()) {
+      std::this_thread::yield();
+    }
+    egg::ovum::StringBuilder sb;
+    shared = sb.add(object).toUTF8();
+  } };
+  std::string owned;
+  for (auto i = 0; i < 1000; ++i) {
+    egg::ovum::StringBuilder sb;
+    owned = sb.add(object).toUTF8();
+    started.store(true);
+  }
+  worker.join();
+  ASSERT_EQ(owned, shared);
+}
+#endif
+
 TEST(TestVM, CreateProgram) {
   egg::test::VM vm;
   auto program = createHelloWorldProgram(vm);
@@ -225,6 +375,16 @@ TEST(TestVM, RunProgram) {
   ASSERT_EQ("hello world\n", vm.logger.logged.str());
 }
 
+TEST(TestVM, RunProgramBytecode) {
+  egg::test::VM vm{ egg::ovum::VMEngine::Bytecode };
+  ASSERT_EQ(egg::ovum::VMEngine::Bytecode, vm->getEngine());
+  auto program = createHelloWorldProgram(vm);
+  auto runner = createRunnerWithPrint(vm, *program);
+  auto retval = runner->run();
+  ASSERT_VALUE(egg::ovum::HardValue::Void, retval);
+  ASSERT_EQ("hello world\n", vm.logger.logged.str());
+}
+
 TEST(TestVM, StepProgram) {
   egg::test::VM vm;
   auto program = createHelloWorldProgram(vm);
@@ -315,6 +475,31 @@ TEST(TestVM, VariableUndeclare) {
   ASSERT_EQ("<ERROR>test: Unknown identifier: 'i'\n", vm.logger.logged.str());
 }
 
+TEST(TestVM, VariableSlotReuse) {
+  egg::test::VM vm;
+  auto pbuilder = vm->createProgramBuilder();
+  auto mbuilder = pbuilder->createModuleBuilder(pbuilder->createString("test"));
+  STMT_ROOT(
+    // var a = 1;
+    STMT_VAR_DEFINE("a", TYPE_VAR(), EXPR_LITERAL(1),
+      // var b = 2;
+      STMT_VAR_DEFINE("b", TYPE_VAR(), EXPR_LITERAL(2),
+        // print(a, b);
+        STMT_PRINT(EXPR_VAR_GET("a"), EXPR_VAR_GET("b"))
+      ),
+      // var c = 3;
+      STMT_VAR_DEFINE("c", TYPE_VAR(), EXPR_LITERAL(3),
+        // print(a, c);
+        STMT_PRINT(EXPR_VAR_GET("a"), EXPR_VAR_GET("c"))
+      ),
+      // print(b);
+      STMT_PRINT(EXPR_VAR_GET("b"))
+    )
+  );
+  buildAndRunFailed(vm, *pbuilder, *mbuilder);
+  ASSERT_EQ("12\n13\n<ERROR>test: Unknown identifier: 'b'\n", vm.logger.logged.str());
+}
+
 TEST(TestVM, VariableDefineNull) {
   egg::test::VM vm;
   auto pbuilder = vm->createProgramBuilder();
@@ -537,6 +722,68 @@ TEST(TestVM, ExpandoCollector) {
   ASSERT_EQ("0\n0\n6\n", vm.logger.logged.str());
 }
 
+TEST(TestVM, ArrayCollector) {
+  egg::test::VM vm;
+  auto pbuilder = vm->createProgramBuilder();
+  auto mbuilder = pbuilder->createModuleBuilder(pbuilder->createString("test"));
+  STMT_ROOT(
+    // var a = expando();
+    STMT_VAR_DEFINE("a", TYPE_VARQ(), EXPR_CALL(EXPR_VAR_GET("expando")),
+      // var b = [a, 1, "two"];
+      STMT_VAR_DEFINE("b", TYPE_VARQ(), EXPR_ARRAY(EXPR_VAR_GET("a"), EXPR_LITERAL(1), EXPR_LITERAL("two")),
+        // a.x = b;
+        STMT_PROP_SET(EXPR_VAR_GET("a"), EXPR_LITERAL("x"), EXPR_VAR_GET("b")),
+        // print(collector()); -- should print '0'
+        STMT_PRINT(EXPR_CALL(EXPR_VAR_GET("collector"))),
+        // a = null;
+        STMT_VAR_SET("a", EXPR_LITERAL(nullptr)),
+        // print(collector()); -- should print '0' because the array keeps the expando alive
+        STMT_PRINT(EXPR_CALL(EXPR_VAR_GET("collector"))),
+        // b = null;
+        STMT_VAR_SET("b", EXPR_LITERAL(nullptr)),
+        // print(collector()); -- should print '4' because the cycle through the array element is reclaimed
+        STMT_PRINT(EXPR_CALL(EXPR_VAR_GET("collector")))
+      )
+    )
+  );
+  buildAndRunSucceeded(vm, *pbuilder, *mbuilder);
+  ASSERT_EQ("0\n0\n4\n", vm.logger.logged.str());
+}
+
+TEST(TestVM, ExpandoCollectorAutomatic) {
+  egg::test::VM vm;
+  auto policy = collectAtEveryPoll();
+  policy.youngCollections = 0;
+  auto stats = runExpandoCycle(vm, policy, 0, true);
+  ASSERT_EQ("42\n0\n", vm.logger.logged.str()); // The cycle has already been collected
+  ASSERT_GT(stats.totalCollections, 1u);
+  ASSERT_GE(stats.totalBlocksReclaimed, 6u);
+  ASSERT_GT(stats.totalBytesReclaimed, 0u);
+}
+
+TEST(TestVM, ExpandoCollectorIncremental) {
+  egg::test::VM vm;
+  auto policy = collectAtEveryPoll();
+  policy.youngCollections = 0;
+  policy.pauseBudget = 1;
+  auto stats = runExpandoCycle(vm, policy, 1024, false);
+  ASSERT_EQ("42\n", vm.logger.logged.str());
+  ASSERT_GT(stats.totalCollections, 0u);
+  ASSERT_EQ(0u, stats.totalYoungCollections);
+  ASSERT_GT(stats.totalPauses, stats.totalCollections); // At least one collection was split into several slices
+  ASSERT_GE(stats.maximumMicrosecondsPaused, stats.lastMicrosecondsPaused);
+}
+
+TEST(TestVM, ExpandoCollectorYoung) {
+  egg::test::VM vm;
+  auto policy = collectAtEveryPoll();
+  policy.youngCollections = UINT64_MAX;
+  auto stats = runExpandoCycle(vm, policy, 0, true);
+  ASSERT_EQ("42\n11\n", vm.logger.logged.str()); // Only full collections reclaim old cycles
+  ASSERT_GT(stats.totalYoungCollections, 1u);
+  ASSERT_EQ(stats.totalYoungCollections + 1, stats.totalCollections);
+}
+
 TEST(TestVM, ExpandoKeys) {
   egg::test::VM vm;
   auto pbuilder = vm->createProgramBuilder();
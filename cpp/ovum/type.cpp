@@ -896,7 +896,7 @@ namespace egg::internal {
         auto builder = this->createTaggableBuilder();
         Print::Options options{};
         options.names = false;
-        StringBuilder sb{ options };
+        StringBuilder sb{ this->allocator, options };
         Type::print(sb, signature);
         builder->setDescription(sb.build(this->allocator), 1);
         shape.taggable = &builder->build();
@@ -1630,7 +1630,7 @@ namespace egg::internal {
     String typeSuffix(const Type& type, const char* suffix) const {
       assert(type.validate());
       assert(suffix != nullptr);
-      StringBuilder sb;
+      StringBuilder sb{ this->allocator };
       auto precedence = type.print(sb);
       if (precedence == 2) {
         // Wrap 'a|b' in parentheses
@@ -1714,7 +1714,7 @@ namespace egg::internal {
         for (const auto& named : this->namedTypes) {
           this->forge->forgeNamedType(infratype, named.first, named.second);
         }
-        StringBuilder sb;
+        StringBuilder sb{ this->forge->getAllocator() };
         infratype.print(sb);
         sb << '.' << metaname;
         this->builder->setDescription(sb.build(this->forge->getAllocator()), 0);
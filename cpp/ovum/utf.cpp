@@ -0,0 +1,468 @@
+#include "ovum/ovum.h"
+#include "ovum/utf.h"
+
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EGG_UTF_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define EGG_UTF_TARGET_AVX2
+#else
+#define EGG_UTF_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define EGG_UTF_X86 0
+#endif
+
+namespace {
+  using namespace egg::ovum;
+
+  // See https://www.unicode.org/versions/Unicode15.0.0/ch03.pdf#G7404 (Table 3-7. Well-Formed UTF-8 Byte Sequences)
+  size_t sequenceStrict(const uint8_t* p, const uint8_t* q) {
+    // Return the length of the well-formed sequence at 'p' or zero
+    assert(p < q);
+    auto remaining = size_t(q - p);
+    auto lead = p[0];
+    if (lead < 0x80) {
+      return 1;
+    }
+    if (lead < 0xC2) {
+      // Continuation byte or overlong two-byte sequence
+      return 0;
+    }
+    if (lead < 0xE0) {
+      return ((remaining >= 2) && ((p[1] & 0xC0) == 0x80)) ? 2 : 0;
+    }
+    if (lead < 0xF0) {
+      if ((remaining < 3) || ((p[2] & 0xC0) != 0x80)) {
+        return 0;
+      }
+      auto lower = (lead == 0xE0) ? 0xA0 : 0x80; // Overlong
+      auto upper = (lead == 0xED) ? 0x9F : 0xBF; // Surrogates
+      return ((p[1] >= lower) && (p[1] <= upper)) ? 3 : 0;
+    }
+    if (lead < 0xF5) {
+      if ((remaining < 4) || ((p[2] & 0xC0) != 0x80) || ((p[3] & 0xC0) != 0x80)) {
+        return 0;
+      }
+      auto lower = (lead == 0xF0) ? 0x90 : 0x80; // Overlong
+      auto upper = (lead == 0xF4) ? 0x8F : 0xBF; // Beyond U+10FFFF
+      return ((p[1] >= lower) && (p[1] <= upper)) ? 4 : 0;
+    }
+    return 0;
+  }
+
+  char32_t decodeSequence(const uint8_t* p, size_t length) {
+    // Decode a sequence already known to be well-formed
+    switch (length) {
+    case 1:
+      return char32_t(p[0]);
+    case 2:
+      return (char32_t(p[0] & 0x1F) << 6) | char32_t(p[1] & 0x3F);
+    case 3:
+      return (char32_t(p[0] & 0x0F) << 12) | (char32_t(p[1] & 0x3F) << 6) | char32_t(p[2] & 0x3F);
+    }
+    assert(length == 4);
+    return (char32_t(p[0] & 0x07) << 18) | (char32_t(p[1] & 0x3F) << 12) | (char32_t(p[2] & 0x3F) << 6) | char32_t(p[3] & 0x3F);
+  }
+
+  size_t encodeCodePoint(uint8_t* target, char32_t utf32) {
+    // See 'UTF32::toUTF8()'
+    assert(utf32 <= 0x10FFFF);
+    if (utf32 < 0x80) {
+      target[0] = uint8_t(utf32);
+      return 1;
+    }
+    if (utf32 < 0x800) {
+      target[0] = uint8_t(0xC0 + (utf32 >> 6));
+      target[1] = uint8_t(0x80 + (utf32 & 0x3F));
+      return 2;
+    }
+    if (utf32 < 0x10000) {
+      target[0] = uint8_t(0xE0 + (utf32 >> 12));
+      target[1] = uint8_t(0x80 + ((utf32 >> 6) & 0x3F));
+      target[2] = uint8_t(0x80 + (utf32 & 0x3F));
+      return 3;
+    }
+    target[0] = uint8_t(0xF0 + (utf32 >> 18));
+    target[1] = uint8_t(0x80 + ((utf32 >> 12) & 0x3F));
+    target[2] = uint8_t(0x80 + ((utf32 >> 6) & 0x3F));
+    target[3] = uint8_t(0x80 + (utf32 & 0x3F));
+    return 4;
+  }
+
+  size_t measureScalar(const uint8_t* p, const uint8_t* q) {
+    size_t count = 0;
+    while (p < q) {
+      auto length = sequenceStrict(p, q);
+      if (length == 0) {
+        return SIZE_MAX;
+      }
+      p += length;
+      count++;
+    }
+    return count;
+  }
+
+  size_t countScalar(const uint8_t* p, const uint8_t* q) {
+    size_t count = 0;
+    while (p < q) {
+      count += size_t((*p++ & 0xC0) != 0x80);
+    }
+    return count;
+  }
+
+  size_t decodeScalar(char32_t* target, const uint8_t* p, const uint8_t* q) {
+    auto* start = target;
+    while (p < q) {
+      auto length = UTF8::sizeFromLeadByte(*p);
+      assert(length <= size_t(q - p));
+      *target++ = decodeSequence(p, length);
+      p += length;
+    }
+    return size_t(target - start);
+  }
+
+  size_t encodeScalar(uint8_t* target, const char32_t* p, const char32_t* q) {
+    auto* start = target;
+    while (p < q) {
+      target += encodeCodePoint(target, *p++);
+    }
+    return size_t(target - start);
+  }
+
+#if EGG_UTF_X86
+  // SSE2 is part of the x86-64 baseline: it skips runs of ASCII sixteen bytes at a time
+  size_t measureSSE2(const uint8_t* p, const uint8_t* q) {
+    size_t count = 0;
+    while (p < q) {
+      if (size_t(q - p) >= 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto mask = unsigned(_mm_movemask_epi8(chunk));
+        if (mask == 0) {
+          p += 16;
+          count += 16;
+          continue;
+        }
+        // Consume the ASCII prefix before dropping to the scalar path
+        auto ascii = size_t(std::countr_zero(mask));
+        p += ascii;
+        count += ascii;
+      }
+      auto length = sequenceStrict(p, q);
+      if (length == 0) {
+        return SIZE_MAX;
+      }
+      p += length;
+      count++;
+    }
+    return count;
+  }
+
+  size_t countSSE2(const uint8_t* p, const uint8_t* q) {
+    // Count the bytes that are not continuation bytes (0x80 to 0xBF are -128 to -65 when signed)
+    size_t count = 0;
+    auto threshold = _mm_set1_epi8(-65);
+    while (size_t(q - p) >= 16) {
+      auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      count += size_t(std::popcount(unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(chunk, threshold)))));
+      p += 16;
+    }
+    return count + countScalar(p, q);
+  }
+
+  size_t decodeSSE2(char32_t* target, const uint8_t* p, const uint8_t* q) {
+    auto* start = target;
+    auto zero = _mm_setzero_si128();
+    while (p < q) {
+      if (size_t(q - p) >= 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if (_mm_movemask_epi8(chunk) == 0) {
+          // Widen sixteen ASCII bytes to sixteen code points
+          auto lo = _mm_unpacklo_epi8(chunk, zero);
+          auto hi = _mm_unpackhi_epi8(chunk, zero);
+          auto* out = reinterpret_cast<__m128i*>(target);
+          _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo, zero));
+          _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+          _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+          _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+          target += 16;
+          p += 16;
+          continue;
+        }
+      }
+      auto length = UTF8::sizeFromLeadByte(*p);
+      assert(length <= size_t(q - p));
+      *target++ = decodeSequence(p, length);
+      p += length;
+    }
+    return size_t(target - start);
+  }
+
+  size_t encodeSSE2(uint8_t* target, const char32_t* p, const char32_t* q) {
+    auto* start = target;
+    auto limit = _mm_set1_epi32(0x80);
+    while (p < q) {
+      if (size_t(q - p) >= 8) {
+        auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4));
+        auto ascii = _mm_and_si128(_mm_cmplt_epi32(a, limit), _mm_cmplt_epi32(b, limit));
+        if (_mm_movemask_epi8(ascii) == 0xFFFF) {
+          // Narrow eight ASCII code points to eight bytes
+          auto words = _mm_packs_epi32(a, b);
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(target), _mm_packus_epi16(words, words));
+          target += 8;
+          p += 8;
+          continue;
+        }
+      }
+      target += encodeCodePoint(target, *p++);
+    }
+    return size_t(target - start);
+  }
+
+  // AVX2 validation after Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte" (2021)
+  // See https://arxiv.org/abs/2010.03090
+  constexpr uint8_t TOO_SHORT = 1 << 0;
+  constexpr uint8_t TOO_LONG = 1 << 1;
+  constexpr uint8_t OVERLONG_3 = 1 << 2;
+  constexpr uint8_t TOO_LARGE = 1 << 3;
+  constexpr uint8_t SURROGATE = 1 << 4;
+  constexpr uint8_t OVERLONG_2 = 1 << 5;
+  constexpr uint8_t TOO_LARGE_1000 = 1 << 6;
+  constexpr uint8_t OVERLONG_4 = 1 << 6;
+  constexpr uint8_t TWO_CONTS = 1 << 7;
+  constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+  EGG_UTF_TARGET_AVX2 __m256i lookup16(__m256i index, const uint8_t (&table)[16]) {
+    auto lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+    return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(lane), index);
+  }
+
+  template<int N>
+  EGG_UTF_TARGET_AVX2 __m256i previous(__m256i input, __m256i prior) {
+    // Shift 'input' right by N bytes across the whole register, pulling bytes in from the end of 'prior'
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prior, input, 0x21), 16 - N);
+  }
+
+  EGG_UTF_TARGET_AVX2 __m256i checkSpecialCases(__m256i input, __m256i prev1) {
+    static const uint8_t byte1High[16] = {
+      // 0_______ ________ <ASCII in byte 1>
+      TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+      // 10______ ________ <continuation in byte 1>
+      TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+      // 1100____ ________ <two byte lead in byte 1>
+      TOO_SHORT | OVERLONG_2,
+      // 1101____ ________ <two byte lead in byte 1>
+      TOO_SHORT,
+      // 1110____ ________ <three byte lead in byte 1>
+      TOO_SHORT | OVERLONG_3 | SURROGATE,
+      // 1111____ ________ <four+ byte lead in byte 1>
+      TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+    };
+    static const uint8_t byte1Low[16] = {
+      CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, // ____0000
+      CARRY | OVERLONG_2, // ____0001
+      CARRY, // ____0010
+      CARRY, // ____0011
+      CARRY | TOO_LARGE, // ____0100
+      CARRY | TOO_LARGE | TOO_LARGE_1000, // ____0101
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, // ____1101
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000
+    };
+    static const uint8_t byte2High[16] = {
+      // ________ 0_______ <ASCII in byte 2>
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      // ________ 1000____
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+      // ________ 1001____
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+      // ________ 101_____
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+      // ________ 11______
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+    };
+    auto nibble = _mm256_set1_epi8(0x0F);
+    auto a = lookup16(_mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble), byte1High);
+    auto b = lookup16(_mm256_and_si256(prev1, nibble), byte1Low);
+    auto c = lookup16(_mm256_and_si256(_mm256_srli_epi16(input, 4), nibble), byte2High);
+    return _mm256_and_si256(_mm256_and_si256(a, b), c);
+  }
+
+  EGG_UTF_TARGET_AVX2 __m256i checkMultibyteLengths(__m256i input, __m256i prior, __m256i special) {
+    // Third and fourth bytes of three- and four-byte sequences must be continuations
+    auto prev2 = previous<2>(input, prior);
+    auto prev3 = previous<3>(input, prior);
+    auto third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+    auto fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+    auto must = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+    return _mm256_xor_si256(must, special);
+  }
+
+  EGG_UTF_TARGET_AVX2 __m256i checkIncomplete(__m256i input) {
+    // Non-zero if the last three bytes start a sequence that runs off the end of the block
+    static const uint8_t maximum[32] = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+    return _mm256_subs_epu8(input, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maximum)));
+  }
+
+  EGG_UTF_TARGET_AVX2 size_t measureAVX2(const uint8_t* p, const uint8_t* q) {
+    auto error = _mm256_setzero_si256();
+    auto prior = _mm256_setzero_si256();
+    auto incomplete = _mm256_setzero_si256();
+    auto threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    uint8_t tail[32];
+    while (p < q) {
+      __m256i input;
+      auto remaining = size_t(q - p);
+      if (remaining >= 32) {
+        input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        p += 32;
+      } else {
+        // Pad the final block with ASCII NULs, which are always valid and never counted twice
+        std::memset(tail, 0, sizeof(tail));
+        std::memcpy(tail, p, remaining);
+        input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail));
+        count -= 32 - remaining;
+        p = q;
+      }
+      if (_mm256_movemask_epi8(input) == 0) {
+        // Pure ASCII block: only a sequence left dangling by the previous block can be an error
+        error = _mm256_or_si256(error, incomplete);
+        count += 32;
+      } else {
+        auto prev1 = previous<1>(input, prior);
+        auto special = checkSpecialCases(input, prev1);
+        error = _mm256_or_si256(error, checkMultibyteLengths(input, prior, special));
+        incomplete = checkIncomplete(input);
+        count += size_t(std::popcount(unsigned(_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, threshold)))));
+      }
+      prior = input;
+    }
+    error = _mm256_or_si256(error, incomplete);
+    if (!_mm256_testz_si256(error, error)) {
+      return SIZE_MAX;
+    }
+    return count;
+  }
+
+  EGG_UTF_TARGET_AVX2 size_t countAVX2(const uint8_t* p, const uint8_t* q) {
+    size_t count = 0;
+    auto threshold = _mm256_set1_epi8(-65);
+    while (size_t(q - p) >= 32) {
+      auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      count += size_t(std::popcount(unsigned(_mm256_movemask_epi8(_mm256_cmpgt_epi8(chunk, threshold)))));
+      p += 32;
+    }
+    return count + countScalar(p, q);
+  }
+
+  bool supportsAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+      return false;
+    }
+    __cpuid(info, 1);
+    auto osxsave = (info[2] & (1 << 27)) != 0;
+    auto avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || ((_xgetbv(0) & 0x6) != 0x6)) {
+      return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+  }
+#endif
+
+  struct Implementation {
+    UTF::Acceleration acceleration;
+    size_t(*measure)(const uint8_t* p, const uint8_t* q);
+    size_t(*count)(const uint8_t* p, const uint8_t* q);
+    size_t(*decode)(char32_t* target, const uint8_t* p, const uint8_t* q);
+    size_t(*encode)(uint8_t* target, const char32_t* p, const char32_t* q);
+  };
+
+  const Implementation implementations[] = {
+    { UTF::Acceleration::Scalar, measureScalar, countScalar, decodeScalar, encodeScalar },
+#if EGG_UTF_X86
+    { UTF::Acceleration::SSE2, measureSSE2, countSSE2, decodeSSE2, encodeSSE2 },
+    // Transcoding stays on the SSE2 loops: wider ASCII runs measured no faster at -O2 and slower on mixed text
+    { UTF::Acceleration::AVX2, measureAVX2, countAVX2, decodeSSE2, encodeSSE2 },
+#endif
+  };
+
+  UTF::Acceleration supportedAcceleration() {
+#if EGG_UTF_X86
+    return supportsAVX2() ? UTF::Acceleration::AVX2 : UTF::Acceleration::SSE2;
+#else
+    return UTF::Acceleration::Scalar;
+#endif
+  }
+
+  const Implementation* selectImplementation(UTF::Acceleration acceleration) {
+    const Implementation* selected = &implementations[0];
+    for (auto& implementation : implementations) {
+      if (implementation.acceleration <= acceleration) {
+        selected = &implementation;
+      }
+    }
+    return selected;
+  }
+
+  std::atomic<const Implementation*>& currentImplementation() {
+    // Chosen once at runtime according to the capabilities of the CPU
+    static std::atomic<const Implementation*> current{ selectImplementation(supportedAcceleration()) };
+    return current;
+  }
+
+  const Implementation& implementation() {
+    return *currentImplementation().load(std::memory_order_relaxed);
+  }
+}
+
+egg::ovum::UTF::Acceleration egg::ovum::UTF::getAcceleration() {
+  return implementation().acceleration;
+}
+
+egg::ovum::UTF::Acceleration egg::ovum::UTF::setAcceleration(Acceleration acceleration) {
+  auto* selected = selectImplementation(std::min(acceleration, supportedAcceleration()));
+  return currentImplementation().exchange(selected)->acceleration;
+}
+
+size_t egg::ovum::UTF8::measure(const uint8_t* p, const uint8_t* q) {
+  assert(p <= q);
+  return implementation().measure(p, q);
+}
+
+size_t egg::ovum::UTF8::count(const uint8_t* p, const uint8_t* q) {
+  assert(p <= q);
+  return implementation().count(p, q);
+}
+
+size_t egg::ovum::UTF8::decode(char32_t* target, const uint8_t* p, const uint8_t* q) {
+  assert(p <= q);
+  return implementation().decode(target, p, q);
+}
+
+size_t egg::ovum::UTF32::encode(uint8_t* target, const char32_t* p, const char32_t* q) {
+  assert(p <= q);
+  return implementation().encode(target, p, q);
+}
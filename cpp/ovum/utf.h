@@ -1,8 +1,23 @@
 #include <iomanip>
 
 namespace egg::ovum {
+  class UTF {
+  public:
+    enum class Acceleration {
+      Scalar, // Portable byte-at-a-time code
+      SSE2,   // 128-bit vectors for runs of ASCII
+      AVX2    // 256-bit vectors including validation (Keiser-Lemire)
+    };
+    // The best acceleration supported by this CPU is selected at start-up
+    static Acceleration getAcceleration();
+    // Clamped to the capabilities of this CPU; returns the previous acceleration
+    static Acceleration setAcceleration(Acceleration acceleration);
+  };
+
   class UTF32 {
   public:
+    // Encode well-formed code points into 'target' (which must hold at least four bytes per code point) returning the byte count
+    static size_t encode(uint8_t* target, const char32_t* p, const char32_t* q);
     template<typename TARGET>
     static void toUTF8(TARGET&& target, char32_t utf32) {
       // See https://en.wikipedia.org/wiki/UTF-8
@@ -32,26 +47,17 @@ namespace egg::ovum {
     static std::string toUTF8(const char32_t* utf32, size_t codepoints) {
       std::string utf8;
       if (utf32 != nullptr) {
-        auto target = std::back_inserter(utf8);
-        if (codepoints < SIZE_MAX) {
-          for (size_t i = 0; i < codepoints; ++i) {
-            UTF32::toUTF8(target, utf32[i]);
-          }
-        } else {
-          while (*utf32 != U'\0') {
-            UTF32::toUTF8(target, *(utf32++));
-          }
+        if (codepoints == SIZE_MAX) {
+          codepoints = std::char_traits<char32_t>::length(utf32);
         }
+        utf8.resize(codepoints * 4);
+        auto bytes = UTF32::encode(reinterpret_cast<uint8_t*>(utf8.data()), utf32, utf32 + codepoints);
+        utf8.resize(bytes);
       }
       return utf8;
     }
     static std::string toUTF8(const std::u32string& utf32) {
-      std::string utf8;
-      auto target = std::back_inserter(utf8);
-      for (auto ch : utf32) {
-        UTF32::toUTF8(target, ch);
-      }
-      return utf8;
+      return UTF32::toUTF8(utf32.data(), utf32.size());
     }
     static std::string toReadable(int ch) {
       std::stringstream oss;
@@ -223,7 +229,7 @@ namespace egg::ovum {
       return count;
     }
     size_t getIterationInternal() const {
-      // Fetch the offset used in egg::ovum::StringIteration::internal
+      // Fetch the byte offset of the current position (see 'String::codePointNext()')
       auto internal = this->p - this->begin;
       assert(internal >= 0);
       return size_t(internal);
@@ -244,11 +250,19 @@ namespace egg::ovum {
       return SIZE_MAX;
     }
     static std::u32string toUTF32(const std::string& utf8) {
-      UTF8 reader(utf8, 0);
+      auto p = reinterpret_cast<const uint8_t*>(utf8.data());
+      auto q = p + utf8.size();
       std::u32string utf32;
-      char32_t codepoint;
-      while (reader.forward(codepoint)) {
-        utf32.push_back(codepoint);
+      if (UTF8::measure(p, q) != SIZE_MAX) {
+        utf32.resize(utf8.size());
+        utf32.resize(UTF8::decode(utf32.data(), p, q));
+      } else {
+        // Decode up to the first malformed sequence
+        UTF8 reader(utf8, 0);
+        char32_t codepoint;
+        while (reader.forward(codepoint)) {
+          utf32.push_back(codepoint);
+        }
       }
       return utf32;
     }
@@ -269,33 +283,12 @@ namespace egg::ovum {
       }
       return q;
     }
-    static size_t measure(const uint8_t* p, const uint8_t* q) {
-      // Return SIZE_MAX if this is not valid UTF-8, otherwise the codepoint count
-      size_t count = 0;
-      while (p < q) {
-        if (*p < 0x80) {
-          // Fast code path for ASCII
-          p++;
-        } else {
-          auto remaining = size_t(q - p);
-          auto length = UTF8::sizeFromLeadByte(*p);
-          if (length > remaining) {
-            // Truncated
-            return SIZE_MAX;
-          }
-          assert(length > 1);
-          for (size_t i = 1; i < length; ++i) {
-            if ((p[i] & 0xC0) != 0x80) {
-              // Bad continuation byte
-              return SIZE_MAX;
-            }
-          }
-          p += length;
-        }
-        count++;
-      }
-      return count;
-    }
+    // Return SIZE_MAX if this is not well-formed UTF-8 (including overlong forms and surrogates), otherwise the codepoint count
+    static size_t measure(const uint8_t* p, const uint8_t* q);
+    // Count the codepoints in UTF-8 that is already known to be well-formed
+    static size_t count(const uint8_t* p, const uint8_t* q);
+    // Decode well-formed UTF-8 into 'target' (which must hold at least one code point per byte) returning the codepoint count
+    static size_t decode(char32_t* target, const uint8_t* p, const uint8_t* q);
   private:
     const uint8_t* before(const uint8_t* after) const {
       if (after > this->begin) {
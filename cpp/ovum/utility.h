@@ -77,6 +77,79 @@ namespace egg::ovum {
     }
   };
 
+  template<typename T>
+  class Unsynchronized {
+    // Drop-in replacement for 'Atomic<T>' when the value never leaves the thread that created it
+    Unsynchronized(Unsynchronized&) = delete;
+    Unsynchronized& operator=(Unsynchronized&) = delete;
+  public:
+    using Underlying = T;
+  private:
+    Underlying value;
+#if !defined(NDEBUG)
+    std::thread::id thread;
+    void confined() const {
+      // Catch the first access from a foreign thread rather than corrupting the value silently
+      assert(this->thread == std::this_thread::get_id());
+    }
+#endif
+  public:
+    explicit Unsynchronized(Underlying value)
+      : value(value)
+#if !defined(NDEBUG)
+      , thread(std::this_thread::get_id())
+#endif
+    {
+    }
+    Underlying get() const {
+#if !defined(NDEBUG)
+      this->confined();
+#endif
+      return this->value;
+    }
+    void set(Underlying desired) {
+#if !defined(NDEBUG)
+      this->confined();
+#endif
+      this->value = desired;
+    }
+    Underlying exchange(Underlying desired) {
+      // Swap the values returning the value BEFORE
+#if !defined(NDEBUG)
+      this->confined();
+#endif
+      return std::exchange(this->value, desired);
+    }
+    Underlying increment() {
+      // The result should be strictly positive
+#if !defined(NDEBUG)
+      this->confined();
+#endif
+      auto result = ++this->value;
+      assert(result > 0);
+      return result;
+    }
+    Underlying decrement() {
+      // The result should not be negative
+#if !defined(NDEBUG)
+      this->confined();
+#endif
+      auto result = --this->value;
+      assert(result >= 0);
+      return result;
+    }
+  };
+
+#if EGG_SINGLE_THREADED
+  // Hard references are only ever manipulated by the thread that owns the VM
+  template<typename T>
+  using HardAtomic = Unsynchronized<T>;
+#else
+  // Hard references may be shared between threads
+  template<typename T>
+  using HardAtomic = Atomic<T>;
+#endif
+
   class Bits {
   public:
     template<typename T>
@@ -71,11 +71,11 @@ namespace egg::internal {
     virtual bool validate() const override {
       return true;
     }
-    virtual bool set(const IValue&) override {
+    virtual bool set(IAllocator&, const IValue&) override {
       // Cannot set an immutable instance
       return false;
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue&) override {
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue&) override {
       // There are very few valid mutation operations on immutables!
       if (op == ValueMutationOp::Noop) {
         return HardValue(*this);
@@ -188,11 +188,12 @@ namespace egg::internal {
     }
   };
 
+  // Integers too large to be held inline in a 'HardValue' word
   class ValueInt final : public ValueMutable {
     ValueInt(const ValueInt&) = delete;
     ValueInt& operator=(const ValueInt&) = delete;
   private:
-    Atomic<Int> value;
+    Int value;
   public:
     ValueInt(IAllocator& allocator, Int value)
       : ValueMutable(allocator), value(value) {
@@ -205,280 +206,18 @@ namespace egg::internal {
       return ValueFlags::Int;
     }
     virtual bool getInt(Int& result) const override {
-      result = this->value.get();
+      result = this->value;
       return true;
     }
     virtual int print(Printer& printer) const override {
-      printer << this->value.get();
+      printer << this->value;
       return 0;
     }
-    virtual bool set(const IValue& rhs) override {
-      Int rvalue;
-      if (rhs.getInt(rvalue)) {
-        this->value.set(rvalue);
-        return true;
-      }
-      return false;
+    virtual bool set(IAllocator&, const IValue& rhs) override {
+      return rhs.getInt(this->value);
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue& rhs) override {
-      Int rvalue;
-      switch (op) {
-      case ValueMutationOp::Assign:
-        if (rhs.getInt(rvalue)) {
-          return this->createBefore(this->value.exchange(rvalue));
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation assignment '=': ", describe(rhs));
-      case ValueMutationOp::Decrement:
-        assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
-        return this->createBefore(this->value.add(-1));
-      case ValueMutationOp::Increment:
-        assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
-        return this->createBefore(this->value.add(+1));
-      case ValueMutationOp::Add:
-        if (rhs.getInt(rvalue)) {
-          return this->createBefore(this->value.add(rvalue));
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation add '+=': ", describe(rhs));
-      case ValueMutationOp::Subtract:
-        if (rhs.getInt(rvalue)) {
-          return this->createBefore(this->value.sub(rvalue));
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation subtract '-=': ", describe(rhs));
-      case ValueMutationOp::Multiply:
-        if (rhs.getInt(rvalue)) {
-          return this->createAtomic([rvalue](Int lvalue) { return lvalue * rvalue; });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation multiply '*=': ", describe(rhs));
-      case ValueMutationOp::Divide:
-        if (rhs.getInt(rvalue)) {
-          if (rvalue == 0) {
-            return this->createRuntimeError("Division by zero in integer mutation divide '/='");
-          }
-          return this->createAtomic([rvalue](Int lvalue) { return lvalue / rvalue; });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation divide '/=': ", describe(rhs));
-      case ValueMutationOp::Remainder:
-        if (rhs.getInt(rvalue)) {
-          if (rvalue == 0) {
-            return this->createRuntimeError("Division by zero in integer mutation remainder '%='");
-          }
-          return this->createAtomic([rvalue](Int lvalue) { return lvalue % rvalue; });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation remainder '%=': ", describe(rhs));
-      case ValueMutationOp::BitwiseAnd:
-        if (rhs.getInt(rvalue)) {
-          return this->createBefore(this->value.bitwiseAnd(rvalue));
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation bitwise-and '&=': ", describe(rhs));
-      case ValueMutationOp::BitwiseOr:
-        if (rhs.getInt(rvalue)) {
-          return this->createBefore(this->value.bitwiseOr(rvalue));
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation bitwise-or '|=': ", describe(rhs));
-      case ValueMutationOp::BitwiseXor:
-        if (rhs.getInt(rvalue)) {
-          return this->createBefore(this->value.bitwiseXor(rvalue));
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation bitwise-xor '^=': ", describe(rhs));
-      case ValueMutationOp::ShiftLeft:
-        if (rhs.getInt(rvalue)) {
-          return this->createAtomic([rvalue](Int lvalue) { return Arithmetic::shift(Arithmetic::Shift::ShiftLeft, lvalue, rvalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation shift left '<<=': ", describe(rhs));
-      case ValueMutationOp::ShiftRight:
-        if (rhs.getInt(rvalue)) {
-          return this->createAtomic([rvalue](Int lvalue) { return Arithmetic::shift(Arithmetic::Shift::ShiftRight, lvalue, rvalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation shift right '>>=': ", describe(rhs));
-      case ValueMutationOp::ShiftRightUnsigned:
-        if (rhs.getInt(rvalue)) {
-          return this->createAtomic([rvalue](Int lvalue) { return Arithmetic::shift(Arithmetic::Shift::ShiftRightUnsigned, lvalue, rvalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation unsigned shift right '>>>=': ", describe(rhs));
-      case ValueMutationOp::Minimum:
-        if (rhs.getInt(rvalue)) {
-          // TODO use processor intrinsic if supported
-          return this->createAtomic([rvalue](Int lvalue) { return Arithmetic::minimum(lvalue, rvalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation minimum '<|=': ", describe(rhs));
-      case ValueMutationOp::Maximum:
-        if (rhs.getInt(rvalue)) {
-          // TODO use processor intrinsic if supported
-          return this->createAtomic([rvalue](Int lvalue) { return Arithmetic::maximum(lvalue, rvalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for integer mutation maximum '>|=': ", describe(rhs));
-      case ValueMutationOp::IfVoid:
-        return this->createBefore(this->value.get());
-      case ValueMutationOp::IfNull:
-        return this->createBefore(this->value.get());
-      case ValueMutationOp::IfFalse:
-        return this->createRuntimeError("Mutation operator '||=' is not supported for integers");
-      case ValueMutationOp::IfTrue:
-        return this->createRuntimeError("Mutation operator '&&=' is not supported for integers");
-      case ValueMutationOp::Noop:
-        assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
-        return this->createBefore(this->value.get());
-      }
-      return this->createRuntimeError("Unknown integer mutation operation");
-    }
-  private:
-    HardValue createAtomic(std::function<Int(Int)> eval) {
-      Int before, after;
-      do {
-        before = this->value.get();
-        after = eval(before);
-      } while (this->value.update(before, after) != before);
-      return ValueFactory::createInt(this->allocator, before);
-    }
-    HardValue createBefore(Int before) {
-      return ValueFactory::createInt(this->allocator, before);
-    }
-  };
-
-  class ValueFloat final : public ValueMutable {
-    ValueFloat(const ValueFloat&) = delete;
-    ValueFloat& operator=(const ValueFloat&) = delete;
-  private:
-    Atomic<Float> value;
-  public:
-    ValueFloat(IAllocator& allocator, Float value)
-      : ValueMutable(allocator), value(value) {
-      assert(this->validate());
-    }
-    virtual Type getRuntimeType() const override {
-      return Type::Float;
-    }
-    virtual ValueFlags getPrimitiveFlag() const override {
-      return ValueFlags::Float;
-    }
-    virtual bool getFloat(Float& result) const override {
-      result = this->value.get();
-      return true;
-    }
-    virtual int print(Printer& printer) const override {
-      printer << this->value.get();
-      return 0;
-    }
-    virtual bool set(const IValue& rhs) override {
-      Float rvalue;
-      if (rhs.getFloat(rvalue)) {
-        this->value.set(rvalue);
-        return true;
-      }
-      return false;
-    }
-    virtual HardValue mutate(ValueMutationOp op, const IValue& rhs) override {
-      Float fvalue;
-      Int ivalue;
-      switch (op) {
-      case ValueMutationOp::Assign:
-        if (rhs.getFloat(fvalue)) {
-          return this->createBefore(this->value.exchange(fvalue));
-        }
-        if (rhs.getInt(ivalue)) {
-          return this->createBefore(this->value.exchange(Float(ivalue)));
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation assignment '=': ", describe(rhs));
-      case ValueMutationOp::Decrement:
-        return this->createRuntimeError("Mutation decrement '--' is not supported for floats");
-      case ValueMutationOp::Increment:
-        return this->createRuntimeError("Mutation increment '++' is not supported for floats");
-      case ValueMutationOp::Add:
-        if (rhs.getFloat(fvalue)) {
-          return this->createBefore(this->value.add(fvalue));
-        }
-        if (rhs.getInt(ivalue)) {
-          return this->createBefore(this->value.add(Float(ivalue)));
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation add '+=': ", describe(rhs));
-      case ValueMutationOp::Subtract:
-        if (rhs.getFloat(fvalue)) {
-          return this->createBefore(this->value.sub(fvalue));
-        }
-        if (rhs.getInt(ivalue)) {
-          return this->createBefore(this->value.sub(Float(ivalue)));
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation subtract '-=': ", describe(rhs));
-      case ValueMutationOp::Multiply:
-        if (rhs.getFloat(fvalue)) {
-          return this->createAtomic([fvalue](Float lvalue) { return lvalue * fvalue; });
-        }
-        if (rhs.getInt(ivalue)) {
-          return this->createAtomic([ivalue](Float lvalue) { return lvalue * Float(ivalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation multiply '*=': ", describe(rhs));
-      case ValueMutationOp::Divide:
-        if (rhs.getFloat(fvalue)) {
-          return this->createAtomic([fvalue](Float lvalue) { return lvalue / fvalue; });
-        }
-        if (rhs.getInt(ivalue)) {
-          // Promote explicitly to guarantee division by zero success
-          return this->createAtomic([ivalue](Float lvalue) { return lvalue / Float(ivalue); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation divide '/=': ", describe(rhs));
-      case ValueMutationOp::Remainder:
-        if (rhs.getFloat(fvalue)) {
-          return this->createAtomic([fvalue](Float lvalue) { return std::fmod(lvalue, fvalue); });
-        }
-        if (rhs.getInt(ivalue)) {
-          // Promote explicitly to guarantee division by zero success
-          return this->createAtomic([ivalue](Float lvalue) { return std::fmod(lvalue, Float(ivalue)); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation remainder '%=': ", describe(rhs));
-      case ValueMutationOp::BitwiseAnd:
-        return this->createRuntimeError("Mutation bitwise-and '&=' is not supported for floats");
-      case ValueMutationOp::BitwiseOr:
-        return this->createRuntimeError("Mutation bitwise-or '|=' is not supported for floats");
-      case ValueMutationOp::BitwiseXor:
-        return this->createRuntimeError("Mutation bitwise-xor '^=' is not supported for floats");
-      case ValueMutationOp::ShiftLeft:
-        return this->createRuntimeError("Mutation shift left '<<=' is not supported for floats");
-      case ValueMutationOp::ShiftRight:
-        return this->createRuntimeError("Mutation shift right '>>=' is not supported for floats");
-      case ValueMutationOp::ShiftRightUnsigned:
-        return this->createRuntimeError("Mutation unsigned shift right '>>>=' is not supported for floats");
-      case ValueMutationOp::Minimum:
-        if (rhs.getFloat(fvalue)) {
-          return this->createAtomic([fvalue](Float lvalue) { return Arithmetic::minimum(lvalue, fvalue, false); });
-        }
-        if (rhs.getInt(ivalue)) {
-          return this->createAtomic([ivalue](Float lvalue) { return Arithmetic::minimum(lvalue, Float(ivalue), false); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation minimum '<|=': ", rhs);
-      case ValueMutationOp::Maximum:
-        if (rhs.getFloat(fvalue)) {
-          return this->createAtomic([fvalue](Float lvalue) { return Arithmetic::maximum(lvalue, fvalue, false); });
-        }
-        if (rhs.getInt(ivalue)) {
-          return this->createAtomic([ivalue](Float lvalue) { return Arithmetic::maximum(lvalue, Float(ivalue), false); });
-        }
-        return this->createRuntimeError("Invalid right-hand value for float mutation minimum '>|=': ", rhs);
-      case ValueMutationOp::IfVoid:
-        return this->createBefore(this->value.get());
-      case ValueMutationOp::IfNull:
-        return this->createBefore(this->value.get());
-      case ValueMutationOp::IfFalse:
-        return this->createRuntimeError("Mutation operator '||=' is not supported for floats");
-      case ValueMutationOp::IfTrue:
-        return this->createRuntimeError("Mutation operator '&&=' is not supported for floats");
-      case ValueMutationOp::Noop:
-        assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
-        return this->createBefore(this->value.get());
-      }
-      return this->createRuntimeError("Unknown float mutation operation");
-    }
-  private:
-    HardValue createAtomic(std::function<Float(Float)> eval) {
-      // Don't use IEEE equality to detect updates
-      Float before, after;
-      do {
-        before = this->value.get();
-        after = eval(before);
-      } while (!Arithmetic::equal(this->value.update(before, after), before, false));
-      return ValueFactory::createFloat(this->allocator, before);
-    }
-    HardValue createBefore(Float before) {
-      return ValueFactory::createFloat(this->allocator, before);
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue& rhs) override {
+      return HardValue::mutateInt(this->allocator, this->value, op, rhs);
     }
   };
 
@@ -510,10 +249,10 @@ namespace egg::internal {
       printer << this->value;
       return 0;
     }
-    virtual bool set(const IValue& rhs) override {
+    virtual bool set(IAllocator&, const IValue& rhs) override {
       return rhs.getString(this->value);
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue& rhs) override {
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue& rhs) override {
       // There are few valid mutation operations on strings
       if (op == ValueMutationOp::Assign) {
         String rvalue;
@@ -558,10 +297,10 @@ namespace egg::internal {
       printer << this->value;
       return 0;
     }
-    virtual bool set(const IValue& rhs) override {
+    virtual bool set(IAllocator&, const IValue& rhs) override {
       return rhs.getHardObject(this->value);
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue& rhs) override {
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue& rhs) override {
       // There are few valid mutation operations on objects
       if (op == ValueMutationOp::Assign) {
         HardObject rvalue;
@@ -612,11 +351,11 @@ namespace egg::internal {
       printer << this->inner;
       return 0;
     }
-    virtual bool set(const IValue&) override {
+    virtual bool set(IAllocator&, const IValue&) override {
       // Flow controls are effectively immutable
       return false;
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue&) override {
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue&) override {
       // There are few valid mutation operations on objects
       if (op == ValueMutationOp::Noop) {
         return HardValue(*this);
@@ -656,11 +395,11 @@ namespace egg::internal {
       printer << this->type;
       return 0;
     }
-    virtual bool set(const IValue&) override {
+    virtual bool set(IAllocator&, const IValue&) override {
       // Types are effectively immutable
       return false;
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue&) override {
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue&) override {
       // There are few valid mutation operations on types
       if (op == ValueMutationOp::Noop) {
         return HardValue(*this);
@@ -843,7 +582,7 @@ namespace egg::internal {
       EGG_WARNING_SUPPRESS_SWITCH_END
       return HardValue::Rethrow;
     }
-    virtual bool set(const IValue& value) override {
+    virtual bool set(IAllocator&, const IValue& value) override {
       // TODO atomic
       assert(this->validate());
       EGG_WARNING_SUPPRESS_SWITCH_BEGIN
@@ -915,6 +654,7 @@ namespace egg::internal {
           assert(instance != nullptr);
           auto* taken = this->basket->take(*instance);
           assert(taken == instance);
+          this->basket->remember(*this);
           this->destroy();
           this->flags = ValueFlags::Object;
           this->ovalue = static_cast<IObject*>(taken);
@@ -927,12 +667,12 @@ namespace egg::internal {
       EGG_WARNING_SUPPRESS_SWITCH_END
       return false;
     }
-    virtual HardValue mutate(ValueMutationOp op, const IValue& rhs) override {
+    virtual HardValue mutate(IAllocator&, ValueMutationOp op, const IValue& rhs) override {
       switch (op) {
       case ValueMutationOp::Assign:
       {
         auto before = this->hardClone();
-        if (this->set(rhs)) {
+        if (this->set(this->allocator, rhs)) {
           return before;
         }
         return this->createRuntimeError("Invalid right-hand value for mutation assignment '=': ", describe(rhs));
@@ -1021,7 +761,7 @@ namespace egg::internal {
       {
         // TODO thread safety
         auto before = this->hardClone();
-        if ((this->flags != ValueFlags::Void) || this->set(rhs)) {
+        if ((this->flags != ValueFlags::Void) || this->set(this->allocator, rhs)) {
           return before;
         }
         return this->createRuntimeError("Invalid right-hand value for mutation '!!=': ", describe(rhs));
@@ -1030,7 +770,7 @@ namespace egg::internal {
         if (!rhs.getVoid()) {
           // TODO thread safety
           auto before = this->hardClone();
-          if ((this->flags != ValueFlags::Null) || this->set(rhs)) {
+          if ((this->flags != ValueFlags::Null) || this->set(this->allocator, rhs)) {
             return before;
           }
         }
@@ -1252,16 +992,24 @@ const egg::ovum::HardValue egg::ovum::HardValue::Break{ theBreak.instance() };
 const egg::ovum::HardValue egg::ovum::HardValue::Continue{ theContinue.instance() };
 const egg::ovum::HardValue egg::ovum::HardValue::Rethrow{ theRethrow.instance() };
 
-egg::ovum::HardValue::HardValue() : ptr(&theVoid) {
+egg::ovum::HardValue::HardValue() : word(HardValue::voidWord()) {
   assert(this->validate());
 }
 
+uint64_t egg::ovum::HardValue::voidWord() {
+  // The void singleton is never reference-counted, so its word needs no acquisition
+  return HardValue::encodePointer(&theVoid);
+}
+
 egg::ovum::HardValue egg::ovum::ValueFactory::createInt(IAllocator& allocator, Int value) {
-  return makeHardValue<ValueInt>(allocator, value);
+  if ((value < HardValue::ImmediateIntMinimum) || (value > HardValue::ImmediateIntMaximum)) {
+    return makeHardValue<ValueInt>(allocator, value);
+  }
+  return HardValue(HardValue::encodeInt(value));
 }
 
-egg::ovum::HardValue egg::ovum::ValueFactory::createFloat(IAllocator& allocator, Float value) {
-  return makeHardValue<ValueFloat>(allocator, value);
+egg::ovum::HardValue egg::ovum::ValueFactory::createFloat(IAllocator&, Float value) {
+  return HardValue(HardValue::encodeFloat(value));
 }
 
 egg::ovum::HardValue egg::ovum::ValueFactory::createString(IAllocator& allocator, const String& value) {
@@ -1315,16 +1063,470 @@ egg::ovum::HardValue egg::ovum::ValueFactory::createStringUTF32(IAllocator& allo
 }
 
 bool egg::ovum::HardValue::validate() const {
-  auto p = this->ptr.get();
-  if (p == nullptr) {
-    return false;
+  auto bits = this->word.get();
+  if (!HardValue::isPointer(bits)) {
+    // Inline ints and floats are always valid
+    return true;
   }
+  auto* p = HardValue::decodePointer(bits);
   if (!validateFlags(p->getPrimitiveFlag())) {
     return false;
   }
   return p->validate();
 }
 
+uint64_t egg::ovum::HardValue::acquire(IValue& value) {
+  auto* acquired = value.hardAcquire();
+  if (acquired != nullptr) {
+    return HardValue::encodePointer(static_cast<IValue*>(acquired));
+  }
+  // Immediate views refuse to be acquired, so copy the word they were built from
+  auto* immediate = dynamic_cast<const Immediate*>(&value);
+  if (immediate == nullptr) {
+    throw InternalException("Hard value cannot acquire a value that refuses to be acquired");
+  }
+  return HardValue::acquire(immediate->getWord());
+}
+
+egg::ovum::HardValue egg::ovum::HardValue::mutate(IAllocator& allocator, ValueMutationOp op, const IValue& rhs) const {
+  auto bits = this->word.get();
+  if (HardValue::isPointer(bits)) {
+    return HardValue::decodePointer(bits)->mutate(allocator, op, rhs);
+  }
+  if (HardValue::isInt(bits)) {
+    auto ivalue = HardValue::decodeInt(bits);
+    auto before = HardValue::mutateInt(allocator, ivalue, op, rhs);
+    this->setInt(allocator, ivalue);
+    return before;
+  }
+  auto fvalue = HardValue::decodeFloat(bits);
+  auto before = HardValue::mutateFloat(allocator, fvalue, op, rhs);
+  this->setFloat(fvalue);
+  return before;
+}
+
+void egg::ovum::HardValue::setInt(IAllocator& allocator, Int value) const {
+  if ((value < ImmediateIntMinimum) || (value > ImmediateIntMaximum)) {
+    auto boxed = ValueFactory::createInt(allocator, value);
+    HardValue::release(this->word.exchange(HardValue::acquire(boxed.word.get())));
+  } else {
+    HardValue::release(this->word.exchange(HardValue::encodeInt(value)));
+  }
+}
+
+void egg::ovum::HardValue::setFloat(Float value) const {
+  HardValue::release(this->word.exchange(HardValue::encodeFloat(value)));
+}
+
+void egg::ovum::HardValue::Immediate::refresh() {
+  // If the owner has just been boxed, we keep presenting the last inline value
+  auto bits = this->owner->word.get();
+  if (!HardValue::isPointer(bits)) {
+    this->word = bits;
+  }
+}
+
+egg::ovum::IHardAcquireRelease* egg::ovum::HardValue::Immediate::hardAcquire() const {
+  // Views cannot be shared, so 'HardValue' copies the word when it sees this
+  return nullptr;
+}
+
+void egg::ovum::HardValue::Immediate::hardRelease() const {
+  // Nothing to release
+}
+
+bool egg::ovum::HardValue::Immediate::validate() const {
+  return (this->owner != nullptr) && !HardValue::isPointer(this->word);
+}
+
+bool egg::ovum::HardValue::Immediate::softIsRoot() const {
+  return true;
+}
+
+egg::ovum::IBasket* egg::ovum::HardValue::Immediate::softGetBasket() const {
+  // We belong to no basket
+  return nullptr;
+}
+
+egg::ovum::ICollectable::SetBasketResult egg::ovum::HardValue::Immediate::softSetBasket(IBasket*) const {
+  // We cannot be added to a basket
+  return ICollectable::SetBasketResult::Exempt;
+}
+
+egg::ovum::ICollectable::Link* egg::ovum::HardValue::Immediate::softGetLink() const {
+  // We cannot be added to a basket
+  return nullptr;
+}
+
+void egg::ovum::HardValue::Immediate::softVisit(ICollectable::IVisitor&) const {
+  // Nothing to visit
+}
+
+int egg::ovum::HardValue::Immediate::print(Printer& printer) const {
+  if (HardValue::isInt(this->word)) {
+    printer << HardValue::decodeInt(this->word);
+  } else {
+    printer << HardValue::decodeFloat(this->word);
+  }
+  return 0;
+}
+
+bool egg::ovum::HardValue::Immediate::getVoid() const {
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getNull() const {
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getBool(Bool&) const {
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getInt(Int& value) const {
+  if (HardValue::isInt(this->word)) {
+    value = HardValue::decodeInt(this->word);
+    return true;
+  }
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getFloat(Float& value) const {
+  if (!HardValue::isInt(this->word)) {
+    value = HardValue::decodeFloat(this->word);
+    return true;
+  }
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getString(String&) const {
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getHardObject(HardObject&) const {
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getHardType(Type&) const {
+  return false;
+}
+
+bool egg::ovum::HardValue::Immediate::getInner(HardValue&) const {
+  return false;
+}
+
+egg::ovum::Type egg::ovum::HardValue::Immediate::getRuntimeType() const {
+  return HardValue::isInt(this->word) ? Type::Int : Type::Float;
+}
+
+egg::ovum::ValueFlags egg::ovum::HardValue::Immediate::getPrimitiveFlag() const {
+  return HardValue::isInt(this->word) ? ValueFlags::Int : ValueFlags::Float;
+}
+
+bool egg::ovum::HardValue::Immediate::set(IAllocator& allocator, const IValue& rhs) {
+  if (HardValue::isInt(this->word)) {
+    Int ivalue;
+    if (!rhs.getInt(ivalue)) {
+      return false;
+    }
+    this->owner->setInt(allocator, ivalue);
+  } else {
+    Float fvalue;
+    if (!rhs.getFloat(fvalue)) {
+      return false;
+    }
+    this->owner->setFloat(fvalue);
+  }
+  this->refresh();
+  return true;
+}
+
+egg::ovum::HardValue egg::ovum::HardValue::Immediate::mutate(IAllocator& allocator, ValueMutationOp op, const IValue& rhs) {
+  auto result = this->owner->mutate(allocator, op, rhs);
+  this->refresh();
+  return result;
+}
+
+egg::ovum::HardValue egg::ovum::HardValue::mutateInt(IAllocator& allocator, Int& ivalue, ValueMutationOp op, const IValue& rhs) {
+  Int rvalue;
+  switch (op) {
+  case ValueMutationOp::Assign:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation assignment '=': ", describe(rhs));
+  case ValueMutationOp::Decrement:
+    assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
+    return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue - 1));
+  case ValueMutationOp::Increment:
+    assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
+    return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue + 1));
+  case ValueMutationOp::Add:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue + rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation add '+=': ", describe(rhs));
+  case ValueMutationOp::Subtract:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue - rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation subtract '-=': ", describe(rhs));
+  case ValueMutationOp::Multiply:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue * rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation multiply '*=': ", describe(rhs));
+  case ValueMutationOp::Divide:
+    if (rhs.getInt(rvalue)) {
+      if (rvalue == 0) {
+        return makeRuntimeError(allocator, "Division by zero in integer mutation divide '/='");
+      }
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue / rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation divide '/=': ", describe(rhs));
+  case ValueMutationOp::Remainder:
+    if (rhs.getInt(rvalue)) {
+      if (rvalue == 0) {
+        return makeRuntimeError(allocator, "Division by zero in integer mutation remainder '%='");
+      }
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue % rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation remainder '%=': ", describe(rhs));
+  case ValueMutationOp::BitwiseAnd:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue & rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation bitwise-and '&=': ", describe(rhs));
+  case ValueMutationOp::BitwiseOr:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue | rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation bitwise-or '|=': ", describe(rhs));
+  case ValueMutationOp::BitwiseXor:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, ivalue ^ rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation bitwise-xor '^=': ", describe(rhs));
+  case ValueMutationOp::ShiftLeft:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, Arithmetic::shift(Arithmetic::Shift::ShiftLeft, ivalue, rvalue)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation shift left '<<=': ", describe(rhs));
+  case ValueMutationOp::ShiftRight:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, Arithmetic::shift(Arithmetic::Shift::ShiftRight, ivalue, rvalue)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation shift right '>>=': ", describe(rhs));
+  case ValueMutationOp::ShiftRightUnsigned:
+    if (rhs.getInt(rvalue)) {
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, Arithmetic::shift(Arithmetic::Shift::ShiftRightUnsigned, ivalue, rvalue)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation unsigned shift right '>>>=': ", describe(rhs));
+  case ValueMutationOp::Minimum:
+    if (rhs.getInt(rvalue)) {
+      // TODO use processor intrinsic if supported
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, Arithmetic::minimum(ivalue, rvalue)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation minimum '<|=': ", describe(rhs));
+  case ValueMutationOp::Maximum:
+    if (rhs.getInt(rvalue)) {
+      // TODO use processor intrinsic if supported
+      return ValueFactory::createInt(allocator, std::exchange(ivalue, Arithmetic::maximum(ivalue, rvalue)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for integer mutation maximum '>|=': ", describe(rhs));
+  case ValueMutationOp::IfVoid:
+    return ValueFactory::createInt(allocator, ivalue);
+  case ValueMutationOp::IfNull:
+    return ValueFactory::createInt(allocator, ivalue);
+  case ValueMutationOp::IfFalse:
+    return makeRuntimeError(allocator, "Mutation operator '||=' is not supported for integers");
+  case ValueMutationOp::IfTrue:
+    return makeRuntimeError(allocator, "Mutation operator '&&=' is not supported for integers");
+  case ValueMutationOp::Noop:
+    assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
+    return ValueFactory::createInt(allocator, ivalue);
+  }
+  return makeRuntimeError(allocator, "Unknown integer mutation operation");
+}
+
+egg::ovum::HardValue egg::ovum::HardValue::mutateFloat(IAllocator& allocator, Float& fvalue, ValueMutationOp op, const IValue& rhs) {
+  Float rfloat;
+  Int rint;
+  switch (op) {
+  case ValueMutationOp::Assign:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, rfloat));
+    }
+    if (rhs.getInt(rint)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, Float(rint)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation assignment '=': ", describe(rhs));
+  case ValueMutationOp::Decrement:
+    return makeRuntimeError(allocator, "Mutation decrement '--' is not supported for floats");
+  case ValueMutationOp::Increment:
+    return makeRuntimeError(allocator, "Mutation increment '++' is not supported for floats");
+  case ValueMutationOp::Add:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue + rfloat));
+    }
+    if (rhs.getInt(rint)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue + Float(rint)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation add '+=': ", describe(rhs));
+  case ValueMutationOp::Subtract:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue - rfloat));
+    }
+    if (rhs.getInt(rint)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue - Float(rint)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation subtract '-=': ", describe(rhs));
+  case ValueMutationOp::Multiply:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue * rfloat));
+    }
+    if (rhs.getInt(rint)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue * Float(rint)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation multiply '*=': ", describe(rhs));
+  case ValueMutationOp::Divide:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue / rfloat));
+    }
+    if (rhs.getInt(rint)) {
+      // Promote explicitly to guarantee division by zero success
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, fvalue / Float(rint)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation divide '/=': ", describe(rhs));
+  case ValueMutationOp::Remainder:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, std::fmod(fvalue, rfloat)));
+    }
+    if (rhs.getInt(rint)) {
+      // Promote explicitly to guarantee division by zero success
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, std::fmod(fvalue, Float(rint))));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation remainder '%=': ", describe(rhs));
+  case ValueMutationOp::BitwiseAnd:
+    return makeRuntimeError(allocator, "Mutation bitwise-and '&=' is not supported for floats");
+  case ValueMutationOp::BitwiseOr:
+    return makeRuntimeError(allocator, "Mutation bitwise-or '|=' is not supported for floats");
+  case ValueMutationOp::BitwiseXor:
+    return makeRuntimeError(allocator, "Mutation bitwise-xor '^=' is not supported for floats");
+  case ValueMutationOp::ShiftLeft:
+    return makeRuntimeError(allocator, "Mutation shift left '<<=' is not supported for floats");
+  case ValueMutationOp::ShiftRight:
+    return makeRuntimeError(allocator, "Mutation shift right '>>=' is not supported for floats");
+  case ValueMutationOp::ShiftRightUnsigned:
+    return makeRuntimeError(allocator, "Mutation unsigned shift right '>>>=' is not supported for floats");
+  case ValueMutationOp::Minimum:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, Arithmetic::minimum(fvalue, rfloat, false)));
+    }
+    if (rhs.getInt(rint)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, Arithmetic::minimum(fvalue, Float(rint), false)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation minimum '<|=': ", rhs);
+  case ValueMutationOp::Maximum:
+    if (rhs.getFloat(rfloat)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, Arithmetic::maximum(fvalue, rfloat, false)));
+    }
+    if (rhs.getInt(rint)) {
+      return ValueFactory::createFloat(allocator, std::exchange(fvalue, Arithmetic::maximum(fvalue, Float(rint), false)));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for float mutation minimum '>|=': ", rhs);
+  case ValueMutationOp::IfVoid:
+    return ValueFactory::createFloat(allocator, fvalue);
+  case ValueMutationOp::IfNull:
+    return ValueFactory::createFloat(allocator, fvalue);
+  case ValueMutationOp::IfFalse:
+    return makeRuntimeError(allocator, "Mutation operator '||=' is not supported for floats");
+  case ValueMutationOp::IfTrue:
+    return makeRuntimeError(allocator, "Mutation operator '&&=' is not supported for floats");
+  case ValueMutationOp::Noop:
+    assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
+    return ValueFactory::createFloat(allocator, fvalue);
+  }
+  return makeRuntimeError(allocator, "Unknown float mutation operation");
+}
+
+egg::ovum::HardValue egg::ovum::HardValue::mutateBool(IAllocator& allocator, Bool& bvalue, ValueMutationOp op, const IValue& rhs) {
+  Bool rvalue;
+  switch (op) {
+  case ValueMutationOp::Assign:
+    if (rhs.getBool(rvalue)) {
+      return ValueFactory::createBool(std::exchange(bvalue, rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for boolean mutation assignment '=': ", describe(rhs));
+  case ValueMutationOp::Decrement:
+    return makeRuntimeError(allocator, "Mutation decrement '--' is not supported for booleans");
+  case ValueMutationOp::Increment:
+    return makeRuntimeError(allocator, "Mutation increment '++' is not supported for booleans");
+  case ValueMutationOp::Add:
+    return makeRuntimeError(allocator, "Mutation add '+=' is not supported for booleans");
+  case ValueMutationOp::Subtract:
+    return makeRuntimeError(allocator, "Mutation subtract '-=' is not supported for booleans");
+  case ValueMutationOp::Multiply:
+    return makeRuntimeError(allocator, "Mutation multiply '*=' is not supported for booleans");
+  case ValueMutationOp::Divide:
+    return makeRuntimeError(allocator, "Mutation divide '/=' is not supported for booleans");
+  case ValueMutationOp::Remainder:
+    return makeRuntimeError(allocator, "Mutation remainder '%=' is not supported for booleans");
+  case ValueMutationOp::BitwiseAnd:
+    if (rhs.getBool(rvalue)) {
+      return ValueFactory::createBool(std::exchange(bvalue, bvalue && rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for boolean mutation bitwise-and '&=': ", describe(rhs));
+  case ValueMutationOp::BitwiseOr:
+    if (rhs.getBool(rvalue)) {
+      return ValueFactory::createBool(std::exchange(bvalue, bvalue || rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for boolean mutation bitwise-or '|=': ", describe(rhs));
+  case ValueMutationOp::BitwiseXor:
+    if (rhs.getBool(rvalue)) {
+      return ValueFactory::createBool(std::exchange(bvalue, bvalue != rvalue));
+    }
+    return makeRuntimeError(allocator, "Invalid right-hand value for boolean mutation bitwise-xor '^=': ", describe(rhs));
+  case ValueMutationOp::ShiftLeft:
+    return makeRuntimeError(allocator, "Mutation shift left '<<=' is not supported for booleans");
+  case ValueMutationOp::ShiftRight:
+    return makeRuntimeError(allocator, "Mutation shift right '>>=' is not supported for booleans");
+  case ValueMutationOp::ShiftRightUnsigned:
+    return makeRuntimeError(allocator, "Mutation unsigned shift right '>>>=' is not supported for booleans");
+  case ValueMutationOp::Minimum:
+    return makeRuntimeError(allocator, "Mutation minimum '<|=' is not supported for booleans");
+  case ValueMutationOp::Maximum:
+    return makeRuntimeError(allocator, "Mutation maximum '>|=' is not supported for booleans");
+  case ValueMutationOp::IfVoid:
+    return ValueFactory::createBool(bvalue);
+  case ValueMutationOp::IfNull:
+    return ValueFactory::createBool(bvalue);
+  case ValueMutationOp::IfFalse:
+    // The right-hand side is only inspected if it could change the outcome
+    if (!bvalue) {
+      if (!rhs.getBool(rvalue)) {
+        return makeRuntimeError(allocator, "Invalid right-hand value for boolean mutation '||=': ", describe(rhs));
+      }
+      bvalue = rvalue;
+      return ValueFactory::createBool(false);
+    }
+    return ValueFactory::createBool(true);
+  case ValueMutationOp::IfTrue:
+    if (bvalue) {
+      if (!rhs.getBool(rvalue)) {
+        return makeRuntimeError(allocator, "Invalid right-hand value for boolean mutation '&&=': ", describe(rhs));
+      }
+      bvalue = rvalue;
+      return ValueFactory::createBool(true);
+    }
+    return ValueFactory::createBool(false);
+  case ValueMutationOp::Noop:
+    assert(rhs.getPrimitiveFlag() == ValueFlags::Void);
+    return ValueFactory::createBool(bvalue);
+  }
+  return makeRuntimeError(allocator, "Unknown boolean mutation operation");
+}
+
 egg::ovum::SoftKey::SoftKey(const SoftKey& value)
   : ptr(value.ptr) {
   assert(this->validate());
@@ -1430,6 +1632,18 @@ egg::ovum::SoftValue::SoftValue(IVM& vm, const HardValue& init)
   assert(this->validate());
 }
 
+egg::ovum::SoftValue::SoftValue(SoftValue&& value) noexcept
+  : ptr(value.ptr.get()) {
+  // The soft instance is owned by the basket, so both copies may safely refer to it
+  assert(this->validate());
+}
+
+egg::ovum::SoftValue& egg::ovum::SoftValue::operator=(SoftValue&& value) noexcept {
+  this->ptr.ptr = value.ptr.ptr;
+  assert(this->validate());
+  return *this;
+}
+
 bool egg::ovum::SoftValue::validate() const {
   auto p = this->ptr.get();
   if (p == nullptr) {
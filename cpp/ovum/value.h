@@ -14,30 +14,117 @@ namespace egg::ovum {
     virtual Type getRuntimeType() const = 0;
     virtual ValueFlags getPrimitiveFlag() const = 0;
     virtual bool validate() const = 0;
-    virtual bool set(const IValue& rhs) = 0;
-    virtual HardValue mutate(ValueMutationOp op, const IValue& value) = 0;
+    // Immediates have no allocator of their own, so errors and boxed results come from the one given
+    virtual bool set(IAllocator& allocator, const IValue& rhs) = 0;
+    virtual HardValue mutate(IAllocator& allocator, ValueMutationOp op, const IValue& value) = 0;
   };
 
   class HardValue {
+    friend class ValueFactory;
+  public:
+    // Ints that fit in this range are held inline; larger ones are boxed on the heap
+    static constexpr Int ImmediateIntMinimum = -0x0002000000000000;
+    static constexpr Int ImmediateIntMaximum = +0x0001FFFFFFFFFFFF;
   private:
-    HardPtr<IValue> ptr;
+    // The word is NaN-boxed: floats are held verbatim (with NaNs canonicalized) so any word whose
+    // sign, exponent and quiet bits are all set holds either an inline int or a hard IValue pointer
+    static constexpr uint64_t BoxedBits = 0xFFF8000000000000;
+    static constexpr uint64_t IntBit = 0x0004000000000000;
+    static constexpr uint64_t IntMask = 0x0003FFFFFFFFFFFF;
+    static constexpr uint64_t PointerMask = 0x0000FFFFFFFFFFFF;
+    static constexpr uint64_t CanonicalNaN = 0x7FF8000000000000;
+    mutable HardAtomic<uint64_t> word; // Mutable so that immediates can be mutated through const views
   public:
+    // A transient IValue built on demand for an inline int or float; mutations are written back to the owner
+    class Immediate final : public IValue {
+      Immediate(const Immediate&) = delete;
+      Immediate& operator=(const Immediate&) = delete;
+    private:
+      const HardValue* owner;
+      uint64_t word;
+    public:
+      Immediate() : owner(nullptr), word(0) {}
+      void bind(const HardValue& value, uint64_t bits) {
+        this->owner = &value;
+        this->word = bits;
+      }
+      uint64_t getWord() const {
+        return this->word;
+      }
+      void refresh();
+      virtual IHardAcquireRelease* hardAcquire() const override;
+      virtual void hardRelease() const override;
+      virtual bool validate() const override;
+      virtual bool softIsRoot() const override;
+      virtual IBasket* softGetBasket() const override;
+      virtual SetBasketResult softSetBasket(IBasket* desired) const override;
+      virtual Link* softGetLink() const override;
+      virtual void softVisit(ICollectable::IVisitor& visitor) const override;
+      virtual int print(Printer& printer) const override;
+      virtual bool getVoid() const override;
+      virtual bool getNull() const override;
+      virtual bool getBool(Bool& value) const override;
+      virtual bool getInt(Int& value) const override;
+      virtual bool getFloat(Float& value) const override;
+      virtual bool getString(String& value) const override;
+      virtual bool getHardObject(HardObject& value) const override;
+      virtual bool getHardType(Type& value) const override;
+      virtual bool getInner(HardValue& inner) const override;
+      virtual Type getRuntimeType() const override;
+      virtual ValueFlags getPrimitiveFlag() const override;
+      virtual bool set(IAllocator& allocator, const IValue& rhs) override;
+      virtual HardValue mutate(IAllocator& allocator, ValueMutationOp op, const IValue& value) override;
+    };
+    // What 'get()' returns: only valid until the end of the full expression that created it
+    class View {
+      View(const View&) = delete;
+      View& operator=(const View&) = delete;
+    private:
+      IValue* ptr;
+      Immediate immediate;
+    public:
+      View(const HardValue& value, uint64_t bits) {
+        if (HardValue::isPointer(bits)) {
+          this->ptr = HardValue::decodePointer(bits);
+        } else {
+          this->immediate.bind(value, bits);
+          this->ptr = &this->immediate;
+        }
+        assert(this->ptr->validate());
+      }
+      IValue* operator->() const {
+        return this->ptr;
+      }
+      IValue& operator*() const {
+        return *this->ptr;
+      }
+      operator IValue&() const {
+        return *this->ptr;
+      }
+      IValue* operator&() const {
+        // The view stands in for the value, so its address is that of the value
+        return this->ptr;
+      }
+    };
     // Construction/destruction
     HardValue();
-    HardValue(const HardValue& rhs) : ptr(rhs.ptr) {
+    HardValue(const HardValue& rhs) : word(HardValue::acquire(rhs.word.get())) {
       assert(this->validate());
     }
-    HardValue(HardValue&& rhs) noexcept : ptr(std::move(rhs.ptr)) {
+    HardValue(HardValue&& rhs) noexcept : word(rhs.word.exchange(HardValue::voidWord())) {
       assert(this->validate());
     }
-    explicit HardValue(IValue& rhs) : ptr(&rhs) {
+    explicit HardValue(IValue& rhs) : word(HardValue::acquire(rhs)) {
       assert(this->validate());
     }
+    ~HardValue() {
+      HardValue::release(this->word.get());
+    }
     // Atomic assignment
     HardValue& operator=(const HardValue& rhs) {
       assert(this->validate());
       assert(rhs.validate());
-      this->ptr = rhs.ptr;
+      HardValue::release(this->word.exchange(HardValue::acquire(rhs.word.get())));
       assert(this->validate());
       return *this;
     }
@@ -45,25 +132,38 @@ namespace egg::ovum {
       assert(this != &rhs);
       assert(this->validate());
       assert(rhs.validate());
-      this->ptr = std::move(rhs.ptr);
+      HardValue::release(this->word.exchange(rhs.word.exchange(HardValue::voidWord())));
       assert(this->validate());
       return *this;
     }
     // Atomic access
-    IValue& get() const {
-      auto p = this->ptr.get();
-      assert(p != nullptr);
-      assert(p->validate());
-      return *p;
+    View get() const {
+      return View(*this, this->word.get());
     }
-    IValue* operator->() const {
-      return &this->get();
+    View operator->() const {
+      return View(*this, this->word.get());
     }
+    // Mutation that reports errors and boxes large results via the given allocator
+    HardValue mutate(IAllocator& allocator, ValueMutationOp op, const IValue& rhs) const;
+    // Scalar mutations shared by inline and boxed values; these return the value before the mutation
+    static HardValue mutateInt(IAllocator& allocator, Int& ivalue, ValueMutationOp op, const IValue& rhs);
+    static HardValue mutateFloat(IAllocator& allocator, Float& fvalue, ValueMutationOp op, const IValue& rhs);
+    static HardValue mutateBool(IAllocator& allocator, Bool& bvalue, ValueMutationOp op, const IValue& rhs);
     // Debugging
     bool validate() const;
     // Helpers
+    bool isImmediate() const {
+      return !HardValue::isPointer(this->word.get());
+    }
+    ValueFlags getPrimitiveFlag() const {
+      auto bits = this->word.get();
+      if (HardValue::isPointer(bits)) {
+        return HardValue::decodePointer(bits)->getPrimitiveFlag();
+      }
+      return HardValue::isInt(bits) ? ValueFlags::Int : ValueFlags::Float;
+    }
     bool hasAnyFlags(ValueFlags flags) const {
-      return Bits::hasAnySet(this->get().getPrimitiveFlag(), flags);
+      return Bits::hasAnySet(this->getPrimitiveFlag(), flags);
     }
     bool hasFlowControl() const {
       return this->hasAnyFlags(ValueFlags::FlowControl);
@@ -76,6 +176,53 @@ namespace egg::ovum {
     static const HardValue Break;
     static const HardValue Continue;
     static const HardValue Rethrow;
+  private:
+    explicit HardValue(uint64_t bits) : word(bits) {
+      assert(this->validate());
+    }
+    static uint64_t voidWord();
+    static bool isPointer(uint64_t bits) {
+      return (bits & (BoxedBits | IntBit)) == BoxedBits;
+    }
+    static bool isInt(uint64_t bits) {
+      return (bits & (BoxedBits | IntBit)) == (BoxedBits | IntBit);
+    }
+    static IValue* decodePointer(uint64_t bits) {
+      return reinterpret_cast<IValue*>(uintptr_t(bits & PointerMask));
+    }
+    static uint64_t encodePointer(const IValue* ptr) {
+      auto bits = uint64_t(reinterpret_cast<uintptr_t>(ptr));
+      assert((bits & ~PointerMask) == 0);
+      return bits | BoxedBits;
+    }
+    static Int decodeInt(uint64_t bits) {
+      // Sign-extend the fifty-bit payload
+      return Int(bits << 14) >> 14;
+    }
+    static uint64_t encodeInt(Int value) {
+      assert((value >= ImmediateIntMinimum) && (value <= ImmediateIntMaximum));
+      return (uint64_t(value) & IntMask) | BoxedBits | IntBit;
+    }
+    static Float decodeFloat(uint64_t bits) {
+      return std::bit_cast<Float>(bits);
+    }
+    static uint64_t encodeFloat(Float value) {
+      return std::isnan(value) ? CanonicalNaN : std::bit_cast<uint64_t>(value);
+    }
+    static uint64_t acquire(uint64_t bits) {
+      if (HardValue::isPointer(bits)) {
+        (void)HardValue::decodePointer(bits)->hardAcquire();
+      }
+      return bits;
+    }
+    static uint64_t acquire(IValue& value);
+    static void release(uint64_t bits) {
+      if (HardValue::isPointer(bits)) {
+        HardValue::decodePointer(bits)->hardRelease();
+      }
+    }
+    void setInt(IAllocator& allocator, Int value) const;
+    void setFloat(Float value) const;
   };
 
   class SoftKey {
@@ -118,6 +265,8 @@ namespace egg::ovum {
     // Construction
     explicit SoftValue(IVM& vm);
     SoftValue(IVM& vm, const HardValue& init);
+    SoftValue(SoftValue&& value) noexcept;
+    SoftValue& operator=(SoftValue&& value) noexcept;
     // Atomic access
     IValue& get() const {
       auto p = this->ptr.get();
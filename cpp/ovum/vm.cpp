@@ -1,20 +1,135 @@
 #include "ovum/ovum.h"
 #include "ovum/operation.h"
 
+#include <cstddef>
 #include <deque>
 #include <stack>
 
 namespace {
+  class VMBytecode;
   class VMModule;
   class VMRunner;
+
+  class VMModuleArena {
+    // Bump allocator for module nodes and their child arrays; everything is released in one go when the module dies
+    VMModuleArena(const VMModuleArena&) = delete;
+    VMModuleArena& operator=(const VMModuleArena&) = delete;
+  private:
+    struct Chunk {
+      Chunk* next;
+    };
+    static constexpr size_t ChunkBytes = 16384;
+    egg::ovum::IAllocator& allocator;
+    Chunk* chunks;
+    char* bump;
+    char* limit;
+  public:
+    explicit VMModuleArena(egg::ovum::IAllocator& allocator)
+      : allocator(allocator),
+        chunks(nullptr),
+        bump(nullptr),
+        limit(nullptr) {
+    }
+    ~VMModuleArena() {
+      while (this->chunks != nullptr) {
+        auto* next = this->chunks->next;
+        this->allocator.deallocate(this->chunks, alignof(std::max_align_t));
+        this->chunks = next;
+      }
+    }
+    void* allocate(size_t bytes, size_t alignment) {
+      assert((alignment > 0) && ((alignment & (alignment - 1)) == 0) && (alignment <= alignof(std::max_align_t)));
+      auto offset = (alignment - (reinterpret_cast<uintptr_t>(this->bump) & (alignment - 1))) & (alignment - 1);
+      if ((this->bump == nullptr) || (bytes + offset > size_t(this->limit - this->bump))) {
+        // Oversized requests get a chunk of their own so that we don't waste the remainder of the current one
+        auto header = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        auto usable = std::max(bytes, ChunkBytes - header);
+        auto* chunk = static_cast<Chunk*>(this->allocator.allocate(header + usable, alignof(std::max_align_t)));
+        assert(chunk != nullptr);
+        chunk->next = this->chunks;
+        this->chunks = chunk;
+        auto* base = reinterpret_cast<char*>(chunk) + header;
+        if (usable > bytes) {
+          this->bump = base;
+          this->limit = base + usable;
+        } else {
+          return base;
+        }
+        offset = 0;
+      }
+      auto* allocated = this->bump + offset;
+      this->bump = allocated + bytes;
+      return allocated;
+    }
+    template<typename T, typename... ARGS>
+    T* create(ARGS&&... args) {
+      return new(this->allocate(sizeof(T), alignof(T))) T(std::forward<ARGS>(args)...);
+    }
+  };
+
+  template<typename T>
+  class VMModuleArray {
+    // Growable array of pointers whose storage lives in the module arena
+    VMModuleArray(const VMModuleArray&) = delete;
+    VMModuleArray& operator=(const VMModuleArray&) = delete;
+  private:
+    T** items;
+    size_t count;
+    size_t capacity;
+  public:
+    VMModuleArray()
+      : items(nullptr),
+        count(0),
+        capacity(0) {
+    }
+    void push_back(VMModuleArena& arena, T* item) {
+      if (this->count == this->capacity) {
+        // Abandoned storage is only reclaimed with the arena, so grow geometrically
+        auto grown = (this->capacity == 0) ? size_t(4) : (this->capacity * 2);
+        auto** storage = static_cast<T**>(arena.allocate(grown * sizeof(T*), alignof(T*)));
+        if (this->count > 0) {
+          std::memcpy(storage, this->items, this->count * sizeof(T*));
+        }
+        this->items = storage;
+        this->capacity = grown;
+      }
+      this->items[this->count++] = item;
+    }
+    size_t size() const {
+      return this->count;
+    }
+    bool empty() const {
+      return this->count == 0;
+    }
+    T* const* data() const {
+      return this->items;
+    }
+    T* const* begin() const {
+      return this->items;
+    }
+    T* const* end() const {
+      return this->items + this->count;
+    }
+    T* front() const {
+      assert(this->count > 0);
+      return this->items[0];
+    }
+    T* back() const {
+      assert(this->count > 0);
+      return this->items[this->count - 1];
+    }
+    T* operator[](size_t index) const {
+      assert(index < this->count);
+      return this->items[index];
+    }
+  };
 }
 
-class egg::ovum::IVMModule::Node : public HardReferenceCounted<IHardAcquireRelease> {
+class egg::ovum::IVMModule::Node {
   Node(const Node&) = delete;
   Node& operator=(const Node&) = delete;
-private:
-  HardPtr<Node> chain; // Internal linked list of all known nodes in this module
 public:
+  Node* chain; // Internal linked list of all known nodes in this module (for destruction only)
   enum class Kind {
     Root,
     ExprUnaryOp,
@@ -23,6 +138,7 @@ public:
     ExprPredicateOp,
     ExprLiteral,
     ExprFunctionCall,
+    ExprMethodCall,
     ExprVariableGet,
     ExprPropertyGet,
     ExprIndexGet,
@@ -98,21 +214,29 @@ public:
     IFunctionSignatureParameter::Flags parameterFlags;
     Accessability accessability;
     size_t defaultIndex;
+    bool pairwise; // 'StmtForEach' whose control variable is only ever read via '.key' and '.value'
+    bool declared; // 'ExprArrayConstruct' whose element type was declared rather than inferred from the elements
+    const StringMethod* stringMethod; // 'ExprMethodCall' whose literal property name matches a native string method (or nullptr)
   };
-  std::vector<Node*> children; // Reference-counting hard pointers are stored in the chain
+  VMModuleArray<Node> children; // Storage is owned by the module arena
+  VMBytecode* bytecode; // Lowered form used by the bytecode engine (owned)
+  bool lowered; // True once lowering has been attempted (only when the module is built)
+  size_t slot; // Frame slot of the symbol referenced or declared by this node (or 'Unresolved')
+  size_t slots; // Number of slots required by the frame started by this node
+  mutable IObject::PropertyCache cache; // Inline cache used by property access nodes with literal keys
+  static constexpr size_t Unresolved = SIZE_MAX;
   Node(VMModule& module, Kind kind, const SourceRange& range, Node* chain)
-    : HardReferenceCounted<IHardAcquireRelease>(),
-      chain(chain),
+    : chain(chain),
       module(module),
       kind(kind),
-      range(range) {
-  }
-  void addChild(Node& child) {
-    this->children.push_back(&child);
+      range(range),
+      bytecode(nullptr),
+      lowered(false),
+      slot(Unresolved),
+      slots(0) {
   }
+  void addChild(Node& child);
   void printLocation(Printer& printer) const;
-protected:
-  virtual void hardDestroy() const override;
 };
 
 namespace {
@@ -291,15 +415,19 @@ namespace {
     VMModule& operator=(const VMModule&) = delete;
   private:
     String resource;
-    HardPtr<Node> chain; // Head of the linked list of all known nodes in this module
+    VMModuleArena arena; // Owns the nodes and their child arrays
+    Node* chain; // Head of the linked list of all known nodes in this module
     Node* root;
   public:
     VMModule(IVM& vm, const String& resource)
       : VMUncollectable(vm),
-        resource(resource) {
-      this->root = this->getAllocator().makeRaw<Node>(*this, Node::Kind::Root, SourceRange{}, nullptr);
-      this->chain.set(this->root);
+        resource(resource),
+        arena(vm.getAllocator()),
+        chain(nullptr),
+        root(nullptr) {
+      this->root = &this->createNode(Node::Kind::Root, SourceRange{});
     }
+    virtual ~VMModule() override;
     virtual HardPtr<IVMRunner> createRunner(IVMProgram& program) override;
     const String& getResource() const {
       return this->resource;
@@ -308,97 +436,175 @@ namespace {
       return *this->root;
     }
     Node& createNode(Node::Kind kind, const SourceRange& range) {
-      // Make sure we add the node to the internal linked list
-      auto* node = this->getAllocator().makeRaw<Node>(*this, kind, range, this->chain.get());
+      // Nodes are carved out of the arena in creation order, so a parent's children immediately precede it
+      auto* node = this->arena.create<Node>(*this, kind, range, this->chain);
       assert(node != nullptr);
-      this->chain.set(node);
+      this->chain = node;
       return *node;
     }
+    void addChild(Node& parent, Node& child) {
+      parent.children.push_back(this->arena, &child);
+    }
   };
 
   // Only instantiated by composition within 'VMRunner' etc.
   struct VMSymbolTable {
   public:
     using Kind = VMSymbolKind;
+    static constexpr size_t Unresolved = IVMModule::Node::Unresolved;
     struct Entry {
       Kind kind;
       Type type;
-      IValue* soft;
+      IValue* soft; // Null if the slot is not currently in use
+      String name;
     };
   private:
-    struct Table {
-      std::map<String, Entry> entries;
-      Entry* insert(Kind kind, const String& name, const Type& type, IValue* soft) {
-        // Returns any extant entry
-        auto iterator = this->entries.emplace(name, Entry{ kind, type, soft });
-        return iterator.second ? nullptr : &iterator.first->second;
-      }
-      Entry* find(const String& name) {
-        auto iterator = this->entries.find(name);
-        if (iterator == this->entries.end()) {
-          return nullptr;
-        }
-        return &iterator->second;
-      }
-      bool remove(const String& name) {
-        return this->entries.erase(name) == 1;
-      }
+    struct Frame {
+      size_t base; // Index of the first entry of this frame
+      size_t slots; // Number of entries reserved for resolved slots
     };
-    std::deque<Table> stack;
+    std::vector<Entry> entries; // Entries of all frames, innermost last (pointers are invalidated by any modification)
+    std::vector<Frame> frames;
+    std::map<String, Entry> builtins; // Only visible from the base of the chain
   public:
     void push() {
-      this->stack.emplace_front();
+      this->frames.push_back({ this->entries.size(), 0 });
     }
     void pop() {
-      assert(this->stack.size() > 1);
-      this->stack.pop_front();
+      assert(this->frames.size() > 1);
+      this->entries.erase(this->entries.begin() + std::ptrdiff_t(this->frames.back().base), this->entries.end());
+      this->frames.pop_back();
+    }
+    void reserve(size_t slots) {
+      // Reserve resolved slots after any arguments already added to the head frame
+      assert(!this->frames.empty());
+      auto& frame = this->frames.back();
+      auto size = frame.base + slots;
+      if (this->entries.size() < size) {
+        this->entries.resize(size, Entry{ Kind::Variable, nullptr, nullptr, {} });
+      }
+      frame.slots = this->entries.size() - frame.base;
     }
     void builtin(const String& name, IValue* soft) {
       // You can only add builtins to the base of the chain
-      assert(this->stack.size() == 1);
+      assert(this->frames.size() == 1);
       assert(soft != nullptr);
       assert(soft->softGetBasket() != nullptr);
-      auto extant = this->stack.front().insert(Kind::Builtin, name, soft->getRuntimeType(), soft);
-      assert(extant == nullptr);
-      (void)extant;
+      auto inserted = this->builtins.emplace(name, Entry{ Kind::Builtin, soft->getRuntimeType(), soft, name });
+      assert(inserted.second);
+      (void)inserted;
     }
-    Entry* add(Kind kind, const String& name, const Type& type, IValue* soft) {
-      // Returns any extant entry
-      assert(!this->stack.empty());
+    bool add(size_t slot, Kind kind, const String& name, const Type& type, IValue* soft, Kind& extant) {
+      // Returns false with the kind of any extant entry (no pointer is returned because adding may reallocate the entries)
+      assert(!this->frames.empty());
       assert((soft == nullptr) || (soft->softGetBasket() != nullptr));
-      return this->stack.front().insert(kind, name, type, soft);
+      if (this->frames.size() == 1) {
+        auto found = this->builtins.find(name);
+        if (found != this->builtins.end()) {
+          extant = found->second.kind;
+          return false;
+        }
+      }
+      if (slot == Unresolved) {
+        auto* found = this->findHead(name);
+        if (found != nullptr) {
+          extant = found->kind;
+          return false;
+        }
+        this->entries.push_back({ kind, type, soft, name });
+        return true;
+      }
+      auto& entry = this->entries[this->frames.back().base + slot];
+      assert(entry.soft == nullptr);
+      entry = { kind, type, soft, name };
+      return true;
     }
-    bool remove(const String& name) {
+    bool remove(size_t slot, const String& name) {
       // Only removes from the head of the chain
-      assert(!this->stack.empty());
-      return this->stack.front().remove(name);
+      assert(!this->frames.empty());
+      const auto& frame = this->frames.back();
+      auto index = frame.base + slot;
+      if (slot == Unresolved) {
+        auto* extant = this->findHead(name);
+        if (extant == nullptr) {
+          return false;
+        }
+        index = size_t(extant - this->entries.data());
+      }
+      if (index >= frame.base + frame.slots) {
+        // Unresolved entries live beyond the reserved slots
+        this->entries.erase(this->entries.begin() + std::ptrdiff_t(index));
+        return true;
+      }
+      auto& entry = this->entries[index];
+      if (entry.soft == nullptr) {
+        return false;
+      }
+      entry = { Kind::Variable, nullptr, nullptr, {} };
+      return true;
+    }
+    Entry* find(size_t slot) {
+      // Fast path for symbols resolved when the module was built
+      assert(!this->frames.empty());
+      if (slot != Unresolved) {
+        auto& entry = this->entries[this->frames.back().base + slot];
+        if (entry.soft != nullptr) {
+          return &entry;
+        }
+      }
+      return nullptr;
     }
     Entry* find(const String& name) {
-      // Searches the chain from front to back
-      for (auto& table : this->stack) {
-        auto* found = table.find(name);
-        if (found != nullptr) {
-          return found;
+      // Searches the chain from head to base
+      auto end = this->entries.size();
+      for (auto frame = this->frames.rbegin(); frame != this->frames.rend(); ++frame) {
+        for (auto index = end; index > frame->base; --index) {
+          auto& entry = this->entries[index - 1];
+          if ((entry.soft != nullptr) && entry.name.equals(name)) {
+            return &entry;
+          }
         }
+        end = frame->base;
+      }
+      auto found = this->builtins.find(name);
+      if (found != this->builtins.end()) {
+        return &found->second;
       }
       return nullptr;
     }
     void softVisit(ICollectable::IVisitor& visitor) const {
-      for (const auto& table : this->stack) {
-        for (const auto& entry : table.entries) {
-          assert(entry.second.soft != nullptr);
-          visitor.visit(*entry.second.soft);
+      for (const auto& entry : this->entries) {
+        if (entry.soft != nullptr) {
+          visitor.visit(*entry.soft);
         }
       }
+      for (const auto& builtin : this->builtins) {
+        assert(builtin.second.soft != nullptr);
+        visitor.visit(*builtin.second.soft);
+      }
     }
     void print(Printer& printer) const {
       // TODO debugging only
       auto frame = 0;
-      for (const auto& table : this->stack) {
-        printer << "=== SYMBOL TABLE FRAME " << frame++ << " (size=" << table.entries.size() << ") ===\n";
-        for (const auto& entry : table.entries) {
+      auto end = this->entries.size();
+      for (auto head = this->frames.rbegin(); head != this->frames.rend(); ++head) {
+        std::map<String, const Entry*> table;
+        for (auto index = head->base; index < end; ++index) {
+          const auto& entry = this->entries[index];
+          if (entry.soft != nullptr) {
+            table.emplace(entry.name, &entry);
+          }
+        }
+        end = head->base;
+        if (end == 0) {
+          for (const auto& builtin : this->builtins) {
+            table.emplace(builtin.first, &builtin.second);
+          }
+        }
+        printer << "=== SYMBOL TABLE FRAME " << frame++ << " (size=" << table.size() << ") ===\n";
+        for (const auto& entry : table) {
           auto& name = entry.first;
-          auto& value = entry.second;
+          auto& value = *entry.second;
           switch (value.kind) {
           case Kind::Builtin:
             printer << "   BUILTIN ";
@@ -415,6 +621,17 @@ namespace {
       }
       printer << "=== SYMBOL TABLE END ===";
     }
+  private:
+    Entry* findHead(const String& name) {
+      assert(!this->frames.empty());
+      for (auto index = this->entries.size(); index > this->frames.back().base; --index) {
+        auto& entry = this->entries[index - 1];
+        if ((entry.soft != nullptr) && entry.name.equals(name)) {
+          return &entry;
+        }
+      }
+      return nullptr;
+    }
   };
 
   // Only instantiated by composition within 'VMRunner' etc.
@@ -423,10 +640,12 @@ namespace {
     VMExecution& operator=(const VMExecution&) = delete;
   public:
     VMRunner* runner;
+    bool synchronous; // True if the next script function call must run to completion (see 'callFunction()')
   public:
     explicit VMExecution(IVM& vm)
       : VMCommon<IVMExecution>(vm),
-        runner(nullptr) {
+        runner(nullptr),
+        synchronous(false) {
     }
     virtual HardValue raiseException(const HardValue& inner) override {
       auto& allocator = this->vm.getAllocator();
@@ -435,6 +654,14 @@ namespace {
     virtual HardValue raiseRuntimeError(const String& message, const SourceRange* source) override;
     virtual HardValue initiateFunctionCall(const IFunctionSignature& signature, const IVMModule::Node& definition, const ICallArguments& arguments, const IVMCallCaptures* captures) override;
     virtual HardValue initiateManifestationCall(const Type& infratype, const IVMModule::Node& specification, const IVMTypeSpecification::Parameters& parameters, const IVMCallCaptures* captures) override;
+    virtual HardValue callFunction(const HardObject& function, const ICallArguments& arguments) override {
+      // Native callers cannot resume the runner's stack, so script functions get a runner of their own and anything else that would push on to it is rejected
+      assert(function != nullptr);
+      auto synchronous = std::exchange(this->synchronous, true);
+      auto retval = function->vmCall(*this, arguments);
+      this->synchronous = synchronous;
+      return retval;
+    }
     virtual bool assignValue(IValue& lhs, const Type& ltype, const IValue& rhs) override {
       // Assign with int-to-float promotion
       assert(ltype != nullptr);
@@ -452,7 +679,7 @@ namespace {
       case Assignability::Never:
         return false;
       case Assignability::Always:
-        return lhs.set(rhs);
+        return lhs.set(this->vm.getAllocator(), rhs);
       case Assignability::Sometimes:
         break;
       }
@@ -893,13 +1120,13 @@ namespace {
       case ValueMutationOp::Increment:
       case ValueMutationOp::Noop:
         assert(rhs->getPrimitiveFlag() == ValueFlags::Void);
-        return lhs->mutate(op, rhs.get());
+        return lhs.mutate(this->vm.getAllocator(), op, rhs.get());
       case ValueMutationOp::IfVoid:
       case ValueMutationOp::IfNull:
       case ValueMutationOp::IfFalse:
       case ValueMutationOp::IfTrue:
         // The condition was already tested in 'precheckValueMutationOp()'
-        return lhs->mutate(ValueMutationOp::Assign, rhs.get());
+        return lhs.mutate(this->vm.getAllocator(), ValueMutationOp::Assign, rhs.get());
       case ValueMutationOp::Assign:
       case ValueMutationOp::Add:
       case ValueMutationOp::Subtract:
@@ -914,7 +1141,7 @@ namespace {
       case ValueMutationOp::ShiftRightUnsigned:
       case ValueMutationOp::Minimum:
       case ValueMutationOp::Maximum:
-        return lhs->mutate(op, rhs.get());
+        return lhs.mutate(this->vm.getAllocator(), op, rhs.get());
       }
       return lhs;
     }
@@ -996,19 +1223,19 @@ namespace {
       case ValueFlags::String:
       case ValueFlags::Object:
         if (Bits::hasAnySet(lflags, rflags)) {
-          return lhs.set(rhs);
+          return lhs.set(this->vm.getAllocator(), rhs);
         }
         break;
       case ValueFlags::Int:
         if (Bits::hasAnySet(lflags, ValueFlags::Int)) {
-          return lhs.set(rhs);
+          return lhs.set(this->vm.getAllocator(), rhs);
         }
         if (promote && Bits::hasAnySet(lflags, ValueFlags::Float)) {
           Int ivalue;
           if (rhs.getInt(ivalue)) {
             auto fvalue = Arithmetic::promote(ivalue);
             auto hvalue = this->vm.createHardValueFloat(fvalue);
-            return lhs.set(hvalue.get());
+            return lhs.set(this->vm.getAllocator(), hvalue.get());
           }
         }
         break;
@@ -1056,6 +1283,10 @@ namespace {
         assert(node.literal->getVoid());
         assert(node.children.size() >= 1);
         return this->deduceExprFunctionCall(*node.children.front(), node.range);
+      case Node::Kind::ExprMethodCall:
+        assert(node.literal->getVoid());
+        assert(node.children.size() >= 2);
+        return this->deduceExprMethodCall(*node.children[0], *node.children[1], node.range);
       case Node::Kind::ExprVariableGet:
         assert(node.children.empty());
         return this->deduceExprVariableGet(node.literal, node.range);
@@ -1394,7 +1625,20 @@ namespace {
         assert(function.children.size() == 1);
         return { IVMTypeResolver::Kind::Value, this->deduceType(*function.children.front()) };
       }
-      auto ftype = this->deduceValue(function);
+      return this->deduceCallable(this->deduceValue(function), range);
+    }
+    Deduced deduceExprMethodCall(Node& instance, Node& property, const SourceRange& range) {
+      // e.g. 's.indexOf(x)' or 'string.from(x)'
+      auto deduced = this->deduceAmbiguousPropertyGet(instance, property, range, IVMTypeResolver::Kind::Value);
+      if (deduced.failed()) {
+        return { IVMTypeResolver::Kind::Value, nullptr };
+      }
+      if (deduced.kind != IVMTypeResolver::Kind::Value) {
+        return this->fail(range, "TODO: Expected deduced value type but got metatype instead");
+      }
+      return this->deduceCallable(deduced.type, range);
+    }
+    Deduced deduceCallable(const Type& ftype, const SourceRange& range) {
       if (ftype == nullptr) {
         return { IVMTypeResolver::Kind::Value, nullptr };
       }
@@ -1560,6 +1804,194 @@ namespace {
     }
   };
 
+  class VMSymbolResolver {
+    VMSymbolResolver(const VMSymbolResolver&) = delete;
+    VMSymbolResolver& operator=(const VMSymbolResolver&) = delete;
+  private:
+    using Node = IVMModule::Node;
+    static constexpr size_t Unresolved = Node::Unresolved;
+    struct Declaration {
+      String name;
+      bool hidden; // True once prematurely undeclared
+    };
+    struct Frame {
+      size_t id;
+      std::vector<Declaration> declarations; // Indexed by slot
+      size_t slots;
+    };
+    std::map<const Node*, std::pair<size_t, size_t>> resolved; // Node to frame/slot (nodes may be shared)
+    size_t frames;
+    VMSymbolResolver()
+      : frames(0) {
+    }
+  public:
+    static void resolve(Node& root) {
+      // Assign frame slots to the symbols declared and referenced within a module
+      assert(root.kind == Node::Kind::Root);
+      VMSymbolResolver resolver;
+      resolver.frame(root, {}, 0);
+    }
+  private:
+    void frame(Node& owner, const std::vector<String>& arguments, size_t first) {
+      // Captures and arguments are added to the frame before any locals
+      Frame frame{ ++this->frames, {}, arguments.size() };
+      for (auto& argument : arguments) {
+        frame.declarations.push_back({ argument, false });
+      }
+      for (auto index = first; index < owner.children.size(); ++index) {
+        this->walk(*owner.children[index], &frame);
+      }
+      owner.slots = frame.slots;
+    }
+    void walk(Node& node, Frame* frame) {
+      // A null frame means that symbols cannot be resolved statically
+      switch (node.kind) {
+      case Node::Kind::ExprVariableGet:
+      case Node::Kind::ExprVariableRef:
+      case Node::Kind::ExprFunctionCapture:
+      case Node::Kind::ExprGuard:
+      case Node::Kind::TypeVariableGet:
+      case Node::Kind::StmtVariableMutate:
+        this->assign(node, frame, this->lookup(node, frame));
+        this->walkChildren(node, frame, 0);
+        break;
+      case Node::Kind::StmtVariableUndeclare:
+        this->undeclare(node, frame);
+        break;
+      case Node::Kind::StmtVariableDeclare:
+      case Node::Kind::StmtVariableDefine:
+      case Node::Kind::StmtTypeDefine:
+      case Node::Kind::StmtForEach:
+      case Node::Kind::StmtCatch:
+        // The first child is the type, evaluated before the symbol is declared
+        if (!node.children.empty()) {
+          this->walk(*node.children.front(), frame);
+        }
+        this->declare(node, frame);
+        break;
+      case Node::Kind::ExprFunctionConstruct:
+        this->construct(node, frame);
+        break;
+      case Node::Kind::TypeSpecification:
+        // Specifications may be evaluated from any frame
+        this->walkChildren(node, nullptr, 0);
+        break;
+      case Node::Kind::StmtManifestationInvoke:
+        // Manifestations have neither captures nor arguments
+        this->frame(node, {}, 0);
+        break;
+      default:
+        this->walkChildren(node, frame, 0);
+        break;
+      }
+    }
+    void walkChildren(Node& node, Frame* frame, size_t first) {
+      for (auto index = first; index < node.children.size(); ++index) {
+        this->walk(*node.children[index], frame);
+      }
+    }
+    void construct(Node& node, Frame* frame) {
+      // The children are the function type, the invocation node and any captures
+      if (node.children.size() < 2) {
+        this->walkChildren(node, frame, 0);
+        return;
+      }
+      auto& ftype = *node.children[0];
+      auto& invoke = *node.children[1];
+      this->walk(ftype, frame);
+      std::vector<String> arguments;
+      for (auto index = size_t(2); index < node.children.size(); ++index) {
+        auto& capture = *node.children[index];
+        this->walk(capture, frame);
+        String name;
+        (void)capture.literal->getString(name);
+        arguments.push_back(name);
+      }
+      if (!this->parameters(ftype, arguments)) {
+        // We cannot know the layout of the frame until run-time
+        this->walkChildren(invoke, nullptr, 0);
+        return;
+      }
+      this->frame(invoke, arguments, 0);
+    }
+    bool parameters(const Node& ftype, std::vector<String>& names) {
+      // Append the parameter names in signature order
+      if (ftype.kind == Node::Kind::TypeFunctionSignature) {
+        for (auto index = size_t(1); index < ftype.children.size(); ++index) {
+          String name;
+          (void)ftype.children[index]->literal->getString(name);
+          names.push_back(name);
+        }
+        return true;
+      }
+      Type type;
+      if ((ftype.kind == Node::Kind::TypeLiteral) && ftype.literal->getHardType(type) && (type != nullptr)) {
+        auto* signature = type.getOnlyFunctionSignature();
+        if (signature != nullptr) {
+          for (size_t index = 0; index < signature->getParameterCount(); ++index) {
+            names.push_back(signature->getParameter(index).getName());
+          }
+          return true;
+        }
+      }
+      return false;
+    }
+    void declare(Node& node, Frame* frame) {
+      String name;
+      if ((frame == nullptr) || !node.literal->getString(name) || (this->lookup(name, *frame) != Unresolved)) {
+        // Redeclarations are reported at run-time
+        this->assign(node, frame, Unresolved);
+        this->walkChildren(node, frame, 1);
+        return;
+      }
+      auto slot = frame->declarations.size();
+      this->assign(node, frame, slot);
+      if (node.slot == Unresolved) {
+        this->walkChildren(node, frame, 1);
+        return;
+      }
+      frame->declarations.push_back({ name, false });
+      frame->slots = std::max(frame->slots, frame->declarations.size());
+      this->walkChildren(node, frame, 1);
+      assert(frame->declarations.size() == slot + 1);
+      frame->declarations.pop_back();
+    }
+    void undeclare(Node& node, Frame* frame) {
+      auto slot = this->lookup(node, frame);
+      this->assign(node, frame, slot);
+      if (slot != Unresolved) {
+        frame->declarations[slot].hidden = true;
+      }
+    }
+    size_t lookup(const Node& node, Frame* frame) {
+      String name;
+      if ((frame == nullptr) || !node.literal->getString(name)) {
+        return Unresolved;
+      }
+      return this->lookup(name, *frame);
+    }
+    size_t lookup(const String& name, const Frame& frame) {
+      // Only the innermost declaration in this frame is visible
+      for (auto slot = frame.declarations.size(); slot > 0; --slot) {
+        auto& declaration = frame.declarations[slot - 1];
+        if (!declaration.hidden && declaration.name.equals(name)) {
+          return slot - 1;
+        }
+      }
+      return Unresolved;
+    }
+    void assign(Node& node, const Frame* frame, size_t slot) {
+      // Nodes shared between differing frames or scopes fall back to run-time lookup
+      auto id = (frame == nullptr) ? 0 : frame->id;
+      auto inserted = this->resolved.emplace(&node, std::make_pair(id, slot));
+      if (!inserted.second && (inserted.first->second != std::make_pair(id, slot))) {
+        inserted.first->second = std::make_pair(id, Unresolved);
+        slot = Unresolved;
+      }
+      node.slot = slot;
+    }
+  };
+
   class VMModuleBuilder : public VMUncollectable<IVMModuleBuilder> {
     VMModuleBuilder(const VMModuleBuilder&) = delete;
     VMModuleBuilder& operator=(const VMModuleBuilder&) = delete;
@@ -1577,14 +2009,7 @@ namespace {
       assert(this->module != nullptr);
       return this->module->getRoot();
     }
-    virtual HardPtr<IVMModule> build() override {
-      HardPtr<VMModule> built = this->module;
-      if (built != nullptr) {
-        this->module = nullptr;
-        this->program->addModule(*built);
-      }
-      return built;
-    }
+    virtual HardPtr<IVMModule> build() override;
     virtual Node& exprValueUnaryOp(ValueUnaryOp op, Node& arg, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprUnaryOp, range);
       node.valueUnaryOp = op;
@@ -1613,7 +2038,13 @@ namespace {
     }
     virtual Node& exprLiteral(const HardValue& literal, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprLiteral, range);
-      node.literal = literal;
+      String value;
+      if (literal->getString(value)) {
+        // String literals are frequently property names (e.g. 'a.b')
+        node.literal = this->createHardValueName(value);
+      } else {
+        node.literal = literal;
+      }
       return node;
     }
     virtual Node& exprFunctionCall(Node& function, const SourceRange& range) override {
@@ -1621,9 +2052,21 @@ namespace {
       node.addChild(function);
       return node;
     }
+    virtual Node& exprMethodCall(Node& instance, Node& property, const SourceRange& range) override {
+      auto& node = this->module->createNode(Node::Kind::ExprMethodCall, range);
+      node.addChild(instance);
+      node.addChild(property);
+      String name;
+      if ((property.kind == Node::Kind::ExprLiteral) && property.literal->getString(name)) {
+        node.stringMethod = StringMethod::find(name);
+      } else {
+        node.stringMethod = nullptr;
+      }
+      return node;
+    }
     virtual Node& exprVariableGet(const String& symbol, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprVariableGet, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       return node;
     }
     virtual Node& exprPropertyGet(Node& instance, Node& property, const SourceRange& range) override {
@@ -1645,7 +2088,7 @@ namespace {
     }
     virtual Node& exprVariableRef(const String& symbol, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprVariableRef, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       return node;
     }
     virtual Node& exprPropertyRef(Node& instance, Node& property, const SourceRange& range) override {
@@ -1660,10 +2103,11 @@ namespace {
       node.addChild(index);
       return node;
     }
-    virtual Node& exprArrayConstruct(const Type& elementType, const SourceRange& range) override {
+    virtual Node& exprArrayConstruct(const Type& elementType, bool declared, const SourceRange& range) override {
       assert(elementType != nullptr);
       auto& node = this->module->createNode(Node::Kind::ExprArrayConstruct, range);
       node.literal = this->createHardValueType(elementType);
+      node.declared = declared;
       return node;
     }
     virtual Node& exprEonConstruct(const SourceRange& range) override {
@@ -1677,7 +2121,7 @@ namespace {
     }
     virtual Node& exprObjectConstructProperty(const String& property, Node& type, Node& value, Accessability accessability, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprObjectConstructProperty, range);
-      node.literal = this->createHardValueString(property);
+      node.literal = this->createHardValueName(property);
       node.accessability = accessability;
       node.addChild(type);
       node.addChild(value);
@@ -1691,12 +2135,12 @@ namespace {
     }
     virtual Node& exprFunctionCapture(const String& symbol, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprFunctionCapture, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       return node;
     }
     virtual Node& exprGuard(const String& symbol, Node& value, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::ExprGuard, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.addChild(value);
       return node;
     }
@@ -1724,7 +2168,7 @@ namespace {
     }
     virtual Node& typeVariableGet(const String& symbol, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::TypeVariableGet, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       return node;
     }
     virtual Node& typeUnaryOp(TypeUnaryOp op, Node& arg, const SourceRange& range) override {
@@ -1742,13 +2186,13 @@ namespace {
     }
     virtual Node& typeFunctionSignature(const String& fname, Node& ptype, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::TypeFunctionSignature, range);
-      node.literal = this->createHardValueString(fname);
+      node.literal = this->createHardValueName(fname);
       node.addChild(ptype);
       return node;
     }
     virtual Node& typeFunctionSignatureParameter(const String& pname, IFunctionSignatureParameter::Flags pflags, Node& ptype, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::TypeFunctionSignatureParameter, range);
-      node.literal = this->createHardValueString(pname);
+      node.literal = this->createHardValueName(pname);
       node.parameterFlags = pflags;
       node.addChild(ptype);
       return node;
@@ -1764,13 +2208,13 @@ namespace {
     }
     virtual Node& typeSpecificationStaticMember(const String& symbol, Node& type, const SourceRange& range) {
       auto& node = this->module->createNode(Node::Kind::TypeSpecificationStaticMember, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.addChild(type);
       return node;
     }
     virtual Node& typeSpecificationInstanceMember(const String& symbol, Node& type, Accessability accessability, const SourceRange& range) {
       auto& node = this->module->createNode(Node::Kind::TypeSpecificationInstanceMember, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.accessability = accessability;
       node.addChild(type);
       return node;
@@ -1796,9 +2240,10 @@ namespace {
       node.addChild(condition);
       return node;
     }
-    virtual Node& stmtForEach(const String& symbol, Node& type, Node& iteration, Node& block, const SourceRange& range) override {
+    virtual Node& stmtForEach(const String& symbol, Node& type, Node& iteration, Node& block, bool pairwise, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtForEach, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
+      node.pairwise = pairwise;
       node.addChild(type);
       node.addChild(iteration);
       node.addChild(block);
@@ -1849,7 +2294,7 @@ namespace {
     }
     virtual Node& stmtManifestationProperty(const String& property, Node& type, Node& value, Accessability accessability, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtManifestationProperty, range);
-      node.literal = this->createHardValueString(property);
+      node.literal = this->createHardValueName(property);
       node.accessability = accessability;
       node.addChild(type);
       node.addChild(value);
@@ -1857,32 +2302,32 @@ namespace {
     }
     virtual Node& stmtVariableDeclare(const String& symbol, Node& type, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtVariableDeclare, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.addChild(type);
       return node;
     }
     virtual Node& stmtVariableDefine(const String& symbol, Node& type, Node& value, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtVariableDefine, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.addChild(type);
       node.addChild(value);
       return node;
     }
     virtual Node& stmtVariableMutate(const String& symbol, ValueMutationOp op, Node& value, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtVariableMutate, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.valueMutationOp = op;
       node.addChild(value);
       return node;
     }
     virtual Node& stmtVariableUndeclare(const String& symbol, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtVariableUndeclare, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       return node;
     }
     virtual Node& stmtTypeDefine(const String& symbol, Node& type, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtTypeDefine, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.addChild(type);
       return node;
     }
@@ -1921,7 +2366,7 @@ namespace {
     }
     virtual Node& stmtCatch(const String& symbol, Node& type, const SourceRange& range) override {
       auto& node = this->module->createNode(Node::Kind::StmtCatch, range);
-      node.literal = this->createHardValueString(symbol);
+      node.literal = this->createHardValueName(symbol);
       node.addChild(type);
       return node;
     }
@@ -2029,6 +2474,11 @@ namespace {
     virtual void appendChild(Node& parent, Node& child) override {
       parent.addChild(child);
     }
+  private:
+    HardValue createHardValueName(const String& name) {
+      // Interned so that symbol and property lookups usually compare by address
+      return this->createHardValueString(this->vm.getStringPool().intern(name));
+    }
   };
 
   class VMProgramBuilder : public VMUncollectable<IVMProgramBuilder> {
@@ -2047,7 +2497,7 @@ namespace {
     }
     virtual void addBuiltin(const String& symbol, const Type& type) override {
       assert(this->program != nullptr);
-      return this->program->addBuiltin(symbol, type);
+      return this->program->addBuiltin(this->vm.getStringPool().intern(symbol), type);
     }
     virtual void visitBuiltins(const std::function<void(const String& symbol, const Type& type)>& visitor) const override {
       assert(this->program != nullptr);
@@ -2068,6 +2518,356 @@ namespace {
     }
   };
 
+  class VMBytecode {
+    VMBytecode(const VMBytecode&) = delete;
+    VMBytecode& operator=(const VMBytecode&) = delete;
+  public:
+    enum class Opcode {
+      Literal, // r[target] = node.literal
+      VariableGet, // r[target] = symbol(node.literal)
+      UnaryOp, // r[target] = op r[target]
+      BinaryOp, // r[target] = r[target] op r[target+1]
+      PredicateOp, // r[target] = predicate(r[target], r[target+1]?)
+      IndexGet, // r[target] = r[target][r[target+1]]
+      PropertyGet, // r[target] = r[target].r[target+1]
+      PointeeGet, // r[target] = *r[target]
+      BranchIfNotNull, // if r[target] is not null: goto jump
+      BranchIfTrue, // if r[target] is true: goto jump
+      BranchIfFalse, // if r[target] is false: goto jump
+      BranchUnless, // if r[target] is not true: goto jump (raises if not a bool)
+      Jump, // goto jump
+      VariableSet, // symbol(node.literal) = r[target]; r[target] = void
+      VariablePrecheck, // if symbol(node.literal) short-circuits: r[target] = void; goto jump
+      VariableMutate, // symbol(node.literal) op= r[target]; r[target] = void
+      PropertyMutate, // r[target].r[target+1] op= r[target+2]; r[target] = void
+      IndexMutate, // r[target][r[target+1]] op= r[target+2]; r[target] = void
+      PointeeMutate, // *r[target] op= r[target+1]; r[target] = void
+      Return, // r[target] = return r[target]
+      Void, // r[target] = void
+      Poll, // statement boundary: a safe point for automatic collections
+      Discard, // warn if r[target] is not void; r[target] = void
+      BranchUnlessCondition, // if r[target] is false: goto jump (raises if not a bool)
+      Call, // r[target] = r[target](r[target+1], ...) suspending while the callee's frame runs
+      MethodResolve, // r[target+1] = method r[target].r[target+1] (unless dispatched natively)
+      MethodCall // r[target] = r[target+1](r[target+2], ...) suspending while the callee's frame runs
+    };
+    struct Instruction {
+      Opcode opcode;
+      size_t target; // Register of the result and first operand
+      size_t jump; // Program counter for branches
+      IVMModule::Node* node; // Source of literals, operators, symbols, error locations and call frames
+    };
+    std::vector<Instruction> code;
+    size_t registers;
+    VMBytecode()
+      : registers(0) {
+    }
+    static void lowerModule(IAllocator& allocator, IVMModule::Node& node) {
+      // Lowers the outermost subtrees possible before any runner sees the module, so nodes are never written at run time
+      if (node.lowered) {
+        return;
+      }
+      node.lowered = true;
+      node.bytecode = VMBytecode::lower(allocator, node);
+      if (node.bytecode == nullptr) {
+        for (auto* child : node.children) {
+          VMBytecode::lowerModule(allocator, *child);
+        }
+      }
+    }
+    static VMBytecode* lower(IAllocator& allocator, IVMModule::Node& node) {
+      // Returns nullptr if any node in the tree cannot be lowered
+      VMBytecode bytecode;
+      if (!bytecode.compile(node, 0)) {
+        return nullptr;
+      }
+      auto* lowered = allocator.makeRaw<VMBytecode>();
+      lowered->code.swap(bytecode.code);
+      lowered->registers = bytecode.registers;
+      return lowered;
+    }
+  private:
+    struct Loop {
+      std::vector<size_t> breaks; // Jumps to the end of the loop
+      std::vector<size_t> continues; // Jumps to the next iteration
+    };
+    std::vector<Loop> loops; // Innermost last, only used during compilation
+    size_t emit(Opcode opcode, size_t target, IVMModule::Node& node) {
+      auto pc = this->code.size();
+      this->code.emplace_back(opcode, target, SIZE_MAX, &node);
+      return pc;
+    }
+    void patchLoop(size_t resume, size_t exit) {
+      assert(!this->loops.empty());
+      auto& loop = this->loops.back();
+      for (auto pc : loop.breaks) {
+        this->code[pc].jump = exit;
+      }
+      for (auto pc : loop.continues) {
+        this->code[pc].jump = resume;
+      }
+      this->loops.pop_back();
+    }
+    bool compileChildren(IVMModule::Node& node, size_t target, size_t count) {
+      if (node.children.size() != count) {
+        return false;
+      }
+      for (size_t index = 0; index < count; ++index) {
+        if (!this->compile(*node.children[index], target + index)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    bool compile(IVMModule::Node& node, size_t target) {
+      // Children are evaluated into consecutive registers starting at 'target'
+      this->registers = std::max(this->registers, target + 1);
+      size_t branch = SIZE_MAX;
+      size_t skip;
+      size_t start;
+      switch (node.kind) {
+      case IVMModule::Node::Kind::ExprLiteral:
+      case IVMModule::Node::Kind::TypeLiteral:
+        if (!node.children.empty()) {
+          return false;
+        }
+        this->emit(Opcode::Literal, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprVariableGet:
+        if (!node.children.empty()) {
+          return false;
+        }
+        this->emit(Opcode::VariableGet, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprUnaryOp:
+        if (!this->compileChildren(node, target, 1)) {
+          return false;
+        }
+        this->emit(Opcode::UnaryOp, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprBinaryOp:
+        if ((node.children.size() != 2) || !this->compile(*node.children[0], target)) {
+          return false;
+        }
+        switch (node.valueBinaryOp) {
+        case ValueBinaryOp::IfNull:
+          // Short-circuit '??'
+          branch = this->emit(Opcode::BranchIfNotNull, target, node);
+          break;
+        case ValueBinaryOp::IfFalse:
+          // Short-circuit '||'
+          branch = this->emit(Opcode::BranchIfTrue, target, node);
+          break;
+        case ValueBinaryOp::IfTrue:
+          // Short-circuit '&&'
+          branch = this->emit(Opcode::BranchIfFalse, target, node);
+          break;
+        default:
+          break;
+        }
+        if (!this->compile(*node.children[1], target + 1)) {
+          return false;
+        }
+        this->emit(Opcode::BinaryOp, target, node);
+        if (branch != SIZE_MAX) {
+          this->code[branch].jump = this->code.size();
+        }
+        return true;
+      case IVMModule::Node::Kind::ExprTernaryOp:
+        if ((node.valueTernaryOp != ValueTernaryOp::IfThenElse) || (node.children.size() != 3) || !this->compile(*node.children[0], target)) {
+          return false;
+        }
+        branch = this->emit(Opcode::BranchUnless, target, node);
+        if (!this->compile(*node.children[1], target)) {
+          return false;
+        }
+        skip = this->emit(Opcode::Jump, target, node);
+        this->code[branch].jump = this->code.size();
+        if (!this->compile(*node.children[2], target)) {
+          return false;
+        }
+        this->code[skip].jump = this->code.size();
+        return true;
+      case IVMModule::Node::Kind::ExprPredicateOp:
+        if ((node.children.size() < 1) || (node.children.size() > 2) || !this->compileChildren(node, target, node.children.size())) {
+          return false;
+        }
+        this->emit(Opcode::PredicateOp, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprIndexGet:
+        if (!this->compileChildren(node, target, 2)) {
+          return false;
+        }
+        this->emit(Opcode::IndexGet, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprPropertyGet:
+        if (!this->compileChildren(node, target, 2)) {
+          return false;
+        }
+        this->emit(Opcode::PropertyGet, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprPointeeGet:
+        if (!this->compileChildren(node, target, 1)) {
+          return false;
+        }
+        this->emit(Opcode::PointeeGet, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtVariableMutate:
+        if (node.valueMutationOp == ValueMutationOp::Assign) {
+          if (!this->compileChildren(node, target, 1)) {
+            return false;
+          }
+          this->emit(Opcode::VariableSet, target, node);
+          return true;
+        }
+        branch = this->emit(Opcode::VariablePrecheck, target, node);
+        if (!this->compileChildren(node, target, 1)) {
+          return false;
+        }
+        this->emit(Opcode::VariableMutate, target, node);
+        this->code[branch].jump = this->code.size();
+        return true;
+      case IVMModule::Node::Kind::StmtPropertyMutate:
+        if (!this->compileChildren(node, target, 3)) {
+          return false;
+        }
+        this->emit(Opcode::PropertyMutate, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtIndexMutate:
+        if (!this->compileChildren(node, target, 3)) {
+          return false;
+        }
+        this->emit(Opcode::IndexMutate, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtPointerMutate:
+        if (!this->compileChildren(node, target, 2)) {
+          return false;
+        }
+        this->emit(Opcode::PointeeMutate, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtReturn:
+        if (node.children.empty()) {
+          this->emit(Opcode::Void, target, node);
+        } else if (!this->compileChildren(node, target, 1)) {
+          return false;
+        }
+        this->emit(Opcode::Return, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtBlock:
+        for (auto* child : node.children) {
+          this->emit(Opcode::Poll, target, node);
+          if (!this->compile(*child, target)) {
+            return false;
+          }
+          this->emit(Opcode::Discard, target, node);
+        }
+        if (node.children.empty()) {
+          this->emit(Opcode::Void, target, node);
+        }
+        return true;
+      case IVMModule::Node::Kind::StmtIf:
+        if ((node.children.size() < 2) || (node.children.size() > 3) || !this->compile(*node.children[0], target)) {
+          return false;
+        }
+        branch = this->emit(Opcode::BranchUnlessCondition, target, node);
+        if (!this->compile(*node.children[1], target)) {
+          return false;
+        }
+        if (node.children.size() > 2) {
+          skip = this->emit(Opcode::Jump, target, node);
+          this->code[branch].jump = this->code.size();
+          if (!this->compile(*node.children[2], target)) {
+            return false;
+          }
+          this->code[skip].jump = this->code.size();
+        } else {
+          this->code[branch].jump = this->code.size();
+          this->emit(Opcode::Void, target, node);
+        }
+        return true;
+      case IVMModule::Node::Kind::StmtWhile:
+        if (node.children.size() != 2) {
+          return false;
+        }
+        // Like the node stack, 'while' passes breaks and continues through to the enclosing 'for'
+        start = this->code.size();
+        if (!this->compile(*node.children[0], target)) {
+          return false;
+        }
+        branch = this->emit(Opcode::BranchUnlessCondition, target, node);
+        if (!this->compile(*node.children[1], target)) {
+          return false;
+        }
+        this->code[this->emit(Opcode::Jump, target, node)].jump = start;
+        this->code[branch].jump = this->code.size();
+        this->emit(Opcode::Void, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtForLoop:
+        // Children are 'initial', 'condition', the controlled block and 'advance'
+        if (node.children.size() != 4) {
+          return false;
+        }
+        this->loops.emplace_back();
+        if (!this->compile(*node.children[0], target)) {
+          return false;
+        }
+        start = this->code.size();
+        if (!this->compile(*node.children[1], target)) {
+          return false;
+        }
+        branch = this->emit(Opcode::BranchUnlessCondition, target, node);
+        if (!this->compile(*node.children[2], target)) {
+          return false;
+        }
+        skip = this->code.size();
+        if (!this->compile(*node.children[3], target)) {
+          return false;
+        }
+        this->code[this->emit(Opcode::Jump, target, node)].jump = start;
+        this->code[branch].jump = this->code.size();
+        this->patchLoop(skip, this->code.size());
+        this->emit(Opcode::Void, target, node);
+        return true;
+      case IVMModule::Node::Kind::StmtBreak:
+        // Breaks and continues outside lowered loops are left to the node stack
+        if (this->loops.empty() || !node.children.empty()) {
+          return false;
+        }
+        this->loops.back().breaks.push_back(this->emit(Opcode::Jump, target, node));
+        return true;
+      case IVMModule::Node::Kind::StmtContinue:
+        if (this->loops.empty() || !node.children.empty()) {
+          return false;
+        }
+        this->loops.back().continues.push_back(this->emit(Opcode::Jump, target, node));
+        return true;
+      case IVMModule::Node::Kind::ExprFunctionCall:
+        if (node.children.empty() || !this->compileChildren(node, target, node.children.size())) {
+          return false;
+        }
+        this->emit(Opcode::Call, target, node);
+        return true;
+      case IVMModule::Node::Kind::ExprMethodCall:
+        // The method is resolved before any arguments are evaluated
+        if ((node.children.size() < 2) || !this->compile(*node.children[0], target) || !this->compile(*node.children[1], target + 1)) {
+          return false;
+        }
+        this->emit(Opcode::MethodResolve, target, node);
+        for (size_t index = 2; index < node.children.size(); ++index) {
+          if (!this->compile(*node.children[index], target + index)) {
+            return false;
+          }
+        }
+        this->emit(Opcode::MethodCall, target, node);
+        return true;
+      default:
+        // Other control flow, constructions and declarations are left to the node stack
+        break;
+      }
+      return false;
+    }
+  };
+
   class VMRunner : public VMCollectable<IVMRunner>, public IVMTypeResolver {
     VMRunner(const VMRunner&) = delete;
     VMRunner& operator=(const VMRunner&) = delete;
@@ -2077,19 +2877,30 @@ namespace {
       String scope; // Name of variable declared here
       size_t index; // Node-specific state variable
       std::deque<HardValue> deque; // Results of child nodes computation
-      HardValue value; // Used by switch/try etc.
+      HardValue value; // Used by switch/try/for-each etc.
+      IObject::IterationCursor cursor; // Used by iterations that need no iterator object
+      HardObject method{ nullptr }; // Used by method calls to hold the method resolved before the arguments
+      size_t base{ 0 }; // Register window of bytecode suspended during a call
     };
     HardPtr<IVMProgram> program;
     std::stack<NodeStack> stack;
     VMSymbolTable symtable;
     VMExecution execution;
+    std::vector<HardValue> registers; // Register file shared by the bytecode windows of all frames (never shrinks)
+    size_t windows; // Registers claimed by active or suspended bytecode windows
+    const IVMModule::Node* current; // Node of the bytecode instruction being executed
   public:
     VMRunner(IVM& vm, IVMProgram& program, IVMModule::Node& root)
       : VMCollectable(vm),
         program(&program),
-        execution(vm) {
+        execution(vm),
+        windows(0),
+        current(nullptr) {
       this->execution.runner = this;
       this->symtable.push();
+      if (root.kind == IVMModule::Node::Kind::Root) {
+        this->symtable.reserve(root.slots);
+      }
       this->push(root);
       this->vm.getBasket().take(*this);
     }
@@ -2112,6 +2923,7 @@ namespace {
     }
     virtual void addBuiltin(const String& symbol, const HardValue& value) override {
       this->symtable.builtin(symbol, &this->vm.createSoftValue(value));
+      this->remember();
     }
     virtual HardValue step() override {
       assert(this->validate());
@@ -2185,16 +2997,18 @@ namespace {
       assert(spec.kind == IVMModule::Node::Kind::TypeSpecification);
       return this->vm.findTypeSpecification(spec);
     }
-    const VMSymbolTable::Entry* addCapture(const VMCallCapture& capture) {
-      return this->symtable.add(capture.kind, capture.name, capture.type, capture.soft);
+    bool addCapture(const VMCallCapture& capture, VMSymbolKind& extant) {
+      this->remember();
+      return this->symtable.add(VMSymbolTable::Unresolved, capture.kind, capture.name, capture.type, capture.soft, extant);
     }
-    const VMSymbolTable::Entry* addVariable(const String& name, const Type& type, IValue* soft) {
-      return this->symtable.add(VMSymbolKind::Variable, name, type, soft);
+    bool addVariable(const String& name, const Type& type, IValue* soft, VMSymbolKind& extant) {
+      this->remember();
+      return this->symtable.add(VMSymbolTable::Unresolved, VMSymbolKind::Variable, name, type, soft, extant);
     }
     HardPtr<IVMCallStack> getCallStack(const SourceRange* source) const {
       // TODO full stack chain
       assert(!this->stack.empty());
-      const auto* top = this->stack.top().node;
+      const auto* top = (this->current != nullptr) ? this->current : this->stack.top().node;
       assert(top != nullptr);
       auto callstack{ this->vm.getAllocator().makeHard<VMCallStack>() };
       callstack->resource = top->module.getResource();
@@ -2214,7 +3028,7 @@ namespace {
     HardValue initiateFunctionCall(const IFunctionSignature& signature, IVMModule::Node& invoke, const ICallArguments& arguments, const IVMCallCaptures* captures) {
       // We need to set the argument/capture symbols and initiate the execution of the block
       assert(!this->stack.empty());
-      assert(this->stack.top().node->kind == IVMModule::Node::Kind::ExprFunctionCall);
+      assert(VMRunner::isCallNode(*this->stack.top().node));
       assert(this->stack.top().scope.empty());
       this->stack.pop();
       this->symtable.push();
@@ -2228,15 +3042,33 @@ namespace {
       if (value.hasFlowControl()) {
         return value;
       }
-      // Push the invoke node
+      // Reserve the slots for the locals and push the invoke node
       assert(invoke.kind == IVMModule::Node::Kind::StmtFunctionInvoke);
+      this->symtable.reserve(invoke.slots);
       this->push(invoke);
       return HardValue::Continue;
     }
+    HardValue completeFunctionCall(const IFunctionSignature& signature, IVMModule::Node& invoke, const ICallArguments& arguments, const IVMCallCaptures* captures) {
+      // Run the function body on a separate runner until it returns
+      assert(invoke.kind == IVMModule::Node::Kind::StmtFunctionInvoke);
+      auto runner = HardPtr(this->getAllocator().makeRaw<VMRunner>(this->vm, *this->program, invoke));
+      assert(runner != nullptr);
+      assert(runner->softGetBasket() == this->basket);
+      auto value = this->addCaptureSymbols(*runner, captures);
+      if (value.hasFlowControl()) {
+        return value;
+      }
+      value = this->addArgumentSymbols(*runner, signature, arguments);
+      if (value.hasFlowControl()) {
+        return value;
+      }
+      runner->symtable.reserve(invoke.slots);
+      return runner->run();
+    }
     HardValue initiateGeneratorCall(const IFunctionSignature& signature, IVMModule::Node& invoke, const ICallArguments& arguments, const IVMCallCaptures* captures) {
       // Create the generator iteration function instance
       assert(!this->stack.empty());
-      assert(this->stack.top().node->kind == IVMModule::Node::Kind::ExprFunctionCall);
+      assert(VMRunner::isCallNode(*this->stack.top().node));
       assert(this->stack.top().scope.empty());
       assert(invoke.kind == IVMModule::Node::Kind::StmtGeneratorInvoke);
       auto runner = HardPtr(this->getAllocator().makeRaw<VMRunner>(this->vm, *this->program, invoke));
@@ -2252,6 +3084,7 @@ namespace {
       if (value.hasFlowControl()) {
         return value;
       }
+      runner->symtable.reserve(invoke.slots);
       // Create and return an iterator object
       auto iterator = VMFactory::createGeneratorIterator(vm, signature.getReturnType(), *runner);
       return this->createHardValueObject(iterator);
@@ -2278,6 +3111,7 @@ namespace {
           if (value.hasFlowControl()) {
             return value;
           }
+          this->symtable.reserve(clause->slots);
           // Push the invoke node, with the infratype in the value
           this->push(*clause).value = this->createHardValueType(infratype);
           return HardValue::Continue;
@@ -2295,9 +3129,9 @@ namespace {
           assert(capture != nullptr);
           assert(capture->soft != nullptr);
           assert(capture->soft->softGetBasket() != nullptr);
-          auto* extant = runner.addCapture(*capture);
-          if (extant != nullptr) {
-            return this->raiseRuntimeError("Captured symbol already declared as ", describe(extant->kind), ": '", capture->name, "'");
+          VMSymbolKind extant;
+          if (!runner.addCapture(*capture, extant)) {
+            return this->raiseRuntimeError("Captured symbol already declared as ", describe(extant), ": '", capture->name, "'");
           }
         }
       }
@@ -2322,9 +3156,9 @@ namespace {
           }
           return this->execution.raiseRuntimeError(message, nullptr);
         }
-        auto* extant = runner.addVariable(pname, ptype, &poly);
-        if (extant != nullptr) {
-          return this->raiseRuntimeError("Parameter symbol already declared as ", describe(extant->kind), ": '", pname, "'");
+        VMSymbolKind extant;
+        if (!runner.addVariable(pname, ptype, &poly, extant)) {
+          return this->raiseRuntimeError("Parameter symbol already declared as ", describe(extant), ": '", pname, "'");
         }
       }
       return HardValue::Void;
@@ -2338,14 +3172,21 @@ namespace {
     StepOutcome stepBlock(HardValue& retval, size_t first = 0);
     StepOutcome stepType();
     HardValue stepIteration(size_t first);
+    HardValue stepPairIteration(size_t first);
+    StepOutcome stepBytecode(const VMBytecode& bytecode);
+    bool callBytecode(IVMModule::Node& call, IObject& function, const ICallArguments& arguments, HardValue& result);
+    void remember() {
+      // Write barrier for new symbol table entries
+      this->vm.getBasket().remember(*this);
+    }
     NodeStack& push(IVMModule::Node& node, const String& scope = {}, size_t index = 0) {
       return this->stack.emplace(&node, scope, index);
     }
     StepOutcome pop(HardValue value) { // sic byval
       assert(!this->stack.empty());
-      const auto& symbol = this->stack.top().scope;
-      if (!symbol.empty()) {
-        (void)this->symtable.remove(symbol);
+      const auto& top = this->stack.top();
+      if (!top.scope.empty()) {
+        (void)this->symtable.remove(top.node->slot, top.scope);
       }
       this->stack.pop();
       assert(!this->stack.empty());
@@ -2354,9 +3195,9 @@ namespace {
     }
     StepOutcome pop2(HardValue value1, HardValue value2) { // sic byval
       assert(!this->stack.empty());
-      const auto& symbol = this->stack.top().scope;
-      if (!symbol.empty()) {
-        (void)this->symtable.remove(symbol);
+      const auto& top = this->stack.top();
+      if (!top.scope.empty()) {
+        (void)this->symtable.remove(top.node->slot, top.scope);
       }
       this->stack.pop();
       assert(!this->stack.empty());
@@ -2379,9 +3220,10 @@ namespace {
       }
       assert(!top.scope.empty());
       auto& poly = this->vm.createSoftValue();
-      auto* extant = this->symtable.add(VMSymbolTable::Kind::Type, top.scope, type, &poly);
-      if (extant != nullptr) {
-        switch (extant->kind) {
+      this->remember();
+      VMSymbolTable::Kind extant;
+      if (!this->symtable.add(top.node->slot, VMSymbolTable::Kind::Type, top.scope, type, &poly, extant)) {
+        switch (extant) {
         case VMSymbolTable::Kind::Builtin:
           this->raise("Variable symbol already declared as a builtin: '", top.scope, "'");
           return false;
@@ -2404,9 +3246,10 @@ namespace {
       }
       assert(!top.scope.empty());
       auto& poly = this->vm.createSoftValue();
-      auto* extant = this->symtable.add(VMSymbolTable::Kind::Variable, top.scope, type, &poly);
-      if (extant != nullptr) {
-        switch (extant->kind) {
+      this->remember();
+      VMSymbolTable::Kind extant;
+      if (!this->symtable.add(top.node->slot, VMSymbolTable::Kind::Variable, top.scope, type, &poly, extant)) {
+        switch (extant) {
         case VMSymbolTable::Kind::Builtin:
           this->raise("Variable symbol already declared as a builtin: '", top.scope, "'");
           return false;
@@ -2423,44 +3266,92 @@ namespace {
     void variableScopeEnd(NodeStack& top) {
       // Prematurely end the scope (e.g. in 'else' clause of guarded 'if' statement)
       if (!top.scope.empty()) {
-        (void)this->symtable.remove(top.scope);
+        (void)this->symtable.remove(top.node->slot, top.scope);
         top.scope = {};
       }
-    }
-    bool symbolSet(const IVMModule::Node* node, const HardValue& value) {
-      assert(node != nullptr);
-      String name;
-      if (!node->literal->getString(name)) {
-        this->raise("Invalid program node literal for variable identifier");
-        return false;
+    }
+    VMSymbolTable::Entry* symbolFind(const IVMModule::Node& node, const String& symbol) {
+      if (node.slot == VMSymbolTable::Unresolved) {
+        return this->symtable.find(symbol);
+      }
+      // A symbol resolved when the module was built must be in scope in its slot
+      auto* extant = this->symtable.find(node.slot);
+      assert(extant != nullptr);
+      assert(extant->name.equals(symbol));
+      return extant;
+    }
+    bool symbolSet(const IVMModule::Node* node, const HardValue& value) {
+      auto result = this->symbolAssign(node, value);
+      if (result.hasFlowControl()) {
+        this->pop(result);
+        return false;
+      }
+      return true;
+    }
+    HardValue symbolAssign(const IVMModule::Node* node, const HardValue& value) {
+      assert(node != nullptr);
+      String name;
+      if (!node->literal->getString(name)) {
+        return this->raiseRuntimeError("Invalid program node literal for variable identifier");
+      }
+      if (value.hasFlowControl()) {
+        return value;
+      }
+      if (value->getPrimitiveFlag() == ValueFlags::Void) {
+        return this->raiseRuntimeError("Cannot set variable '", name, "' to an uninitialized value");
+      }
+      auto extant = this->symbolFind(*node, name);
+      if (extant == nullptr) {
+        return this->raiseRuntimeError("Unknown variable: '", name, "'");
+      }
+      if (extant->kind == VMSymbolTable::Kind::Builtin) {
+        return this->raiseRuntimeError("Cannot re-assign built-in value: '", name, "'");
+      }
+      if (!this->execution.assignValue(*extant->soft, extant->type, value.get())) {
+        return this->raiseRuntimeError("Type mismatch setting variable '", name, "': expected '", extant->type, "' but instead got ", describe(value));
+      }
+      extant->kind = VMSymbolTable::Kind::Variable;
+      return HardValue::Void;
+    }
+    HardValue symbolGet(const IVMModule::Node& node) {
+      String symbol;
+      if (!node.literal->getString(symbol)) {
+        return this->raiseRuntimeError("Invalid program node literal for identifier");
+      }
+      auto extant = this->symbolFind(node, symbol);
+      if (extant == nullptr) {
+        return this->raiseRuntimeError("Unknown identifier: '", symbol, "'");
+      }
+      if (extant->kind == VMSymbolKind::Type) {
+        return this->raiseRuntimeError("Identifier '", symbol, "' is a type");
       }
-      if (value.hasFlowControl()) {
-        this->pop(value);
-        return false;
+      HardValue result{ *extant->soft };
+      if (result->getVoid()) {
+        return this->raiseRuntimeError("Variable uninitialized: '", symbol, "'");
       }
-      if (value->getPrimitiveFlag() == ValueFlags::Void) {
-        this->raise("Cannot set variable '", name, "' to an uninitialized value");
-        return false;
+      return result;
+    }
+    HardValue symbolModifiable(const IVMModule::Node& node, IValue*& soft) {
+      String symbol;
+      if (!node.literal->getString(symbol)) {
+        return this->raiseRuntimeError("Invalid program node literal for variable identifier");
       }
-      auto extant = this->symtable.find(name);
+      auto extant = this->symbolFind(node, symbol);
       if (extant == nullptr) {
-        this->raise("Unknown variable: '", name, "'");
-        return false;
+        return this->raiseRuntimeError("Unknown identifier: '", symbol, "'");
       }
       if (extant->kind == VMSymbolTable::Kind::Builtin) {
-        this->raise("Cannot re-assign built-in value: '", name, "'");
-        return false;
-      }
-      if (!this->execution.assignValue(*extant->soft, extant->type, value.get())) {
-        this->raise("Type mismatch setting variable '", name, "': expected '", extant->type, "' but instead got ", describe(value));
-        return false;
+        if (node.valueMutationOp == ValueMutationOp::Assign) {
+          return this->raiseRuntimeError("Cannot re-assign built-in value: '", symbol, "'");
+        }
+        return this->raiseRuntimeError("Cannot modify built-in value: '", symbol, "'");
       }
-      extant->kind = VMSymbolTable::Kind::Variable;
-      return true;
+      soft = extant->soft;
+      return HardValue::Void;
     }
-    HardValue symbolGuard(const HardValue& symbol, const HardValue& value) {
+    HardValue symbolGuard(const IVMModule::Node& node, const HardValue& value) {
       String name;
-      if (!symbol->getString(name)) {
+      if (!node.literal->getString(name)) {
         return this->raiseRuntimeError("Invalid program node literal for variable identifier");
       }
       if (value.hasFlowControl()) {
@@ -2469,7 +3360,7 @@ namespace {
       if (value->getPrimitiveFlag() == ValueFlags::Void) {
         return HardValue::False;
       }
-      auto extant = this->symtable.find(name);
+      auto extant = this->symbolFind(node, name);
       if (extant == nullptr) {
         return this->raiseRuntimeError("Unknown variable: '", name, "'");
       }
@@ -2482,10 +3373,10 @@ namespace {
       extant->kind = VMSymbolTable::Kind::Variable;
       return HardValue::True;
     }
-    HardValue arrayConstruct(const Type& elementType, Accessability accessability, const std::deque<HardValue>& elements, const std::vector<IVMModule::Node*>& mnodes) {
+    HardValue arrayConstruct(const Type& elementType, bool declared, Accessability accessability, const std::deque<HardValue>& elements, const VMModuleArray<IVMModule::Node>& mnodes) {
       // TODO: support '...' inclusion
       assert(elements.size() == mnodes.size());
-      auto array = ObjectFactory::createVanillaArray(this->vm, elementType, accessability);
+      auto array = ObjectFactory::createVanillaArray(this->vm, elementType, accessability, declared);
       assert(array != nullptr);
       if (!elements.empty()) {
         auto push = array->vmPropertyGet(this->execution, this->createHardValue("push"));
@@ -2522,7 +3413,7 @@ namespace {
       }
       return this->createHardValueObject(object);
     }
-    HardValue objectConstruct(const Type& runtimeType, const std::deque<HardValue>& elements, IVMModule::Node** pnodes) {
+    HardValue objectConstruct(const Type& runtimeType, const std::deque<HardValue>& elements, IVMModule::Node* const* pnodes) {
       assert(runtimeType.validate());
       assert((elements.size() % 2 ) == 0);
       auto builder = ObjectFactory::createObjectBuilder(this->vm, runtimeType, Accessability::All);
@@ -2563,7 +3454,7 @@ namespace {
         if (!capture.literal->getString(symbol)) {
           return this->raiseRuntimeError("Failed to fetch captured symbol name");
         }
-        auto* found = this->symtable.find(symbol);
+        auto* found = this->symbolFind(capture, symbol);
         if (found == nullptr) {
           return this->raiseRuntimeError("Cannot find required captured symbol: '", symbol, "'");
         }
@@ -2602,28 +3493,11 @@ namespace {
       if (name.equals("length")) {
         return this->createHardValueInt(Int(string.length()));
       }
-      using Factory = std::function<HardObject(IVM&, const String&)>;
-      static const std::map<std::string, Factory> map = {
-        { "compareTo", ObjectFactory::createStringProxyCompareTo },
-        { "contains", ObjectFactory::createStringProxyContains },
-        { "endsWith", ObjectFactory::createStringProxyEndsWith },
-        { "hash", ObjectFactory::createStringProxyHash },
-        { "indexOf", ObjectFactory::createStringProxyIndexOf },
-        { "join", ObjectFactory::createStringProxyJoin },
-        { "lastIndexOf", ObjectFactory::createStringProxyLastIndexOf },
-        { "padLeft", ObjectFactory::createStringProxyPadLeft },
-        { "padRight", ObjectFactory::createStringProxyPadRight },
-        { "repeat", ObjectFactory::createStringProxyRepeat },
-        { "replace", ObjectFactory::createStringProxyReplace },
-        { "slice", ObjectFactory::createStringProxySlice },
-        { "startsWith", ObjectFactory::createStringProxyStartsWith },
-        { "toString", ObjectFactory::createStringProxyToString }
-      };
-      auto found = map.find(name.toUTF8());
-      if (found == map.end()) {
+      auto* method = StringMethod::find(name);
+      if (method == nullptr) {
         return this->raiseRuntimeError("Unknown string property name: '", name, "'");
       }
-      return this->createHardValueObject(found->second(this->vm, string));
+      return this->createHardValueObject(ObjectFactory::createStringProxy(this->vm, string, *method));
     }
     HardValue stringPropertyRef(const String& string, const HardValue& property) {
       auto value = this->stringPropertyGet(string, property);
@@ -2634,6 +3508,93 @@ namespace {
       assert(pointer != nullptr);
       return this->createHardValueObject(pointer);
     }
+    HardValue indexGet(const HardValue& lhs, const HardValue& rhs) {
+      HardObject object;
+      if (lhs->getHardObject(object)) {
+        return object->vmIndexGet(this->execution, rhs);
+      }
+      String string;
+      if (lhs->getString(string)) {
+        return this->stringIndexGet(string, rhs);
+      }
+      return this->raiseRuntimeError("Expected left-hand side of index operator '[]' to support indexing, but instead got ", describe(lhs));
+    }
+    static bool isCallNode(const IVMModule::Node& node) {
+      return (node.kind == IVMModule::Node::Kind::ExprFunctionCall) || (node.kind == IVMModule::Node::Kind::ExprMethodCall);
+    }
+    static IObject::PropertyCache* propertyCache(const IVMModule::Node& node) {
+      // Inline caches are only valid if the property key is the same every time the node is evaluated
+      assert(node.children.size() >= 2);
+      return (node.children[1]->kind == IVMModule::Node::Kind::ExprLiteral) ? &node.cache : nullptr;
+    }
+    HardValue propertyGet(const HardValue& lhs, const HardValue& rhs, IObject::PropertyCache* cache = nullptr) {
+      HardObject object;
+      if (lhs->getHardObject(object)) {
+        if (cache != nullptr) {
+          return object->vmPropertyGetCached(this->execution, rhs, *cache);
+        }
+        return object->vmPropertyGet(this->execution, rhs);
+      }
+      String string;
+      if (lhs->getString(string)) {
+        return this->stringPropertyGet(string, rhs);
+      }
+      return this->raiseRuntimeError("Expected left-hand side of property operator '.' to support properties, but instead got ", describe(lhs));
+    }
+    HardValue pointeeGet(const HardValue& pointer) {
+      HardObject object;
+      if (pointer->getHardObject(object)) {
+        return object->vmPointeeGet(this->execution);
+      }
+      return this->raiseRuntimeError("Expected expression after pointer operator '*' to be a pointer, but instead got ", describe(pointer));
+    }
+    HardValue propertyMutate(const HardValue& instance, const HardValue& property, ValueMutationOp op, const HardValue& value, IObject::PropertyCache* cache = nullptr) {
+      // Perform the property assignment/mutation (object targets only, not strings)
+      HardObject object;
+      if (!instance->getHardObject(object)) {
+        std::string what;
+        Type type;
+        if (instance->getHardType(type)) {
+          what = "Types such as '" + describe(*type) + "'";
+        } else if (instance->getPrimitiveFlag() == ValueFlags::String) {
+          what = "Strings";
+        } else {
+          return this->raiseRuntimeError("Expected left-hand side of property operator '.' to be an object, but instead got ", describe(instance));
+        }
+        String pname;
+        if (property->getString(pname)) {
+          return this->raiseRuntimeError(what, " do not support modification of properties such as '", pname, "'");
+        }
+        return this->raiseRuntimeError(what, " do not support modification of properties");
+      }
+      if (op == ValueMutationOp::Assign) {
+        // Perform the property assignment (void return)
+        if (cache != nullptr) {
+          return object->vmPropertySetCached(this->execution, property, value, *cache);
+        }
+        return object->vmPropertySet(this->execution, property, value);
+      }
+      // Perform the property mutation (discard the result)
+      auto result = (cache != nullptr) ? object->vmPropertyMutCached(this->execution, property, op, value, *cache) : object->vmPropertyMut(this->execution, property, op, value);
+      return result.hasFlowControl() ? result : HardValue::Void;
+    }
+    HardValue indexMutate(const HardValue& instance, const HardValue& index, ValueMutationOp op, const HardValue& value) {
+      // Perform the current mutation (object targets only, not strings)
+      HardObject object;
+      if (!instance->getHardObject(object)) {
+        return this->raiseRuntimeError("Expected left-hand side of index operator '[]' to be an object, but instead got ", describe(instance));
+      }
+      auto result = object->vmIndexMut(this->execution, index, op, value);
+      return result.hasFlowControl() ? result : HardValue::Void;
+    }
+    HardValue pointeeMutate(const HardValue& pointer, ValueMutationOp op, const HardValue& value) {
+      HardObject object;
+      if (!pointer->getHardObject(object)) {
+        return this->raiseRuntimeError("Expected expression after pointer operator '*' to be an object, but instead got ", describe(pointer));
+      }
+      auto result = object->vmPointeeMut(this->execution, op, value);
+      return result.hasFlowControl() ? result : HardValue::Void;
+    }
     HardValue manifestationCreate(const HardValue& itype) {
       // TODO optimize
       Type infratype;
@@ -2674,7 +3635,7 @@ namespace {
 
   HardValue VMExecution::debugSymtable() {
     // TODO debugging only
-    StringBuilder sb;
+    StringBuilder sb{ this->vm.getAllocator() };
     this->runner->printSymtable(sb);
     return this->createHardValueString(sb.build(this->vm.getAllocator()));
   }
@@ -2718,8 +3679,12 @@ namespace {
         return execution.raiseRuntimeError(execution.createString("Recursive type manifestation instantiation"), nullptr);
       }
       if (current == ValueFlags::Void) {
-        // We need to instantiate the manifestation
-        instantiation.manifestation = this->createManifestation(execution, instantiation.type, parameters);
+        // We need to instantiate the manifestation, but failures are not cached
+        auto manifestation = this->createManifestation(execution, instantiation.type, parameters);
+        if (manifestation.hasAnyFlags(ValueFlags::Throw)) {
+          return manifestation;
+        }
+        instantiation.manifestation = manifestation;
       }
       return instantiation.manifestation;
     }
@@ -2836,7 +3801,7 @@ namespace {
     }
     String buildMetatypeName(const Type& infratype) const {
       // TODO
-      StringBuilder sb;
+      StringBuilder sb{ this->getAllocator() };
       infratype.print(sb);
       sb << ".Manifestation";
       return sb.build(this->getAllocator());
@@ -2874,6 +3839,7 @@ namespace {
       assert(manifestation.validate());
       auto added = this->manifestations.emplace(infratype, manifestation).second;
       assert(added);
+      this->vm.getBasket().remember(*this);
       return added;
     }
     HardObject find(const Type& infratype) const {
@@ -2892,14 +3858,20 @@ namespace {
   protected:
     HardPtr<IBasket> basket;
     ILogger& logger;
+    VMEngine engine;
     HardPtr<ITypeForge> forge;
     HardPtr<VMManifestations> manifestations;
     std::map<const IVMModule::Node*, HardPtr<IVMTypeSpecification>> specifications;
+    HardPtr<IObjectShapes> shapes;
+    HardPtr<IStringPool> strings;
   public:
-    VMDefault(IAllocator& allocator, ILogger& logger)
+    VMDefault(IAllocator& allocator, ILogger& logger, VMEngine engine)
       : HardReferenceCountedAllocator<IVM>(allocator),
         basket(BasketFactory::createBasket(allocator)),
-        logger(logger) {
+        logger(logger),
+        engine(engine),
+        shapes(ObjectFactory::createObjectShapes(allocator)),
+        strings(StringFactory::createStringPool(allocator)) {
       this->forge = TypeForgeFactory::createTypeForge(allocator, *this->basket);
       this->manifestations.set(allocator.makeRaw<VMManifestations>(*this));
       this->basket->take(*this->manifestations);
@@ -2922,6 +3894,9 @@ namespace {
     virtual ITypeForge& getTypeForge() const override {
       return *this->forge;
     }
+    virtual VMEngine getEngine() const override {
+      return this->engine;
+    }
     virtual IBasket& shutdown() override {
       // Used by 'egg::test::VM' to partially purge soft entities so we can check for leaks
       this->manifestations = nullptr;
@@ -2960,6 +3935,12 @@ namespace {
         specification->finalizeManifestation(infratype, this->createHardValueObject(manifestation));
       }
     }
+    virtual IObjectShapes& getObjectShapes() const override {
+      return *this->shapes;
+    }
+    virtual IStringPool& getStringPool() const override {
+      return *this->strings;
+    }
     virtual String createStringUTF8(const void* utf8, size_t bytes, size_t codepoints) override {
       return String::fromUTF8(this->allocator, utf8, bytes, codepoints);
     }
@@ -3012,11 +3993,13 @@ namespace {
       return ObjectFactory::createBuiltinSymtable(*this);
     }
   private:
-    virtual void softAcquire(ICollectable*& target, const ICollectable* value) override {
+    virtual void softAcquire(const ICollectable& owner, ICollectable*& target, const ICollectable* value) override {
       // TODO: thread safety
       assert(target == nullptr);
       if (value != nullptr) {
         target = this->basket->take(*value);
+        // Write barrier: this is a no-op for owners still under construction because they have not yet been adopted
+        this->basket->remember(owner);
       } else {
         target = nullptr;
       }
@@ -3031,7 +4014,7 @@ namespace {
       if (created != nullptr) {
         auto* taken = this->basket->take(*created);
         if (taken == created) {
-          if ((init == nullptr) || created->set(*init)) {
+          if ((init == nullptr) || created->set(this->allocator, *init)) {
             return created;
           }
         }
@@ -3058,14 +4041,15 @@ namespace {
     virtual bool softSetValue(IValue*& target, const IValue& value) override {
       // TODO: thread safety
       // Note we do not currently update the target pointer but may do later for optimization reasons
+      // The write barrier is applied by the soft value itself when it starts referring to an object
       assert(target != nullptr);
-      return target->set(value);
+      return target->set(this->allocator, value);
     }
     virtual HardValue softMutValue(IValue*& target, ValueMutationOp mutation, const IValue& value) override {
       // TODO: thread safety
       // Note we do not currently update the target pointer but may do later for optimization reasons
       assert(target != nullptr);
-      return target->mutate(mutation, value);
+      return target->mutate(this->allocator, mutation, value);
     }
     virtual HardValue softRefValue(const IValue& pointee, Modifiability modifiability) override {
       auto* alias = this->softCreateAlias(pointee);
@@ -3081,12 +4065,42 @@ void egg::ovum::IVMModule::Node::printLocation(Printer& printer) const {
   printer << this->module.getResource() << this->range << ": ";
 }
 
-void egg::ovum::IVMModule::Node::hardDestroy() const {
-  this->module.getAllocator().destroy(this);
+void egg::ovum::IVMModule::Node::addChild(Node& child) {
+  this->module.addChild(*this, child);
+}
+
+HardPtr<IVMModule> VMModuleBuilder::build() {
+  HardPtr<VMModule> built = this->module;
+  if (built != nullptr) {
+    this->module = nullptr;
+    VMSymbolResolver::resolve(built->getRoot());
+    if (this->vm.getEngine() == VMEngine::Bytecode) {
+      VMBytecode::lowerModule(built->getAllocator(), built->getRoot());
+    }
+    this->program->addModule(*built);
+  }
+  return built;
+}
+
+VMModule::~VMModule() {
+  // Only the node destructors need to run; the arena releases their storage wholesale
+  auto& allocator = this->getAllocator();
+  for (auto* node = this->chain; node != nullptr;) {
+    auto* next = node->chain;
+    if (node->bytecode != nullptr) {
+      allocator.destroy(node->bytecode);
+    }
+    node->~Node();
+    node = next;
+  }
 }
 
 VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
   auto& top = this->stack.top();
+  if (top.node->bytecode != nullptr) {
+    // The bytecode engine evaluates the whole tree in one step, unless a call needs to push a frame
+    return this->stepBytecode(*top.node->bytecode);
+  }
   switch (top.node->kind) {
   case IVMModule::Node::Kind::Root:
     assert(top.node->literal->getVoid());
@@ -3100,12 +4114,16 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     }
     break;
   case IVMModule::Node::Kind::StmtFunctionInvoke:
-    // Actually pushed on to the stack by 'VMRunner::initiateFunctionCall()'
+    // Actually pushed on to the stack by 'VMRunner::initiateFunctionCall()' or is the root of 'VMRunner::completeFunctionCall()'
     assert(top.index <= top.node->children.size());
     if (this->stepBlock(retval) != StepOutcome::Stepped) {
       if (retval.hasAnyFlags(ValueFlags::Return)) {
         retval->getInner(retval);
       }
+      if (this->stack.size() == 1) {
+        // The runner is discarded along with its only symbol table frame
+        return StepOutcome::Finished;
+      }
       this->symtable.pop();
       return this->pop(retval);
     }
@@ -3255,21 +4273,12 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     } else {
       // TODO: thread safety
       // Mutation
-      String symbol;
-      if (!top.node->literal->getString(symbol)) {
-        return this->raise("Invalid program node literal for variable identifier");
-      }
-      auto extant = this->symtable.find(symbol);
-      if (extant == nullptr) {
-        return this->raise("Unknown identifier: '", symbol, "'");
+      IValue* soft = nullptr;
+      auto modifiable = this->symbolModifiable(*top.node, soft);
+      if (modifiable.hasFlowControl()) {
+        return this->pop(modifiable);
       }
-      if (extant->kind == VMSymbolTable::Kind::Builtin) {
-        if (top.node->valueMutationOp == ValueMutationOp::Assign) {
-          return this->raise("Cannot re-assign built-in value: '", symbol, "'");
-        }
-        return this->raise("Cannot modify built-in value: '", symbol, "'");
-      }
-      HardValue lhs{ *extant->soft };
+      HardValue lhs{ *soft };
       if (top.index == 0) {
         assert(top.deque.empty());
         // TODO: Get correct rhs static type
@@ -3348,35 +4357,8 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       // Evaluate the expressions
       this->push(*top.node->children[top.index++]);
     } else {
-      // Perform the property assignment/mutation (object targets only, not strings)
       assert(top.deque.size() == 3);
-      auto& instance = top.deque.front();
-      auto& property = top.deque[1];
-      HardObject object;
-      if (!instance->getHardObject(object)) {
-        std::string what;
-        Type type;
-        if (instance->getHardType(type)) {
-          what = "Types such as '" + describe(*type) + "'";
-        } else if (instance->getPrimitiveFlag() == ValueFlags::String) {
-          what = "Strings";
-        } else {
-          return this->raise("Expected left-hand side of property operator '.' to be an object, but instead got ", describe(instance));
-        }
-        String pname;
-        if (property->getString(pname)) {
-          return this->raise(what, " do not support modification of properties such as '", pname, "'");
-        }
-        return this->raise(what, " do not support modification of properties");
-      }
-      auto& value = top.deque.back();
-      if (top.node->valueMutationOp == ValueMutationOp::Assign) {
-        // Perform the property assignment (void return)
-        return this->pop(object->vmPropertySet(this->execution, property, value));
-      }
-      // Perform the property mutation (discard the result)
-      auto result = object->vmPropertyMut(this->execution, property, top.node->valueMutationOp, value);
-      return this->pop(result.hasFlowControl() ? result : HardValue::Void);
+      return this->pop(this->propertyMutate(top.deque.front(), top.deque[1], top.node->valueMutationOp, top.deque.back(), VMRunner::propertyCache(*top.node)));
     }
     break;
   case IVMModule::Node::Kind::StmtIndexMutate:
@@ -3394,17 +4376,8 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       // Evaluate the expressions
       this->push(*top.node->children[top.index++]);
     } else {
-      // Perform the current mutation (object targets only, not strings)
       assert(top.deque.size() == 3);
-      auto& instance = top.deque.front();
-      HardObject object;
-      if (!instance->getHardObject(object)) {
-        return this->raise("Expected left-hand side of index operator '[]' to be an object, but instead got ", describe(instance));
-      }
-      auto& index = top.deque[1];
-      auto& value = top.deque.back();
-      auto result = object->vmIndexMut(this->execution, index, top.node->valueMutationOp, value);
-      return this->pop(result.hasFlowControl() ? result : HardValue::Void);
+      return this->pop(this->indexMutate(top.deque.front(), top.deque[1], top.node->valueMutationOp, top.deque.back()));
     }
     break;
   case IVMModule::Node::Kind::StmtPointerMutate:
@@ -3424,14 +4397,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     } else {
       // Perform the current mutation
       assert(top.deque.size() == 2);
-      auto& pointer = top.deque.front();
-      HardObject object;
-      if (!pointer->getHardObject(object)) {
-        return this->raise("Expected expression after pointer operator '*' to be an object, but instead got ", describe(pointer));
-      }
-      auto& value = top.deque.back();
-      auto result = object->vmPointeeMut(this->execution, top.node->valueMutationOp, value);
-      return this->pop(result.hasFlowControl() ? result : HardValue::Void);
+      return this->pop(this->pointeeMutate(top.deque.front(), top.node->valueMutationOp, top.deque.back()));
     }
     break;
   case IVMModule::Node::Kind::StmtIf:
@@ -3580,7 +4546,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
         }
         top.deque.resize(1);
       }
-      auto value = this->stepIteration(2);
+      auto value = top.node->pairwise ? this->stepPairIteration(2) : this->stepIteration(2);
       if (value.hasFlowControl()) {
         // Iteration failed
         if (value->getPrimitiveFlag() == ValueFlags::Break) {
@@ -4058,6 +5024,57 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       return this->pop(result);
     }
     break;
+  case IVMModule::Node::Kind::ExprMethodCall:
+    assert(top.node->literal->getVoid());
+    assert(top.node->children.size() >= 2);
+    assert(top.index <= top.node->children.size());
+    if (!top.deque.empty()) {
+      // Check the last evaluation
+      auto& latest = top.deque.back();
+      if (latest.hasFlowControl()) {
+        return this->pop(latest);
+      }
+    }
+    if ((top.index == 2) && (top.deque.size() == 2)) {
+      // Resolve the method before evaluating any arguments
+      auto& instance = top.deque[0];
+      String string;
+      if ((top.node->stringMethod == nullptr) || !instance->getString(string)) {
+        auto method = this->propertyGet(instance, top.deque[1], VMRunner::propertyCache(*top.node));
+        if (method.hasFlowControl()) {
+          return this->pop(method);
+        }
+        // Property values may be live aliases, so capture the function object itself
+        if (!method->getHardObject(top.method)) {
+          return this->raise("Function calls are not supported by ", describe(method));
+        }
+      }
+    }
+    if (top.index < top.node->children.size()) {
+      // Assemble the instance, method and arguments
+      this->push(*top.node->children[top.index++]);
+    } else {
+      // Perform the method call
+      assert(top.deque.size() >= 2);
+      auto& instance = top.deque[0];
+      CallArguments arguments;
+      for (size_t index = 2; index < top.deque.size(); ++index) {
+        arguments.addUnnamed(top.deque[index], &top.node->children[index]->range);
+      }
+      String string;
+      if ((top.node->stringMethod != nullptr) && instance->getString(string)) {
+        // Dispatch directly to the native string member function without materializing a proxy object
+        return this->pop(top.node->stringMethod->call(this->vm, this->execution, string, arguments));
+      }
+      assert(top.method != nullptr);
+      auto result = top.method->vmCall(this->execution, arguments);
+      if (result->getPrimitiveFlag() == ValueFlags::Continue) {
+        // The invocation resulted in a tail call
+        return StepOutcome::Stepped;
+      }
+      return this->pop(result);
+    }
+    break;
   case IVMModule::Node::Kind::ExprUnaryOp:
     assert(top.node->children.size() == 1);
     assert(top.index <= 1);
@@ -4181,25 +5198,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     assert(top.node->children.empty());
     assert(top.index == 0);
     assert(top.deque.empty());
-    {
-      String symbol;
-      if (!top.node->literal->getString(symbol)) {
-        return this->raise("Invalid program node literal for identifier");
-      }
-      auto extant = this->symtable.find(symbol);
-      if (extant == nullptr) {
-        return this->raise("Unknown identifier: '", symbol, "'");
-      }
-      if (extant->kind == VMSymbolKind::Type) {
-        return this->raise("Identifier '", symbol, "' is a type");
-      }
-      HardValue result{ *extant->soft };
-      if (result->getVoid()) {
-        return this->raise("Variable uninitialized: '", symbol, "'");
-      }
-      return this->pop(result);
-    }
-    break;
+    return this->pop(this->symbolGet(*top.node));
   case IVMModule::Node::Kind::ExprVariableRef:
     assert(top.node->children.empty());
     assert(top.index == 0);
@@ -4209,7 +5208,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       if (!top.node->literal->getString(symbol)) {
         return this->raise("Invalid program node literal for identifier");
       }
-      auto extant = this->symtable.find(symbol);
+      auto extant = this->symbolFind(*top.node, symbol);
       if (extant == nullptr) {
         return this->raise("Unknown identifier: '", symbol, "'");
       }
@@ -4235,17 +5234,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     } else {
       // Perform the current fetch
       assert(top.deque.size() == 2);
-      auto& lhs = top.deque.front();
-      auto& rhs = top.deque.back();
-      HardObject object;
-      if (lhs->getHardObject(object)) {
-        return this->pop(object->vmIndexGet(this->execution, rhs));
-      }
-      String string;
-      if (lhs->getString(string)) {
-        return this->pop(this->stringIndexGet(string, rhs));
-      }
-      return this->raise("Expected left-hand side of index operator '[]' to support indexing, but instead got ", describe(lhs));
+      return this->pop(this->indexGet(top.deque.front(), top.deque.back()));
     }
     break;
   case IVMModule::Node::Kind::ExprIndexRef:
@@ -4293,17 +5282,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     } else {
       // Perform the property fetch
       assert(top.deque.size() == 2);
-      auto& lhs = top.deque.front();
-      auto& rhs = top.deque.back();
-      HardObject object;
-      if (lhs->getHardObject(object)) {
-        return this->pop(object->vmPropertyGet(this->execution, rhs));
-      }
-      String string;
-      if (lhs->getString(string)) {
-        return this->pop(this->stringPropertyGet(string, rhs));
-      }
-      return this->raise("Expected left-hand side of property operator '.' to support properties, but instead got ", describe(lhs));
+      return this->pop(this->propertyGet(top.deque.front(), top.deque.back(), VMRunner::propertyCache(*top.node)));
     }
     break;
   case IVMModule::Node::Kind::ExprPropertyRef:
@@ -4351,12 +5330,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
     } else {
       // Perform the current fetch
       assert(top.deque.size() == 1);
-      auto& pointer = top.deque.front();
-      HardObject object;
-      if (pointer->getHardObject(object)) {
-        return this->pop(object->vmPointeeGet(this->execution));
-      }
-      return this->raise("Expected expression after pointer operator '*' to be a pointer, but instead got ", describe(pointer));
+      return this->pop(this->pointeeGet(top.deque.front()));
     }
     break;
   case IVMModule::Node::Kind::ExprArrayConstruct:
@@ -4376,7 +5350,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       if (!top.node->literal->getHardType(elementType) || (elementType == nullptr)) {
         return this->raise("Invalid type literal module node for array expression");
       }
-      return this->pop(this->arrayConstruct(elementType, Accessability::All, top.deque, top.node->children));
+      return this->pop(this->arrayConstruct(elementType, top.node->declared, Accessability::All, top.deque, top.node->children));
     }
     break;
   case IVMModule::Node::Kind::ExprEonConstruct:
@@ -4472,7 +5446,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       if (expr.hasFlowControl()) {
         return this->pop(expr);
       }
-      return this->pop(this->symbolGuard(top.node->literal, expr));
+      return this->pop(this->symbolGuard(*top.node, expr));
     }
     break;
   case IVMModule::Node::Kind::ExprNamed:
@@ -4486,7 +5460,7 @@ VMRunner::StepOutcome VMRunner::stepNode(HardValue& retval) {
       if (!top.node->literal->getString(symbol)) {
         return this->raise("Invalid program node literal for type identifier");
       }
-      auto extant = this->symtable.find(symbol);
+      auto extant = this->symbolFind(*top.node, symbol);
       if (extant == nullptr) {
         return this->raise("Unknown identifier: '", symbol, "'");
       }
@@ -4611,6 +5585,8 @@ VMRunner::StepOutcome VMRunner::stepBlock(HardValue& retval, size_t first) {
   }
   assert(top.deque.empty());
   if (top.index < top.node->children.size()) {
+    // Statement boundaries are safe points for automatic collections
+    (void)this->vm.getBasket().poll();
     // Execute all the statements
     this->push(*top.node->children[top.index++]);
   } else {
@@ -4661,6 +5637,12 @@ HardValue VMRunner::stepIteration(size_t first) {
       return iterator;
     }
     if (iterator->getHardObject(object)) {
+      // Containers that can be iterated by cursor do not need an iterator object
+      auto next = object->vmIterateNext(this->execution, top.cursor);
+      if (next->getPrimitiveFlag() != ValueFlags::Break) {
+        top.index++;
+        return next;
+      }
       // Make sure this object is iterable
       iterator = object->vmIterate(this->execution);
       if (iterator.hasFlowControl()) {
@@ -4670,15 +5652,20 @@ HardValue VMRunner::stepIteration(size_t first) {
   }
   // Fetch the next iterated value
   if (iterator->getHardObject(object)) {
-    // Iterate over the values returned from a "<type>()" function
     top.index++;
+    auto next = object->vmIterateNext(this->execution, top.cursor);
+    if (next->getPrimitiveFlag() != ValueFlags::Break) {
+      return next;
+    }
+    // Iterate over the values returned from a "<type>()" function
     CallArguments empty{};
     return object->vmCall(execution, empty);
   }
   String string;
   if (iterator->getString(string)) {
-    // Iterate over the codepoints in the string
-    auto cp = string.codePointAt(top.index++ - first);
+    // Iterate over the codepoints in the string, keeping the byte offset in the cursor
+    top.index++;
+    auto cp = string.codePointNext(top.cursor.index);
     if (cp < 0) {
       // Completed
       return HardValue::Void;
@@ -4689,6 +5676,290 @@ HardValue VMRunner::stepIteration(size_t first) {
   return HardValue::Break;
 }
 
+HardValue VMRunner::stepPairIteration(size_t first) {
+  // The control variable cannot escape, so containers may rebind a single key-value pair held in 'top.value'
+  auto& top = this->stack.top();
+  assert(top.index >= first);
+  assert(top.deque.size() == 1);
+  if ((top.index == first) || (top.value->getPrimitiveFlag() == ValueFlags::Object)) {
+    HardObject object;
+    if (top.deque.front()->getHardObject(object)) {
+      auto retval = object->vmIteratePairs(this->execution, top.value);
+      if (retval->getPrimitiveFlag() != ValueFlags::Break) {
+        top.index++;
+        return retval;
+      }
+    }
+  }
+  return this->stepIteration(first);
+}
+
+VMRunner::StepOutcome VMRunner::stepBytecode(const VMBytecode& bytecode) {
+  auto& top = this->stack.top();
+  auto* previous = this->current;
+  const auto* code = bytecode.code.data();
+  size_t count = bytecode.code.size();
+  size_t pc = top.index;
+  size_t base = top.base;
+  auto reg = [this, &base](size_t index) -> HardValue& {
+    return this->registers[base + index];
+  };
+  HardValue result;
+  if (pc == 0) {
+    // Claim a register window at the top of the runner's register file, which only ever grows
+    assert(top.deque.empty());
+    base = this->windows;
+    this->windows += bytecode.registers;
+    if (this->registers.size() < this->windows) {
+      this->registers.resize(this->windows);
+    }
+  } else {
+    // Resume after the call whose callee frame has just completed
+    assert(top.deque.size() == 1);
+    assert(base + bytecode.registers == this->windows);
+    auto& value = top.deque.front();
+    if (value.hasFlowControl()) {
+      result = std::move(value);
+      pc = count;
+    } else {
+      reg(code[pc - 1].target) = std::move(value);
+    }
+    top.deque.clear();
+  }
+  IValue* soft;
+  Bool condition;
+  HardObject function;
+  String string;
+  while (pc < count) {
+    const auto& instruction = code[pc++];
+    const auto& node = *instruction.node;
+    auto target = instruction.target;
+    this->current = &node;
+    switch (instruction.opcode) {
+    case VMBytecode::Opcode::Literal:
+      reg(target) = node.literal;
+      break;
+    case VMBytecode::Opcode::VariableGet:
+      reg(target) = this->symbolGet(node);
+      break;
+    case VMBytecode::Opcode::UnaryOp:
+      reg(target) = this->execution.evaluateValueUnaryOp(node.valueUnaryOp, reg(target));
+      break;
+    case VMBytecode::Opcode::BinaryOp:
+      reg(target) = this->execution.evaluateValueBinaryOp(node.valueBinaryOp, reg(target), reg(target + 1));
+      break;
+    case VMBytecode::Opcode::PredicateOp:
+      if (node.children.size() == 1) {
+        reg(target) = this->execution.evaluateValuePredicateOp(node.valuePredicateOp, reg(target), HardValue::Void);
+      } else {
+        reg(target) = this->execution.evaluateValuePredicateOp(node.valuePredicateOp, reg(target), reg(target + 1));
+      }
+      break;
+    case VMBytecode::Opcode::IndexGet:
+      reg(target) = this->indexGet(reg(target), reg(target + 1));
+      break;
+    case VMBytecode::Opcode::PropertyGet:
+      reg(target) = this->propertyGet(reg(target), reg(target + 1), VMRunner::propertyCache(node));
+      break;
+    case VMBytecode::Opcode::PointeeGet:
+      reg(target) = this->pointeeGet(reg(target));
+      break;
+    case VMBytecode::Opcode::BranchIfNotNull:
+      if (!reg(target)->getNull()) {
+        pc = instruction.jump;
+      }
+      break;
+    case VMBytecode::Opcode::BranchIfTrue:
+      if (reg(target)->getBool(condition) && condition) {
+        reg(target) = HardValue::True;
+        pc = instruction.jump;
+      }
+      break;
+    case VMBytecode::Opcode::BranchIfFalse:
+      if (reg(target)->getBool(condition) && !condition) {
+        reg(target) = HardValue::False;
+        pc = instruction.jump;
+      }
+      break;
+    case VMBytecode::Opcode::BranchUnless:
+      if (!reg(target)->getBool(condition)) {
+        // The second and third operands are irrelevant; we just want the error message
+        reg(target) = this->execution.evaluateValueTernaryOp(node.valueTernaryOp, reg(target), HardValue::Void, HardValue::Void);
+      } else if (!condition) {
+        pc = instruction.jump;
+      }
+      break;
+    case VMBytecode::Opcode::Jump:
+      pc = instruction.jump;
+      break;
+    case VMBytecode::Opcode::VariableSet:
+      reg(target) = this->symbolAssign(&node, reg(target));
+      break;
+    case VMBytecode::Opcode::VariablePrecheck:
+      soft = nullptr;
+      reg(target) = this->symbolModifiable(node, soft);
+      if (soft != nullptr) {
+        HardValue lhs{ *soft };
+        // TODO: Get correct rhs static type
+        auto precheck = this->execution.precheckValueMutationOp(node.valueMutationOp, lhs, ValueFlags::AnyQ);
+        if (!precheck.hasFlowControl()) {
+          // Short-circuit (discard result)
+          pc = instruction.jump;
+        } else if (precheck->getPrimitiveFlag() != ValueFlags::Continue) {
+          reg(target) = precheck;
+        }
+      }
+      break;
+    case VMBytecode::Opcode::VariableMutate:
+      soft = nullptr;
+      {
+        auto modifiable = this->symbolModifiable(node, soft);
+        if (soft != nullptr) {
+          HardValue lhs{ *soft };
+          auto before = this->execution.evaluateValueMutationOp(node.valueMutationOp, lhs, reg(target));
+          reg(target) = before.hasFlowControl() ? before : HardValue::Void;
+        } else {
+          reg(target) = modifiable;
+        }
+      }
+      break;
+    case VMBytecode::Opcode::PropertyMutate:
+      reg(target) = this->propertyMutate(reg(target), reg(target + 1), node.valueMutationOp, reg(target + 2), VMRunner::propertyCache(node));
+      break;
+    case VMBytecode::Opcode::IndexMutate:
+      reg(target) = this->indexMutate(reg(target), reg(target + 1), node.valueMutationOp, reg(target + 2));
+      break;
+    case VMBytecode::Opcode::PointeeMutate:
+      reg(target) = this->pointeeMutate(reg(target), node.valueMutationOp, reg(target + 1));
+      break;
+    case VMBytecode::Opcode::Return:
+      reg(target) = ValueFactory::createHardReturn(this->getAllocator(), reg(target));
+      break;
+    case VMBytecode::Opcode::Void:
+      reg(target) = HardValue::Void;
+      break;
+    case VMBytecode::Opcode::Poll:
+      (void)this->vm.getBasket().poll();
+      break;
+    case VMBytecode::Opcode::Discard:
+      if (reg(target)->getPrimitiveFlag() != ValueFlags::Void) {
+        this->log(ILogger::Source::Runtime, ILogger::Severity::Warning, this->createString("Discarded value in statement")); // TODO
+        reg(target) = HardValue::Void;
+      }
+      break;
+    case VMBytecode::Opcode::BranchUnlessCondition:
+      if (!reg(target)->getBool(condition)) {
+        switch (node.kind) {
+        case IVMModule::Node::Kind::StmtIf:
+          reg(target) = this->raiseRuntimeError("Expected 'if' condition to be a 'bool', but instead got ", describe(reg(target)));
+          break;
+        case IVMModule::Node::Kind::StmtWhile:
+          reg(target) = this->raiseRuntimeError("Expected 'while' condition to be a 'bool', but instead got ", describe(reg(target)));
+          break;
+        default:
+          assert(node.kind == IVMModule::Node::Kind::StmtForLoop);
+          reg(target) = this->raiseRuntimeError("Expected 'for' condition to be a 'bool', but instead got ", describe(reg(target)));
+          break;
+        }
+      } else if (!condition) {
+        pc = instruction.jump;
+      }
+      break;
+    case VMBytecode::Opcode::Call:
+      if (!reg(target)->getHardObject(function)) {
+        reg(target) = this->raiseRuntimeError("Function calls are not supported by ", describe(reg(target)));
+      } else {
+        CallArguments arguments;
+        for (size_t index = 1; index < node.children.size(); ++index) {
+          // TODO support named arguments
+          arguments.addUnnamed(reg(target + index), &node.children[index]->range);
+        }
+        if (!this->callBytecode(*instruction.node, *function, arguments, result)) {
+          // Suspend until the callee's frame completes
+          top.index = pc;
+          top.base = base;
+          this->current = previous;
+          return StepOutcome::Stepped;
+        }
+        reg(target) = std::move(result);
+      }
+      break;
+    case VMBytecode::Opcode::MethodResolve:
+      if ((node.stringMethod == nullptr) || !reg(target)->getString(string)) {
+        auto method = this->propertyGet(reg(target), reg(target + 1), VMRunner::propertyCache(node));
+        if (method.hasFlowControl()) {
+          reg(target) = method;
+        } else if (!method->getHardObject(function)) {
+          reg(target) = this->raiseRuntimeError("Function calls are not supported by ", describe(method));
+        } else {
+          // Property values may be live aliases, so capture the function object itself
+          reg(target + 1) = this->createHardValueObject(function);
+        }
+      }
+      break;
+    case VMBytecode::Opcode::MethodCall:
+      {
+        CallArguments arguments;
+        for (size_t index = 2; index < node.children.size(); ++index) {
+          arguments.addUnnamed(reg(target + index), &node.children[index]->range);
+        }
+        if ((node.stringMethod != nullptr) && reg(target)->getString(string)) {
+          // Dispatch directly to the native string member function without materializing a proxy object
+          reg(target) = node.stringMethod->call(this->vm, this->execution, string, arguments);
+          break;
+        }
+        if (!reg(target + 1)->getHardObject(function)) {
+          reg(target) = this->raiseRuntimeError("Function calls are not supported by ", describe(reg(target + 1)));
+          break;
+        }
+        if (!this->callBytecode(*instruction.node, *function, arguments, result)) {
+          // Suspend until the callee's frame completes
+          top.index = pc;
+          top.base = base;
+          this->current = previous;
+          return StepOutcome::Stepped;
+        }
+        reg(target) = std::move(result);
+      }
+      break;
+    }
+    if (reg(target).hasFlowControl()) {
+      // Propagate exceptions and returns immediately
+      result = std::move(reg(target));
+      break;
+    }
+  }
+  if (!result.hasFlowControl()) {
+    result = std::move(reg(0));
+  }
+  // Release the window, dropping its references but keeping the storage for later evaluations
+  assert(base + bytecode.registers == this->windows);
+  for (size_t index = 0; index < bytecode.registers; ++index) {
+    reg(index) = HardValue::Void;
+  }
+  this->windows = base;
+  this->current = previous;
+  return this->pop(result);
+}
+
+bool VMRunner::callBytecode(IVMModule::Node& call, IObject& function, const ICallArguments& arguments, HardValue& result) {
+  // Push a frame for the call node: VM functions replace it with their invocation and return 'Continue'
+  assert(VMRunner::isCallNode(call));
+  auto depth = this->stack.size();
+  this->push(call);
+  result = function.vmCall(this->execution, arguments);
+  if (result->getPrimitiveFlag() == ValueFlags::Continue) {
+    // The invocation is now on top of the stack
+    return false;
+  }
+  if (this->stack.size() > depth) {
+    // Native functions and generators leave the call frame in place
+    assert(this->stack.top().node == &call);
+    this->stack.pop();
+  }
+  return true;
+}
+
 HardPtr<IVMRunner> VMModule::createRunner(IVMProgram& program) {
   // The constructor takes the runner into the VM's basket
   return HardPtr(this->getAllocator().makeRaw<VMRunner>(this->vm, program, *this->root));
@@ -4719,6 +5990,9 @@ HardValue VMExecution::initiateFunctionCall(const IFunctionSignature& signature,
   auto* invoke = definition.children[1];
   assert(invoke != nullptr);
   if (invoke->kind == IVMModule::Node::Kind::StmtFunctionInvoke) {
+    if (std::exchange(this->synchronous, false)) {
+      return this->runner->completeFunctionCall(signature, *invoke, arguments, captures);
+    }
     return this->runner->initiateFunctionCall(signature, *invoke, arguments, captures);
   }
   assert(invoke->kind == IVMModule::Node::Kind::StmtGeneratorInvoke);
@@ -4727,9 +6001,13 @@ HardValue VMExecution::initiateFunctionCall(const IFunctionSignature& signature,
 
 HardValue VMExecution::initiateManifestationCall(const Type& infratype, const IVMModule::Node& specification, const IVMTypeSpecification::Parameters& parameters, const IVMCallCaptures* captures) {
   assert(this->runner != nullptr);
+  if (std::exchange(this->synchronous, false)) {
+    // Manifestations are stepped on the runner's own stack, which native callers cannot resume
+    return this->raiseRuntimeError(this->createString("Type manifestation cannot be instantiated from within a native call"), nullptr);
+  }
   return this->runner->initiateManifestationCall(infratype, specification, parameters, captures);
 }
 
-egg::ovum::HardPtr<IVM> egg::ovum::VMFactory::createDefault(IAllocator& allocator, ILogger& logger) {
-  return allocator.makeHard<VMDefault>(logger);
+egg::ovum::HardPtr<IVM> egg::ovum::VMFactory::createDefault(IAllocator& allocator, ILogger& logger, VMEngine engine) {
+  return allocator.makeHard<VMDefault>(logger, engine);
 }
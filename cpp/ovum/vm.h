@@ -8,6 +8,11 @@ namespace egg::ovum {
     Type
   };
 
+  enum class VMEngine {
+    TreeWalker, // Steps through the module nodes directly (reference implementation)
+    Bytecode // Lowers expressions to register-based bytecode where possible
+  };
+
   class IVMCommon {
   public:
     // Interface
@@ -152,6 +157,7 @@ namespace egg::ovum {
     // Function calls
     virtual HardValue initiateFunctionCall(const IFunctionSignature& signature, const IVMModule::Node& definition, const ICallArguments& arguments, const IVMCallCaptures* captures) = 0;
     virtual HardValue initiateManifestationCall(const Type& infratype, const IVMModule::Node& specification, const IVMTypeSpecification::Parameters& parameters, const IVMCallCaptures* captures) = 0;
+    virtual HardValue callFunction(const HardObject& function, const ICallArguments& arguments) = 0; // Runs to completion, even for script functions
     // Soft values
     virtual HardValue getSoftValue(const SoftValue& soft) = 0;
     virtual bool setSoftValue(SoftValue& lhs, const HardValue& rhs) = 0;
@@ -207,6 +213,7 @@ namespace egg::ovum {
     virtual Node& exprValuePredicateOp(ValuePredicateOp op, const SourceRange& range) = 0;
     virtual Node& exprLiteral(const HardValue& literal, const SourceRange& range) = 0;
     virtual Node& exprFunctionCall(Node& function, const SourceRange& range) = 0;
+    virtual Node& exprMethodCall(Node& instance, Node& property, const SourceRange& range) = 0;
     virtual Node& exprVariableGet(const String& symbol, const SourceRange& range) = 0;
     virtual Node& exprPropertyGet(Node& instance, Node& property, const SourceRange& range) = 0;
     virtual Node& exprIndexGet(Node& instance, Node& index, const SourceRange& range) = 0;
@@ -214,7 +221,7 @@ namespace egg::ovum {
     virtual Node& exprVariableRef(const String& symbol, const SourceRange& range) = 0;
     virtual Node& exprPropertyRef(Node& instance, Node& property, const SourceRange& range) = 0;
     virtual Node& exprIndexRef(Node& instance, Node& index, const SourceRange& range) = 0;
-    virtual Node& exprArrayConstruct(const Type& elementType, const SourceRange& range) = 0;
+    virtual Node& exprArrayConstruct(const Type& elementType, bool declared, const SourceRange& range) = 0;
     virtual Node& exprEonConstruct(const SourceRange& range) = 0;
     virtual Node& exprObjectConstruct(Node& objectType, const SourceRange& range) = 0;
     virtual Node& exprObjectConstructProperty(const String& property, Node& type, Node& value, Accessability accessability, const SourceRange& range) = 0;
@@ -240,7 +247,7 @@ namespace egg::ovum {
     virtual Node& stmtIf(Node& condition, const SourceRange& range) = 0;
     virtual Node& stmtWhile(Node& condition, Node& block, const SourceRange& range) = 0;
     virtual Node& stmtDo(Node& block, Node& condition, const SourceRange& range) = 0;
-    virtual Node& stmtForEach(const String& symbol, Node& type, Node& iteration, Node& block, const SourceRange& range) = 0;
+    virtual Node& stmtForEach(const String& symbol, Node& type, Node& iteration, Node& block, bool pairwise, const SourceRange& range) = 0;
     virtual Node& stmtForLoop(Node& initial, Node& condition, Node& advance, Node& block, const SourceRange& range) = 0;
     virtual Node& stmtSwitch(Node& expression, size_t defaultIndex, const SourceRange& range) = 0;
     virtual Node& stmtCase(Node& block, const SourceRange& range) = 0;
@@ -302,6 +309,7 @@ namespace egg::ovum {
     virtual IBasket& getBasket() const = 0;
     virtual ILogger& getLogger() const = 0;
     virtual ITypeForge& getTypeForge() const = 0;
+    virtual VMEngine getEngine() const = 0;
     virtual IBasket& shutdown() = 0;
     // Specification cache
     virtual void addTypeSpecification(IVMTypeSpecification& specification, const IVMModule::Node* node) = 0;
@@ -310,6 +318,10 @@ namespace egg::ovum {
     virtual void addManifestation(const Type& infratype, const HardObject& manifestation) = 0;
     virtual HardObject findManifestation(const Type& infratype) = 0;
     virtual void finalizeManifestation(const Type& infratype, const HardObject& manifestation) = 0;
+    // Shape cache
+    virtual IObjectShapes& getObjectShapes() const = 0;
+    // Intern table for identifiers and property names
+    virtual IStringPool& getStringPool() const = 0;
     // Builder factories
     virtual HardPtr<IVMProgramBuilder> createProgramBuilder() = 0;
     virtual HardPtr<IVMTypeSpecificationBuilder> createTypeSpecificationBuilder(const IVMModule::Node* spec) = 0;
@@ -331,6 +343,10 @@ namespace egg::ovum {
       return *soft;
     }
     IValue& createSoftAlias(const HardValue& value) {
+      if (value.isImmediate()) {
+        // Immediates have no identity to alias, so take a copy
+        return this->createSoftValue(value);
+      }
       auto* soft = this->softCreateAlias(value.get());
       assert(soft != nullptr);
       return *soft;
@@ -358,13 +374,13 @@ namespace egg::ovum {
       return this->softRefValue(*instance.ptr.ptr, modifiability);
     }
     template<typename T>
-    T* acquireSoftObject(const T* hard) {
+    T* acquireSoftObject(const ICollectable& owner, const T* hard) {
       // TODO simplify?
       if (hard == nullptr) {
         return nullptr;
       }
       ICollectable* soft = nullptr;
-      this->softAcquire(soft, hard);
+      this->softAcquire(owner, soft, hard);
       assert(soft != nullptr);
       return static_cast<T*>(soft);
     }
@@ -372,7 +388,7 @@ namespace egg::ovum {
     virtual IValue* softCreateValue(const IValue* init) = 0;
     virtual IValue* softCreateAlias(const IValue& value) = 0;
     virtual IValue* softCreateOwned(const IValue& value) = 0;
-    virtual void softAcquire(ICollectable*& target, const ICollectable* value) = 0;
+    virtual void softAcquire(const ICollectable& owner, ICollectable*& target, const ICollectable* value) = 0; // Applies the write barrier to 'owner'
     virtual HardValue softHarden(const IValue& soft) = 0;
     virtual bool softSetValue(IValue*& soft, const IValue& value) = 0;
     virtual HardValue softMutValue(IValue*& soft, ValueMutationOp mutation, const IValue& value) = 0;
@@ -382,7 +398,7 @@ namespace egg::ovum {
   class VMFactory {
   public:
     // VM factories
-    static HardPtr<IVM> createDefault(IAllocator& allocator, ILogger& logger);
+    static HardPtr<IVM> createDefault(IAllocator& allocator, ILogger& logger, VMEngine engine = VMEngine::TreeWalker);
     // Function/generator factories
     static HardObject createFunction(IVM& vm, const Type& ftype, const IFunctionSignature& signature, const IVMModule::Node& definition, std::vector<VMCallCapture>&& captures);
     static HardObject createGeneratorIterator(IVM& vm, const Type& ftype, IVMRunner& runner);
@@ -36,7 +36,7 @@ namespace {
     HardPtr<IVMProgram> build() {
       auto& vm = this->engine->getVM();
       auto& allocator = vm.getAllocator();
-      auto tokenizer = EggTokenizerFactory::createFromLexer(allocator, lexer);
+      auto tokenizer = EggTokenizerFactory::createFromLexer(allocator, lexer, &vm.getStringPool());
       auto parser = EggParserFactory::createFromTokenizer(allocator, tokenizer);
       auto builder = vm.createProgramBuilder();
       size_t index = 0;
@@ -179,7 +179,9 @@ namespace {
     }
     virtual IBasket& getBasket() override {
       if (this->qbasket == nullptr) {
-        this->withBasket(*BasketFactory::createBasket(this->getAllocator()));
+        auto basket = BasketFactory::createBasket(this->getAllocator());
+        basket->setPolicy(this->options.basketPolicy);
+        this->withBasket(*basket);
       }
       return *this->qbasket;
     }
@@ -191,7 +193,9 @@ namespace {
     }
     virtual IVM& getVM() override {
       if (this->qvm == nullptr) {
-        this->withVM(*VMFactory::createDefault(this->getAllocator(), this->getLogger()));
+        auto vm = VMFactory::createDefault(this->getAllocator(), this->getLogger());
+        vm->getBasket().setPolicy(this->options.basketPolicy);
+        this->withVM(*vm);
       }
       return *this->qvm;
     }
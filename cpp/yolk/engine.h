@@ -15,6 +15,7 @@ namespace egg::yolk {
   public:
     struct Options {
       bool includeStandardBuiltins : 1 = true;
+      egg::ovum::IBasket::Policy basketPolicy{}; // Applied to baskets created by the engine
     };
     // Interface
     virtual ~IEngine() = default;
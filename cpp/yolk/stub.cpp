@@ -10,6 +10,7 @@
 #include "ovum/version.h"
 
 #include <cctype>
+#include <charconv>
 #include <iostream>
 
 #define STUB_LOG(severity) \
@@ -106,6 +107,8 @@ namespace {
       bool profileAllocator = false;
       bool profileMemory = false;
       bool profileTime = false;
+      bool pooled = false;
+      IBasket::Policy basketPolicy{};
       // Helpers
       static Severity makeLogLevelMask(Severity severity) {
         if (severity == Severity::None) {
@@ -123,6 +126,7 @@ namespace {
     std::vector<size_t> breadcrumbs;
     Configuration configuration;
     AllocatorDefault uallocator;
+    AllocatorPool upool;
   public:
     Stub() {
     }
@@ -197,6 +201,10 @@ namespace {
       return *this;
     }
     virtual IStub& withBuiltins() override {
+      this->withBuiltinOption(&Stub::optAllocator, "allocator=default|pool");
+      this->withBuiltinOption(&Stub::optCollectBlocks, "collect-blocks=<count>");
+      this->withBuiltinOption(&Stub::optCollectBudget, "collect-budget=<microseconds>");
+      this->withBuiltinOption(&Stub::optCollectBytes, "collect-bytes=<count>");
       this->withBuiltinOption(&Stub::optLogLevel, "log-level=debug|verbose|information|warning|error|none");
       this->withBuiltinOption(&Stub::optProfile, "profile[=allocator|memory|time|all]");
       this->withBuiltinCommand(&Stub::cmdHelp, "help");
@@ -385,6 +393,52 @@ namespace {
       }
       return true;
     }
+    bool optAllocator(const std::string& option, const std::string* value) {
+      if (this->options[option].occurrences > 1) {
+        this->badUsage("Duplicated general option: '--" + option + "'");
+        return false;
+      }
+      if (value == nullptr) {
+        this->badGeneralOption(option, value);
+        return false;
+      }
+      if (*value == "default") {
+        this->configuration.pooled = false;
+      } else if (*value == "pool") {
+        this->configuration.pooled = true;
+      } else {
+        this->badGeneralOption(option, value);
+        return false;
+      }
+      return true;
+    }
+    bool optCollectBlocks(const std::string& option, const std::string* value) {
+      return this->parseGeneralOptionCount(option, value, this->configuration.basketPolicy.blocksOwned);
+    }
+    bool optCollectBudget(const std::string& option, const std::string* value) {
+      return this->parseGeneralOptionCount(option, value, this->configuration.basketPolicy.pauseBudget);
+    }
+    bool optCollectBytes(const std::string& option, const std::string* value) {
+      return this->parseGeneralOptionCount(option, value, this->configuration.basketPolicy.bytesAllocated);
+    }
+    bool parseGeneralOptionCount(const std::string& option, const std::string* value, uint64_t& count) {
+      if (this->options[option].occurrences > 1) {
+        this->badUsage("Duplicated general option: '--" + option + "'");
+        return false;
+      }
+      if ((value == nullptr) || value->empty()) {
+        this->badGeneralOption(option, value);
+        return false;
+      }
+      auto* begin = value->data();
+      auto* end = begin + value->size();
+      auto parsed = std::from_chars(begin, end, count);
+      if ((parsed.ec != std::errc{}) || (parsed.ptr != end)) {
+        this->badGeneralOption(option, value);
+        return false;
+      }
+      return true;
+    }
     bool optProfile(const std::string& option, const std::string* value) {
       if ((value == nullptr) || (*value == "all")) {
         this->configuration.profileAllocator = true;
@@ -548,6 +602,7 @@ namespace {
     };
     std::shared_ptr<IEngine> makeEngine() {
       IEngine::Options eo{};
+      eo.basketPolicy = this->configuration.basketPolicy;
       auto engine = EngineFactory::createWithOptions(eo);
       assert(engine != nullptr);
       if (this->configuration.allocator != nullptr) {
@@ -638,7 +693,11 @@ namespace {
     Profile<ProfileMemory> profileMemory{ this->configuration.profileMemory ? this : nullptr };
     Profile<ProfileTime> profileTime{ this->configuration.profileTime ? this : nullptr };
     if (this->configuration.allocator == nullptr) {
-      this->withAllocator(this->uallocator);
+      if (this->configuration.pooled) {
+        this->withAllocator(this->upool);
+      } else {
+        this->withAllocator(this->uallocator);
+      }
       return handler(*this);
     }
     return handler(*this);
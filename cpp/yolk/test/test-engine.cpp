@@ -48,3 +48,16 @@ TEST(TestEngine, RunPrint) {
   ASSERT_VALUE(egg::ovum::HardValue::Void, script->run());
   ASSERT_EQ("Hello, world!\n", logger.logged.str());
 }
+
+TEST(TestEngine, RunPooled) {
+  egg::ovum::AllocatorPool allocator;
+  egg::test::Logger logger;
+  auto engine = egg::yolk::EngineFactory::createDefault();
+  engine->withAllocator(allocator).withLogger(logger);
+  auto script = engine->loadScriptFromString(engine->createString("var a = [1, 2, 3]; a.push(\"four\"); print(a);"));
+  ASSERT_VALUE(egg::ovum::HardValue::Void, script->run());
+  ASSERT_EQ("[1,2,3,\"four\"]\n", logger.logged.str());
+  egg::ovum::IAllocator::Statistics stats;
+  ASSERT_TRUE(allocator.statistics(stats));
+  ASSERT_GT(stats.totalBlocksAllocated, 0u);
+}
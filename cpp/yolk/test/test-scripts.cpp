@@ -8,17 +8,30 @@ namespace {
 
   class TestScript {
   public:
-    static void run(const std::string& resource) {
+    static void run(const std::string& resource, VMEngine engine = VMEngine::TreeWalker, IAllocator* allocator = nullptr) {
       // Actually perform the testing
       FileTextStream stream(egg::test::resolvePath(resource));
-      auto actual = TestScript::execute(stream);
+      auto actual = TestScript::execute(stream, engine, allocator);
       ASSERT_TRUE(stream.rewind());
       auto expected = TestScript::expectation(stream);
       ASSERT_EQ(expected, actual);
     }
+    template<typename ALLOCATOR>
+    static uint64_t benchmark(const std::vector<std::string>& resources, size_t repetitions) {
+      // Returns the elapsed microseconds to run all the scripts the given number of times
+      auto started = std::chrono::steady_clock::now();
+      for (size_t repetition = 0; repetition < repetitions; ++repetition) {
+        for (const auto& resource : resources) {
+          ALLOCATOR allocator;
+          FileTextStream stream(egg::test::resolvePath(resource));
+          (void)TestScript::execute(stream, VMEngine::TreeWalker, &allocator);
+        }
+      }
+      return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count());
+    }
   private:
-    static std::string execute(TextStream& stream) {
-      egg::test::VM vm;
+    static std::string execute(TextStream& stream, VMEngine engine, IAllocator* allocator) {
+      egg::test::VM vm{ engine, allocator };
       vm.logger.resource = stream.getResourceName();
       auto program = EggCompilerFactory::compileFromStream(*vm, stream);
       if (program != nullptr) {
@@ -54,13 +67,21 @@ namespace {
   private:
     inline static const std::filesystem::path directory = "cpp/yolk/test/scripts";
     inline static const size_t lbound = 1;
-    inline static const size_t ubound = 82; // Set to zero to perform directory search
+    inline static const size_t ubound = 89; // Set to zero to perform directory search
   public:
-    void run() {
+    void run(VMEngine engine) {
       // Actually perform the testing
       std::string script = this->GetParam();
       auto resource = TestScripts::directory.generic_string() + '/' + script;
-      TestScript::run(resource);
+      TestScript::run(resource, engine);
+    }
+    static std::vector<std::string> resources() {
+      // Resource paths of all the scripts
+      auto results = (TestScripts::lbound <= TestScripts::ubound) ? TestScripts::list() : TestScripts::find();
+      for (auto& result : results) {
+        result = TestScripts::directory.generic_string() + '/' + result;
+      }
+      return results;
     }
     static ::testing::internal::ParamGenerator<std::string> generator() {
       // Generate value parameterizations for all the scripts
@@ -148,8 +169,38 @@ TEST(TestScript, Coverage) {
   TestScript::run("cpp/data/coverage.egg");
 }
 
+TEST(TestScript, WorkingBytecode) {
+  TestScript::run("cpp/data/working.egg", VMEngine::Bytecode);
+}
+
+TEST(TestScript, CoverageBytecode) {
+  TestScript::run("cpp/data/coverage.egg", VMEngine::Bytecode);
+}
+
+TEST(TestScript, WorkingPooled) {
+  AllocatorPool allocator;
+  TestScript::run("cpp/data/working.egg", VMEngine::TreeWalker, &allocator);
+}
+
+TEST(TestScript, CoveragePooled) {
+  AllocatorPool allocator;
+  TestScript::run("cpp/data/coverage.egg", VMEngine::TreeWalker, &allocator);
+}
+
+TEST(TestScript, DISABLED_BenchmarkReferenceCounting) {
+  // Compare the output of builds with and without 'THREADING=single'
+  auto resources = TestScripts::resources();
+  const size_t repetitions = 10;
+  auto elapsed = TestScript::benchmark<AllocatorDefault>(resources, repetitions);
+  std::cout << "EGG_SINGLE_THREADED=" << EGG_SINGLE_THREADED << ": " << elapsed << "us" << std::endl;
+}
+
 TEST_P(TestScripts, Run) {
-  this->run();
+  this->run(VMEngine::TreeWalker);
+}
+
+TEST_P(TestScripts, RunBytecode) {
+  this->run(VMEngine::Bytecode);
 }
 
 EGG_INSTANTIATE_TEST_CASE_P(TestScripts)
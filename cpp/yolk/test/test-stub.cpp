@@ -164,6 +164,34 @@ TEST(TestStub, LogLevelNone) {
   ASSERT_EQ("", logged);
 }
 
+TEST(TestStub, AllocatorUnknown) {
+  Stub stub{ "/path/to/executable.exe", "--allocator=unknown" };
+  auto logged = stub.expect(egg::yolk::IStub::ExitCode::Usage);
+  auto expected = "<COMMAND><ERROR>executable: Invalid general option: '--allocator=unknown'\n"
+                  "<COMMAND><INFORMATION>Option usage: '--allocator=default|pool'\n";
+  ASSERT_EQ(expected, logged);
+}
+
+TEST(TestStub, CollectBytesInvalid) {
+  Stub stub{ "/path/to/executable.exe", "--collect-bytes=lots" };
+  auto logged = stub.expect(egg::yolk::IStub::ExitCode::Usage);
+  auto expected = "<COMMAND><ERROR>executable: Invalid general option: '--collect-bytes=lots'\n"
+                  "<COMMAND><INFORMATION>Option usage: '--collect-bytes=<count>'\n";
+  ASSERT_EQ(expected, logged);
+}
+
+TEST(TestStub, CollectBlocks) {
+  Stub stub{ "/path/to/executable.exe", "--collect-blocks=1000" };
+  auto logged = stub.expect(egg::yolk::IStub::ExitCode::OK);
+  ASSERT_EQ(stub.WELCOME, logged);
+}
+
+TEST(TestStub, CollectBudget) {
+  Stub stub{ "/path/to/executable.exe", "--collect-budget=500" };
+  auto logged = stub.expect(egg::yolk::IStub::ExitCode::OK);
+  ASSERT_EQ(stub.WELCOME, logged);
+}
+
 TEST(TestStub, ProfileAll) {
   Stub stub{ "/path/to/executable.exe", "--profile" };
   auto logged = stub.expect(egg::yolk::IStub::ExitCode::OK);